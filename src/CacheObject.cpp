@@ -18,6 +18,7 @@
  */
 
 #include "CacheObject.h"
+#include "XmlElementIndex.h"
 
 #include <cstring>
 #include <cstdlib>
@@ -34,8 +35,180 @@ using namespace std;
 const char CacheObject::dictionary[] =
         "\"http://wwwSMILorg/TR/REC-smil/SMIL10<smil>smil</head><body>\"-//W3C//DTDcontent=\"Daisy<?xml version=\"1.0\" encoding=\"iso-8859-1\"?>npt=0<region id=\"txtView\"/>endsync=\"last\"<meta name=\"dc:identifier\" content=mpg\"<meta name=\"ncc:totalElapsedTime\" content=<seq><meta name=\"ncc:generator\" content=</seq><meta name=\"dc:format\" content=<meta<meta name=\"dc:title\" content=booktext<meta name=\"ncc:timeInThisSmil\" content=<ref<layout>endsync=\"last\"></layout></par><!DOCTYPE smil PUBLIC \"-//W3C//DTD SMIL 1.0//EN\" \"http://www.w3.org/TR/REC-smil/SMIL10.dtd\"><par<body><text</body><audio<smil>clip-end=\"</head>clip-begin=\"</smil>smil\"<head>/><seq>mp3\"</seq>src=\"<par endsync=\"last\">id=\"</par>";
 
+/**
+ * Give an inflate stream the preset dictionary the entries are deflated with
+ */
+int CacheObject::setDictionary(z_stream *strm)
+{
+    return inflateSetDictionary(strm, (const Bytef*) dictionary,
+            sizeof(dictionary));
+}
+
+// Number of idle codecs kept for reuse
+#define CODEC_POOL_SIZE 4
+
+std::vector<CacheObject::Codec *> CacheObject::codecPool;
+pthread_mutex_t CacheObject::codecPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Frees the idle codecs at exit, defined after the pool so it runs first
+static struct CodecPoolCleanup
+{
+    ~CodecPoolCleanup()
+    {
+        CacheObject::freeCodecPool();
+    }
+} codecPoolCleanup;
+
+/**
+ * Allocate zlib state and account it to the Codec in opaque
+ */
+voidpf CacheObject::codecAlloc(voidpf opaque, uInt items, uInt size)
+{
+    size_t bytes = (size_t) items * size;
+    size_t *block = (size_t *) malloc(sizeof(size_t) + bytes);
+    if (block == NULL)
+        return Z_NULL;
+
+    *block = bytes;
+    ((Codec *) opaque)->stateSize += bytes;
+    return (voidpf) (block + 1);
+}
+
+void CacheObject::codecFree(voidpf opaque, voidpf address)
+{
+    if (address == Z_NULL)
+        return;
+
+    size_t *block = (size_t *) address - 1;
+    ((Codec *) opaque)->stateSize -= *block;
+    free(block);
+}
+
+/**
+ * Take a codec from the pool, or allocate one, ready for mode
+ *
+ * Pooled codecs keep their zlib state, so starting a new write is a
+ * deflateReset rather than a fresh 256 KB allocation.
+ *
+ * @param mode CODEC_DEFLATE or CODEC_INFLATE
+ * @return pointer to the codec
+ * @retval NULL if zlib could not be initialized
+ */
+CacheObject::Codec *CacheObject::acquireCodec(CodecMode mode)
+{
+    Codec *c = NULL;
+
+    pthread_mutex_lock(&codecPoolMutex);
+    // Prefer a codec that is already set up for this mode
+    for (size_t i = 0; i < codecPool.size(); i++)
+    {
+        if (codecPool[i]->mode == mode || i + 1 == codecPool.size())
+        {
+            c = codecPool[i];
+            codecPool.erase(codecPool.begin() + i);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&codecPoolMutex);
+
+    if (c == NULL)
+    {
+        c = (Codec *) malloc(sizeof(Codec));
+        if (c == NULL)
+            return NULL;
+        memset(&c->stream, 0, sizeof(z_stream));
+        c->stream.zalloc = codecAlloc;
+        c->stream.zfree = codecFree;
+        c->stream.opaque = (voidpf) c;
+        c->mode = CODEC_NONE;
+        c->stateSize = 0;
+    }
+
+    int err = Z_OK;
+    if (c->mode == mode)
+    {
+        err = (mode == CODEC_DEFLATE) ? deflateReset(&c->stream)
+                : inflateReset(&c->stream);
+    }
+    else
+    {
+        endCodec(c);
+        err = (mode == CODEC_DEFLATE) ? deflateInit(&c->stream, Z_BEST_SPEED)
+                : inflateInit(&c->stream);
+        if (err == Z_OK)
+            c->mode = mode;
+    }
+
+    if (err == Z_OK && mode == CODEC_DEFLATE)
+        err = deflateSetDictionary(&c->stream, (const Bytef*) dictionary,
+                sizeof(dictionary));
+
+    if (err != Z_OK)
+    {
+        endCodec(c);
+        free(c);
+        return NULL;
+    }
+
+    return c;
+}
+
+/**
+ * Return a codec to the pool, or free it when the pool is full
+ */
+void CacheObject::releaseCodec(Codec *c)
+{
+    pthread_mutex_lock(&codecPoolMutex);
+    if (codecPool.size() < CODEC_POOL_SIZE)
+    {
+        codecPool.push_back(c);
+        c = NULL;
+    }
+    pthread_mutex_unlock(&codecPoolMutex);
+
+    if (c != NULL)
+    {
+        endCodec(c);
+        free(c);
+    }
+}
+
+/**
+ * Free all idle codecs
+ */
+void CacheObject::freeCodecPool()
+{
+    pthread_mutex_lock(&codecPoolMutex);
+    while (!codecPool.empty())
+    {
+        endCodec(codecPool.back());
+        free(codecPool.back());
+        codecPool.pop_back();
+    }
+    pthread_mutex_unlock(&codecPoolMutex);
+}
+
+/**
+ * Free the zlib state of a codec
+ */
+void CacheObject::endCodec(Codec *c)
+{
+    switch (c->mode)
+    {
+    case CODEC_DEFLATE:
+        deflateEnd(&c->stream);
+        break;
+    case CODEC_INFLATE:
+        inflateEnd(&c->stream);
+        break;
+    default:
+        break;
+    }
+    c->mode = CODEC_NONE;
+}
+
 CacheObject::CacheObject(const char *url) :
-        pSrcUrl(0), iHttpCode(0), eState(EMPTY), bTidyFlag(false), c_stream(), zBuffer(0), zBufferAllocCount(0), zBufferSize(0), zBufferPos(0)
+        iRefCount(1), pSrcUrl(0), iHttpCode(0), tExpires(0), bMustRevalidate(false), lLastAccess(0), eState(EMPTY), bTidyFlag(false), pElementIndex(0), bHasFileState(false), mFileSize(0), mFileMtime(0), mFileInode(0), codec(0), readerCodecSize(0), zBuffer(0), zBufferAllocCount(0), zBufferSize(0), zBufferPos(0)
 {
     pSrcUrl = strdup(url);
     pEtag = NULL;
@@ -69,6 +242,18 @@ CacheObject::~CacheObject()
         free(pEtag);
         pEtag = NULL;
     }
+    delete pElementIndex;
+}
+
+void CacheObject::ref()
+{
+    __sync_add_and_fetch(&iRefCount, 1);
+}
+
+void CacheObject::unref()
+{
+    if (__sync_sub_and_fetch(&iRefCount, 1) == 0)
+        delete this;
 }
 
 void CacheObject::resetState()
@@ -77,25 +262,19 @@ void CacheObject::resetState()
     switch (eState)
     {
     case WRITE:
-        if(deflateEnd(&c_stream) != Z_OK)
-            LOG4CXX_ERROR(xmlCacheObjLog, "deflateEnd failed" << pSrcUrl);
-        eState = FULL;
-        break;
     case READ:
-        if(inflateEnd(&c_stream) != Z_OK)
-            LOG4CXX_ERROR(xmlCacheObjLog, "inflateEnd failed" << pSrcUrl);
         eState = FULL;
         break;
     default:
         break;
     }
 
-    // Initialize the z_stream
-    // Zero c_stream just in case
-    memset(&c_stream, 0, sizeof(z_stream));
-    c_stream.zalloc = Z_NULL;
-    c_stream.zfree = Z_NULL;
-    c_stream.opaque = Z_NULL;
+    // Hand the codec back, a resting entry only keeps zBuffer
+    if (codec != NULL)
+    {
+        releaseCodec(codec);
+        codec = NULL;
+    }
 }
 
 const std::string &CacheObject::getErrorMsg()
@@ -196,11 +375,164 @@ int CacheObject::getHttpCode() const
     return iHttpCode;
 }
 
+/**
+ * Update freshness from a Cache-Control header value
+ *
+ * max-age makes the entry fresh for that many seconds from now, no-cache and
+ * must-revalidate forbid serving the entry without asking the server first.
+ *
+ * @param cache_control the header value, e.g. "public, max-age=3600"
+ */
+void CacheObject::setCacheControl(const char* cache_control)
+{
+    const char *p = cache_control;
+    while (p != NULL && *p != '\0')
+    {
+        while (*p == ' ' || *p == ',')
+            p++;
+
+        if (strncasecmp(p, "max-age=", 8) == 0)
+        {
+            tExpires = time(NULL) + atol(p + 8);
+        }
+        else if (strncasecmp(p, "no-cache", 8) == 0
+                || strncasecmp(p, "must-revalidate", 15) == 0)
+        {
+            bMustRevalidate = true;
+            tExpires = 0;
+        }
+
+        p = strchr(p, ',');
+    }
+}
+
+void CacheObject::setExpires(const time_t expires)
+{
+    tExpires = expires;
+}
+
+/**
+ * Forget the freshness information of a previous response
+ */
+void CacheObject::resetFreshness()
+{
+    tExpires = 0;
+    bMustRevalidate = false;
+}
+
+time_t CacheObject::getExpires() const
+{
+    return tExpires;
+}
+
+bool CacheObject::isFresh() const
+{
+    return !bMustRevalidate && tExpires > time(NULL);
+}
+
+bool CacheObject::mustRevalidate() const
+{
+    return bMustRevalidate;
+}
+
 unsigned long CacheObject::getBufferSize() const
 {
     return zBufferSize;
 }
 
+/**
+ * Get the number of bytes the entry occupies
+ *
+ * Counts the object itself, the compressed data, the url and header strings
+ * and the zlib state of any write or read in progress.
+ *
+ * @return memory usage in bytes
+ */
+unsigned long CacheObject::getMemoryUsage() const
+{
+    unsigned long usage = sizeof(CacheObject) + zBufferSize + readerCodecSize;
+
+    if (codec != NULL)
+        usage += sizeof(Codec) + codec->stateSize;
+
+    if (pSrcUrl != NULL)
+        usage += strlen(pSrcUrl) + 1;
+    if (pEtag != NULL)
+        usage += strlen(pEtag) + 1;
+    if (pLast_modified != NULL)
+        usage += strlen(pLast_modified) + 1;
+    if (pLocation != NULL)
+        usage += strlen(pLocation) + 1;
+    usage += mErrorMsg.capacity();
+    if (pElementIndex != NULL)
+        usage += pElementIndex->getMemoryUsage();
+
+    return usage;
+}
+
+/**
+ * Attach the element index of the cached document
+ *
+ * The entry takes ownership of the index and deletes any previous one.
+ *
+ * @param index pointer to the index, NULL to drop it
+ */
+void CacheObject::setElementIndex(XmlElementIndex *index)
+{
+    if (index != pElementIndex)
+        delete pElementIndex;
+    pElementIndex = index;
+}
+
+/**
+ * Get the element index of the cached document
+ *
+ * @retval NULL if no index was built
+ */
+const XmlElementIndex *CacheObject::getElementIndex() const
+{
+    return pElementIndex;
+}
+
+/**
+ * Record the state of the local file the entry was read from
+ */
+void CacheObject::setFileState(off_t size, time_t mtime, ino_t inode)
+{
+    bHasFileState = true;
+    mFileSize = size;
+    mFileMtime = mtime;
+    mFileInode = inode;
+}
+
+/**
+ * Check if the entry holds a local file
+ */
+bool CacheObject::hasFileState() const
+{
+    return bHasFileState;
+}
+
+/**
+ * Check that the local file is the one the entry was read from
+ */
+bool CacheObject::matchesFileState(off_t size, time_t mtime,
+        ino_t inode) const
+{
+    return bHasFileState && mFileSize == size && mFileMtime == mtime
+            && mFileInode == inode;
+}
+
+void CacheObject::setLastAccess(unsigned long tick)
+{
+    lLastAccess = tick;
+}
+
+unsigned long CacheObject::getLastAccess() const
+{
+    return lLastAccess;
+}
+
 void CacheObject::setTidyFlag(bool flag)
 {
     bTidyFlag = flag;
@@ -228,15 +560,19 @@ unsigned int CacheObject::writeBytes(const char *buffer, const size_t bytes)
     {
         LOG4CXX_DEBUG(xmlCacheObjLog,
                 "Initializing zlib deflate for " << pSrcUrl);
-        deflateInit(&c_stream, Z_BEST_SPEED);
-        deflateSetDictionary(&c_stream, (const Bytef*) dictionary,
-                sizeof(dictionary));
+        codec = acquireCodec(CODEC_DEFLATE);
+        if (codec == NULL)
+        {
+            LOG4CXX_ERROR(xmlCacheObjLog,
+                    "Failed to initialize zlib deflate for " << pSrcUrl);
+            return 0;
+        }
 
         eState = WRITE;
     }
 
-    c_stream.next_in = (Bytef *) buffer;
-    c_stream.avail_in = bytes;
+    codec->stream.next_in = (Bytef *) buffer;
+    codec->stream.avail_in = bytes;
 
     int doFlush = (buffer == NULL && bytes == 0) ? Z_FINISH : Z_NO_FLUSH;
 
@@ -244,18 +580,18 @@ unsigned int CacheObject::writeBytes(const char *buffer, const size_t bytes)
 
     do
     {
-        c_stream.next_out = (Bytef *) c_stream_buffer;
-        c_stream.avail_out = Z_CHUNK_SIZE;
+        codec->stream.next_out = (Bytef *) codec->buffer;
+        codec->stream.avail_out = Z_CHUNK_SIZE;
         LOG4CXX_TRACE(xmlCacheObjLog,
-                "Deflate status before:" << " avail_in: " << c_stream.avail_in << " bytes," << " total_in: " << c_stream.total_in << " bytes," << " avail_out: " << c_stream.avail_out << " bytes," << " total_out: " << c_stream.total_out << " bytes");
+                "Deflate status before:" << " avail_in: " << codec->stream.avail_in << " bytes," << " total_in: " << codec->stream.total_in << " bytes," << " avail_out: " << codec->stream.avail_out << " bytes," << " total_out: " << codec->stream.total_out << " bytes");
 
-        err = deflate(&c_stream, doFlush);
+        err = deflate(&codec->stream, doFlush);
         LOG4CXX_TRACE(xmlCacheObjLog,
-                "Deflate status after: " << " avail_in: " << c_stream.avail_in << " bytes," << " total_in: " << c_stream.total_in << " bytes," << " avail_out: " << c_stream.avail_out << " bytes," << " total_out: " << c_stream.total_out << " bytes");
+                "Deflate status after: " << " avail_in: " << codec->stream.avail_in << " bytes," << " total_in: " << codec->stream.total_in << " bytes," << " avail_out: " << codec->stream.avail_out << " bytes," << " total_out: " << codec->stream.total_out << " bytes");
 
-        if (c_stream.msg)
+        if (codec->stream.msg)
             LOG4CXX_DEBUG(xmlCacheObjLog,
-                    "Message from encoder: " << c_stream.msg);
+                    "Message from encoder: " << codec->stream.msg);
 
         if (err != Z_OK && err != Z_STREAM_END)
         {
@@ -294,8 +630,8 @@ unsigned int CacheObject::writeBytes(const char *buffer, const size_t bytes)
         }
         else
         {
-            unsigned compressed = Z_CHUNK_SIZE - c_stream.avail_out;
-            while (zBufferSize < c_stream.total_out)
+            unsigned compressed = Z_CHUNK_SIZE - codec->stream.avail_out;
+            while (zBufferSize < codec->stream.total_out)
             {
                 zBufferAllocCount++;
                 zBufferSize = zBufferAllocCount * Z_CHUNK_SIZE;
@@ -315,19 +651,19 @@ unsigned int CacheObject::writeBytes(const char *buffer, const size_t bytes)
             {
                 LOG4CXX_TRACE(xmlCacheObjLog,
                         "Copying " << compressed << " bytes to zBuffer of size " << zBufferSize << " at pos " << zBufferPos << " for " << pSrcUrl);
-                memcpy(zBuffer + zBufferPos, c_stream_buffer, compressed);
+                memcpy(zBuffer + zBufferPos, codec->buffer, compressed);
                 zBufferPos += compressed;
 
             }
-            else if (zBufferSize < c_stream.total_out)
+            else if (zBufferSize < codec->stream.total_out)
             {
                 LOG4CXX_ERROR(xmlCacheObjLog,
-                        "Not enough memory in zBuffer have: " << zBufferSize << " need: " << c_stream.total_out);
+                        "Not enough memory in zBuffer have: " << zBufferSize << " need: " << codec->stream.total_out);
                 return 0;
             }
         }
-    } while (c_stream.avail_in != 0
-            || (err == Z_OK && c_stream.avail_out == 0));
+    } while (codec->stream.avail_in != 0
+            || (err == Z_OK && codec->stream.avail_out == 0));
     //If deflate returns Z_OK and with zero avail_out, it must be called again after making room in the output buffer because there might be more output pending.
 
     if (doFlush == Z_FINISH)
@@ -337,98 +673,11 @@ unsigned int CacheObject::writeBytes(const char *buffer, const size_t bytes)
         zBuffer = (char *) realloc(zBuffer, zBufferSize * sizeof(char));
         LOG4CXX_TRACE(xmlCacheObjLog,
                 "Final size of zBuffer: " << zBufferSize << " for " << pSrcUrl);
-        eState = FULL;
-    }
-
-    return bytes;
-}
-
-int CacheObject::readBytes(const char *buffer, const size_t bytes)
-{
 
-    LOG4CXX_TRACE(xmlCacheObjLog,
-            "readBytes(const char * " << &buffer << ", const size_t " << bytes << ")");
-
-    // If the cache is empty return 0
-    if (eState == EMPTY || zBuffer == NULL)
-        return 0;
-
-    if (eState == WRITE)
+        // Release the deflate state, a finished entry only keeps zBuffer
         resetState();
-
-    if (eState == FULL)
-    {
-        LOG4CXX_TRACE(xmlCacheObjLog,
-                "Initializing zlib inflate for " << pSrcUrl);
-        inflateInit(&c_stream);
-        inflateSetDictionary(&c_stream, (const Bytef*) dictionary,
-                sizeof(dictionary));
-        eState = READ;
-
-        c_stream.next_in = (Bytef *) zBuffer;
-        c_stream.avail_in = zBufferSize;
     }
 
-    int err = Z_OK;
-    int doFlush = Z_NO_FLUSH;
-
-    do
-    {
-        memset((void*) buffer, 0, bytes);
-        c_stream.next_out = (Bytef*) buffer;
-        c_stream.avail_out = bytes;
-
-        LOG4CXX_TRACE(xmlCacheObjLog,
-                "Inflate status before:" << " avail_in: " << c_stream.avail_in << " bytes," << " avail_out: " << c_stream.avail_out << " bytes");
-
-        err = inflate(&c_stream, doFlush);
-        LOG4CXX_TRACE(xmlCacheObjLog,
-                "Inflate status after: " << " avail_in: " << &c_stream.avail_in << " bytes," << " avail_out: " << c_stream.avail_out << " bytes");
-
-        if (c_stream.msg)
-            LOG4CXX_DEBUG(xmlCacheObjLog,
-                    "Message from decoder: " << c_stream.msg);
-
-        switch (err)
-        {
-        case Z_NEED_DICT:
-            LOG4CXX_TRACE(xmlCacheObjLog, "decompress error Z_NEED_DICT");
-            inflateSetDictionary(&c_stream, (const Bytef*) dictionary,
-                    sizeof(dictionary));
-            break;
-
-        case Z_ERRNO:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_ERRNO");
-            return 0;
-        case Z_STREAM_ERROR:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_STREAM_ERROR");
-            return 0;
-        case Z_DATA_ERROR:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_DATA_ERROR");
-            return 0;
-        case Z_MEM_ERROR:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_MEM_ERROR");
-            return 0;
-        case Z_BUF_ERROR:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_BUF_ERROR");
-            break;
-        case Z_VERSION_ERROR:
-            LOG4CXX_ERROR(xmlCacheObjLog, "decompress error Z_VERSION_ERROR");
-            return 0;
-
-        case Z_STREAM_END:
-            LOG4CXX_TRACE(xmlCacheObjLog,
-                    "decompress Z_STREAM_END for " << pSrcUrl);
-            break;
-
-        case Z_OK:
-            break;
-        }
-    } while (c_stream.avail_out != 0 && c_stream.avail_in != 0);
-
-    LOG4CXX_TRACE(xmlCacheObjLog,
-            "Read " << bytes - c_stream.avail_out << " bytes from zBuffer for " << pSrcUrl);
-
-    return (bytes - c_stream.avail_out);
+    return bytes;
 }
 
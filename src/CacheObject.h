@@ -21,17 +21,30 @@
 #define CACHEOBJECT_H
 
 #include <zlib.h>
+#include <sys/types.h>
+#include <ctime>
 #include <string>
+#include <vector>
+#include <pthread.h>
 
 #define Z_CHUNK_SIZE 16384
 
+class XmlElementIndex;
+
 class CacheObject
 {
 public:
-    // Initializes a cache object
+    // Initializes a cache object, the creator holds the first reference
     CacheObject(const char* url = "");
     ~CacheObject();
 
+    // Reference counting, the object is deleted when the last one is dropped
+    void ref();
+    void unref();
+
+    // Free the idle codecs shared by all entries
+    static void freeCodecPool();
+
     // Return object
     CacheObject *getObject();
 
@@ -46,6 +59,9 @@ public:
     void setLocation(const char* location);
     void setContentLength(const unsigned long content_length);
     void setHttpCode(const int code);
+    void setCacheControl(const char* cache_control);
+    void setExpires(const time_t expires);
+    void resetFreshness();
 
     char *getEtag() const;
     char *getLastModified() const;
@@ -53,6 +69,28 @@ public:
     unsigned long getContentLength() const;
     unsigned long getBufferSize() const;
     int getHttpCode() const;
+    time_t getExpires() const;
+
+    // Bytes used by the entry, metadata and codec state included
+    unsigned long getMemoryUsage() const;
+
+    // Freshness according to the Cache-Control of the last response
+    bool isFresh() const;
+    bool mustRevalidate() const;
+
+    // Offsets of the elements with an id, owned by the entry
+    void setElementIndex(XmlElementIndex *index);
+    const XmlElementIndex *getElementIndex() const;
+
+    // Size, modification time and inode of the local file the entry holds
+    void setFileState(off_t size, time_t mtime, ino_t inode);
+    bool hasFileState() const;
+    bool matchesFileState(off_t size, time_t mtime, ino_t inode) const;
+
+    // Position in the order of cache accesses, for evicting the least
+    // recently used entries
+    void setLastAccess(unsigned long tick);
+    unsigned long getLastAccess() const;
 
     // Set the tidied/untiedied flags
     void setTidyFlag(bool flag);
@@ -61,9 +99,6 @@ public:
     // Append data to the zBuffer
     unsigned int writeBytes(const char *buffer, const size_t bytes);
 
-    // Read data from the zBuffer
-    int readBytes(const char *buffer, const size_t bytes);
-
     // Resets the current state without destroying buffers
     void resetState();
     CacheState getState();
@@ -73,6 +108,9 @@ public:
     const std::string &getErrorMsg();
 
 private:
+    friend class CacheReader;
+
+    int iRefCount;
 
     char *pSrcUrl;
     char *pEtag;
@@ -80,16 +118,51 @@ private:
     char *pLocation;
     unsigned long lContent_length;
     int iHttpCode;
+    time_t tExpires;
+    bool bMustRevalidate;
+    unsigned long lLastAccess;
 
     CacheState eState;
 
     // Flags
     bool bTidyFlag;
 
+    XmlElementIndex *pElementIndex;
+
+    bool bHasFileState;
+    off_t mFileSize;
+    time_t mFileMtime;
+    ino_t mFileInode;
+
     // zLib stuff
-    z_stream c_stream;
-    char c_stream_buffer[Z_CHUNK_SIZE]; // Temp output buffer
+    enum CodecMode
+    {
+        CODEC_NONE, CODEC_DEFLATE, CODEC_INFLATE
+    };
+
+    // zlib stream and staging buffer, only held while writing or reading
+    struct Codec
+    {
+        z_stream stream;
+        CodecMode mode;
+        unsigned long stateSize; // bytes allocated by zlib
+        char buffer[Z_CHUNK_SIZE]; // Temp output buffer
+    };
+
+    Codec *codec;
+    static std::vector<Codec *> codecPool; // idle codecs shared by all entries
+    static pthread_mutex_t codecPoolMutex;
+    static Codec *acquireCodec(CodecMode mode);
+    static void releaseCodec(Codec *c);
+    static void endCodec(Codec *c);
+    static voidpf codecAlloc(voidpf opaque, uInt items, uInt size);
+    static void codecFree(voidpf opaque, voidpf address);
+
     static const char dictionary[];
+    static int setDictionary(z_stream *strm);
+
+    // Bytes of the codecs that CacheReaders of the entry hold
+    unsigned long readerCodecSize;
 
     // zBuffer
     char *zBuffer;
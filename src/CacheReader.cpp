@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CacheReader.h"
+
+#include <cstring>
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlCacheReaderLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.cachereader"));
+
+CacheReader::CacheReader(CacheObject *co) :
+        cacheObject(co), codec(NULL), codecSize(0), bFinished(false)
+{
+    cacheObject->ref();
+}
+
+CacheReader::~CacheReader()
+{
+    if (codec != NULL)
+    {
+        CacheObject::releaseCodec(codec);
+        codec = NULL;
+        accountCodec();
+    }
+    cacheObject->unref();
+}
+
+CacheObject *CacheReader::getObject() const
+{
+    return cacheObject;
+}
+
+/**
+ * Account the state of the codec held by this reader to the entry
+ */
+void CacheReader::accountCodec()
+{
+    unsigned long size = 0;
+    if (codec != NULL)
+        size = sizeof(CacheObject::Codec) + codec->stateSize;
+
+    if (size > codecSize)
+        __sync_add_and_fetch(&cacheObject->readerCodecSize, size - codecSize);
+    else if (size < codecSize)
+        __sync_sub_and_fetch(&cacheObject->readerCodecSize, codecSize - size);
+    codecSize = size;
+}
+
+int CacheReader::readBytes(char *buffer, const size_t bytes)
+{
+    // Only complete entries can be shared, they are never modified again
+    if (bFinished || cacheObject->eState == CacheObject::EMPTY
+            || cacheObject->eState == CacheObject::WRITE
+            || cacheObject->zBuffer == NULL)
+        return 0;
+
+    if (codec == NULL)
+    {
+        codec = CacheObject::acquireCodec(CacheObject::CODEC_INFLATE);
+        if (codec == NULL)
+        {
+            LOG4CXX_ERROR(xmlCacheReaderLog, "Failed to initialize zlib inflate");
+            bFinished = true;
+            return 0;
+        }
+
+        codec->stream.next_in = (Bytef *) cacheObject->zBuffer;
+        codec->stream.avail_in = cacheObject->zBufferSize;
+    }
+
+    z_stream *stream = &codec->stream;
+    stream->next_out = (Bytef *) buffer;
+    stream->avail_out = bytes;
+
+    int err = Z_OK;
+    do
+    {
+        err = inflate(stream, Z_NO_FLUSH);
+        if (err == Z_NEED_DICT)
+        {
+            CacheObject::setDictionary(stream);
+            continue;
+        }
+        if (err == Z_STREAM_END)
+        {
+            bFinished = true;
+            break;
+        }
+        if (err != Z_OK)
+        {
+            LOG4CXX_ERROR(xmlCacheReaderLog,
+                    "decompress error " << err << " in cacheObject");
+            bFinished = true;
+            break;
+        }
+    } while (stream->avail_out != 0 && stream->avail_in != 0);
+
+    int bytesRead = bytes - stream->avail_out;
+
+    // Hand the codec back as soon as the entry has been read
+    if (bFinished)
+    {
+        CacheObject::releaseCodec(codec);
+        codec = NULL;
+    }
+    accountCodec();
+
+    return bytesRead;
+}
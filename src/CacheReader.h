@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CACHEREADER_H
+#define CACHEREADER_H
+
+#include <string>
+
+#include "CacheObject.h"
+
+//
+// A read cursor over a FULL CacheObject. Every reader takes its own inflate
+// codec from the pool of CacheObject and holds a reference to the entry, so
+// any number of readers can share one cached buffer.
+//
+
+class CacheReader
+{
+public:
+    CacheReader(CacheObject *co);
+    ~CacheReader();
+
+    // Read inflated data from the entry
+    int readBytes(char *buffer, const size_t bytes);
+
+    CacheObject *getObject() const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    CacheReader(const CacheReader&);
+    CacheReader& operator=(const CacheReader&);
+
+    void accountCodec();
+
+    CacheObject *cacheObject;
+
+    CacheObject::Codec *codec; // NULL until the first read
+    unsigned long codecSize; // bytes of codec state accounted to the entry
+    bool bFinished;
+};
+
+#endif
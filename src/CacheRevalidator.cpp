@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <strings.h>
+
+#include "CacheRevalidator.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlCacheRevalidatorLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.cacherevalidator"));
+
+using namespace std;
+
+// Return the value of a header line with the name and trailing \r\n removed
+static string headerValue(const char *buffer, size_t length, size_t nameLength)
+{
+    string value(buffer + nameLength, length - nameLength);
+    size_t end = value.find_last_not_of("\r\n ");
+    if (end == string::npos)
+        return "";
+    return value.substr(0, end + 1);
+}
+
+CacheRevalidator::CacheRevalidator(const string url, const CacheObject *stale,
+        CURLSH *share, const string useragent, unsigned int timeout) :
+        sURL(url), sUseragent(useragent), mTimeout(timeout), fShare(share), cacheObject(
+                0), fTotalBytesRead(0), iHttpCode(0), bNoStore(false), thread(), doneMutex(), bStarted(
+                false), bDone(false)
+{
+    LOG4CXX_DEBUG(xmlCacheRevalidatorLog, "constructor for '" << sURL << "'");
+
+    // Copy the validators now, the stale entry belongs to the reader thread
+    if (stale->getEtag() != NULL)
+        sEtag = stale->getEtag();
+    if (stale->getLastModified() != NULL)
+        sLastModified = stale->getLastModified();
+
+    pthread_mutex_init(&doneMutex, NULL);
+}
+
+CacheRevalidator::~CacheRevalidator()
+{
+    LOG4CXX_DEBUG(xmlCacheRevalidatorLog, "destructor for '" << sURL << "'");
+    join();
+    if (cacheObject != NULL)
+        cacheObject->unref();
+    pthread_mutex_destroy(&doneMutex);
+}
+
+/**
+ * Start the conditional request in a new thread
+ *
+ * @return true if the thread was started
+ */
+bool CacheRevalidator::start()
+{
+    if (pthread_create(&thread, NULL, staticRun, this) != 0)
+    {
+        LOG4CXX_ERROR(xmlCacheRevalidatorLog,
+                "Failed to start revalidation thread for " << sURL);
+        return false;
+    }
+    bStarted = true;
+    return true;
+}
+
+/**
+ * Check if the request has completed
+ */
+bool CacheRevalidator::isDone()
+{
+    pthread_mutex_lock(&doneMutex);
+    bool done = bDone;
+    pthread_mutex_unlock(&doneMutex);
+    return done;
+}
+
+/**
+ * Wait for the request thread to finish
+ */
+void CacheRevalidator::join()
+{
+    if (bStarted)
+    {
+        pthread_join(thread, NULL);
+        bStarted = false;
+    }
+}
+
+const string &CacheRevalidator::getUrl() const
+{
+    return sURL;
+}
+
+int CacheRevalidator::getHttpCode() const
+{
+    return iHttpCode;
+}
+
+const string &CacheRevalidator::getCacheControl() const
+{
+    return sCacheControl;
+}
+
+CacheObject *CacheRevalidator::takeCacheObject()
+{
+    CacheObject *co = NULL;
+    if (iHttpCode == 200 && !bNoStore)
+    {
+        co = cacheObject;
+        cacheObject = NULL;
+    }
+    return co;
+}
+
+void *CacheRevalidator::staticRun(void *revalidator)
+{
+    ((CacheRevalidator*) revalidator)->run();
+    return NULL;
+}
+
+void CacheRevalidator::run()
+{
+    CURL *fEasy = curl_easy_init();
+    struct curl_slist *headers = NULL;
+    string headerstr;
+
+    headers = curl_slist_append(headers, "Connection: keep-alive");
+    if (!sLastModified.empty())
+    {
+        headerstr = "If-Modified-Since: " + sLastModified;
+        headers = curl_slist_append(headers, headerstr.c_str());
+    }
+    if (!sEtag.empty())
+    {
+        headerstr = "If-None-Match: \"" + sEtag + "\"";
+        headers = curl_slist_append(headers, headerstr.c_str());
+    }
+
+    curl_easy_setopt(fEasy, CURLOPT_URL, sURL.c_str());
+    curl_easy_setopt(fEasy, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(fEasy, CURLOPT_SSL_VERIFYPEER, false);
+    curl_easy_setopt(fEasy, CURLOPT_SSL_VERIFYHOST, false);
+    curl_easy_setopt(fEasy, CURLOPT_ENCODING, "compress;q=0.5, gzip;q=1.0");
+    curl_easy_setopt(fEasy, CURLOPT_SHARE, fShare);
+    curl_easy_setopt(fEasy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(fEasy, CURLOPT_USERAGENT, sUseragent.c_str());
+    curl_easy_setopt(fEasy, CURLOPT_CONNECTTIMEOUT, mTimeout);
+    curl_easy_setopt(fEasy, CURLOPT_LOW_SPEED_LIMIT, 1000);
+    curl_easy_setopt(fEasy, CURLOPT_LOW_SPEED_TIME, mTimeout);
+    curl_easy_setopt(fEasy, CURLOPT_WRITEHEADER, this);
+    curl_easy_setopt(fEasy, CURLOPT_HEADERFUNCTION, staticHeaderCallback);
+    curl_easy_setopt(fEasy, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(fEasy, CURLOPT_WRITEFUNCTION, staticWriteCallback);
+
+    CURLcode result = curl_easy_perform(fEasy);
+    if (result == CURLE_OK)
+    {
+        long httpcode = 0;
+        curl_easy_getinfo(fEasy, CURLINFO_RESPONSE_CODE, &httpcode);
+        iHttpCode = httpcode;
+        LOG4CXX_DEBUG(xmlCacheRevalidatorLog,
+                "Revalidated " << sURL << " HTTP Code " << iHttpCode);
+
+        if (iHttpCode == 200 && cacheObject != NULL)
+        {
+            cacheObject->writeBytes(NULL, 0);
+            cacheObject->setContentLength(fTotalBytesRead);
+            cacheObject->setHttpCode(iHttpCode);
+            cacheObject->resetState();
+        }
+    }
+    else
+    {
+        LOG4CXX_WARN(xmlCacheRevalidatorLog,
+                "Revalidating " << sURL << " failed: " << curl_easy_strerror(result));
+    }
+
+    curl_easy_cleanup(fEasy);
+    curl_slist_free_all(headers);
+
+    pthread_mutex_lock(&doneMutex);
+    bDone = true;
+    pthread_mutex_unlock(&doneMutex);
+}
+
+size_t CacheRevalidator::staticHeaderCallback(char *buffer, size_t size,
+        size_t nitems, void *outstream)
+{
+    return ((CacheRevalidator*) outstream)->headerCallback(buffer, size,
+            nitems);
+}
+
+size_t CacheRevalidator::headerCallback(char *buffer, size_t size,
+        size_t nitems)
+{
+    size_t length = size * nitems;
+
+    if (length > 5 && memcmp(buffer, "HTTP", 4) == 0)
+    {
+        const char *codePtr = (const char *) memchr(buffer, ' ', length);
+        if (codePtr != NULL && atoi(codePtr + 1) == 200)
+        {
+            // The entity changed, start filling a replacement entry
+            if (cacheObject != NULL)
+                cacheObject->unref();
+            cacheObject = new CacheObject(sURL.c_str());
+        }
+    }
+    else if (strncasecmp(buffer, "ETag: ", 6) == 0)
+    {
+        string etag = headerValue(buffer, length, 6);
+        if (etag.length() >= 2 && etag[0] == '"')
+            etag = etag.substr(1, etag.length() - 2);
+        if (cacheObject != NULL)
+            cacheObject->setEtag(etag.c_str());
+    }
+    else if (strncasecmp(buffer, "Last-Modified: ", 15) == 0)
+    {
+        if (cacheObject != NULL)
+            cacheObject->setLastModified(
+                    headerValue(buffer, length, 15).c_str());
+    }
+    else if (strncasecmp(buffer, "Cache-Control: ", 15) == 0)
+    {
+        sCacheControl = headerValue(buffer, length, 15);
+        if (sCacheControl.find("no-store") != string::npos)
+            bNoStore = true;
+        if (cacheObject != NULL)
+            cacheObject->setCacheControl(sCacheControl.c_str());
+    }
+
+    return length;
+}
+
+size_t CacheRevalidator::staticWriteCallback(char *buffer, size_t size,
+        size_t nitems, void *outstream)
+{
+    return ((CacheRevalidator*) outstream)->writeCallback(buffer, size, nitems);
+}
+
+size_t CacheRevalidator::writeCallback(char *buffer, size_t size,
+        size_t nitems)
+{
+    if (cacheObject != NULL)
+        cacheObject->writeBytes(buffer, size * nitems);
+    fTotalBytesRead += size * nitems;
+    return size * nitems;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CACHEREVALIDATOR_H
+#define CACHEREVALIDATOR_H
+
+#include <curl/curl.h>
+#include <pthread.h>
+#include <string>
+
+#include "CacheObject.h"
+
+//
+// This class sends a conditional request for a cached URL in a thread of
+// its own, while the stale copy is served from the cache.
+//
+
+class CacheRevalidator
+{
+public:
+    CacheRevalidator(const std::string url, const CacheObject *stale,
+            CURLSH *share, const std::string useragent, unsigned int timeout);
+    ~CacheRevalidator();
+
+    bool start();
+    bool isDone();
+    void join();
+
+    const std::string &getUrl() const;
+    int getHttpCode() const;
+
+    // Returns the refetched entry on a 200 response that may be stored, the
+    // caller takes ownership
+    CacheObject *takeCacheObject();
+
+    // Freshness reported by the server, used to refresh a 304'd entry
+    const std::string &getCacheControl() const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    CacheRevalidator(const CacheRevalidator&);
+    CacheRevalidator& operator=(const CacheRevalidator&);
+
+    static void *staticRun(void *revalidator);
+    void run();
+
+    // Data function
+    static size_t staticWriteCallback(char *buffer, size_t size, size_t nitems,
+            void *outstream);
+    size_t writeCallback(char *buffer, size_t size, size_t nitems);
+
+    // Header functions
+    static size_t staticHeaderCallback(char *buffer, size_t size, size_t nitems,
+            void *outstream);
+    size_t headerCallback(char *buffer, size_t size, size_t nitems);
+
+    std::string sURL;
+    std::string sEtag;
+    std::string sLastModified;
+    std::string sUseragent;
+    std::string sCacheControl;
+    unsigned int mTimeout;
+
+    CURLSH *fShare;
+    CacheObject *cacheObject;
+    unsigned long fTotalBytesRead;
+    int iHttpCode;
+    bool bNoStore; // the response forbids storing it
+
+    pthread_t thread;
+    pthread_mutex_t doneMutex;
+    bool bStarted;
+    bool bDone;
+};
+
+#endif
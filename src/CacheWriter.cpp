@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CacheWriter.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlCacheWriterLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.cachewriter"));
+
+CacheWriter::CacheWriter(CacheObject *co) :
+        cacheObject(co), queueMutex(), queueCond(), thread(), bStarted(false), bClosing(
+                false), bFailed(false)
+{
+    pthread_mutex_init(&queueMutex, NULL);
+    pthread_cond_init(&queueCond, NULL);
+}
+
+CacheWriter::~CacheWriter()
+{
+    finish();
+
+    // Drop chunks that were never written
+    while (!chunks.empty())
+    {
+        chunks.front()->unref();
+        chunks.pop();
+    }
+
+    pthread_cond_destroy(&queueCond);
+    pthread_mutex_destroy(&queueMutex);
+}
+
+/**
+ * Queue a chunk for compression
+ *
+ * The writer takes its own reference to the chunk. The worker thread is
+ * started on the first call.
+ *
+ * @param chunk pointer to the data chunk
+ * @return false if the chunk can not be written
+ */
+bool CacheWriter::write(DataChunk *chunk)
+{
+    if (!bStarted)
+    {
+        if (pthread_create(&thread, NULL, staticRun, this) != 0)
+        {
+            LOG4CXX_ERROR(xmlCacheWriterLog, "Failed to start cache writer");
+            bFailed = true;
+            return false;
+        }
+        bStarted = true;
+    }
+
+    chunk->ref();
+
+    pthread_mutex_lock(&queueMutex);
+    chunks.push(chunk);
+    pthread_cond_signal(&queueCond);
+    pthread_mutex_unlock(&queueMutex);
+
+    return true;
+}
+
+/**
+ * Wait until all queued chunks have been compressed
+ *
+ * @return true if everything was written to the cacheObject
+ */
+bool CacheWriter::finish()
+{
+    if (bStarted)
+    {
+        pthread_mutex_lock(&queueMutex);
+        bClosing = true;
+        pthread_cond_signal(&queueCond);
+        pthread_mutex_unlock(&queueMutex);
+
+        pthread_join(thread, NULL);
+        bStarted = false;
+    }
+
+    return !bFailed;
+}
+
+void *CacheWriter::staticRun(void *writer)
+{
+    ((CacheWriter*) writer)->run();
+    return NULL;
+}
+
+void CacheWriter::run()
+{
+    for (;;)
+    {
+        pthread_mutex_lock(&queueMutex);
+        while (chunks.empty() && !bClosing)
+            pthread_cond_wait(&queueCond, &queueMutex);
+
+        if (chunks.empty())
+        {
+            pthread_mutex_unlock(&queueMutex);
+            break;
+        }
+
+        DataChunk *chunk = chunks.front();
+        chunks.pop();
+        pthread_mutex_unlock(&queueMutex);
+
+        // Once a write fails the entry is incomplete, just drain the queue
+        if (!bFailed && cacheObject->writeBytes(chunk->data, chunk->size)
+                != chunk->size)
+        {
+            LOG4CXX_ERROR(xmlCacheWriterLog,
+                    "Failed to write " << chunk->size << " bytes to cacheObject");
+            bFailed = true;
+        }
+
+        chunk->unref();
+    }
+}
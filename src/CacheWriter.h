@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CACHEWRITER_H
+#define CACHEWRITER_H
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <queue>
+
+#include "CacheObject.h"
+
+/**
+ * Reference counted block of received bytes
+ *
+ * A block from curl is copied once into a chunk, which is then shared by the
+ * stream's overflow buffer and the cache writer.
+ */
+struct DataChunk
+{
+    char *data; /**< pointer to the bytes, stored right after the struct */
+    size_t size; /**< number of bytes in the chunk */
+    int refs; /**< number of owners */
+
+    /**
+     * Allocate a chunk holding a copy of buffer, with one reference
+     *
+     * @return pointer to the chunk
+     * @retval NULL if allocation failed
+     */
+    static DataChunk *create(const char *buffer, size_t size)
+    {
+        DataChunk *chunk = (DataChunk *) malloc(sizeof(DataChunk) + size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->data = (char *) (chunk + 1);
+        chunk->size = size;
+        chunk->refs = 1;
+        memcpy(chunk->data, buffer, size);
+        return chunk;
+    }
+
+    /**
+     * Add an owner
+     */
+    void ref()
+    {
+        __sync_add_and_fetch(&refs, 1);
+    }
+
+    /**
+     * Remove an owner, the chunk is freed when the last one is gone
+     */
+    void unref()
+    {
+        if (__sync_sub_and_fetch(&refs, 1) == 0)
+            free(this);
+    }
+};
+
+//
+// This class compresses received data into a CacheObject in a worker thread
+// so that deflate does not add to the latency of the parsing thread.
+//
+
+class CacheWriter
+{
+public:
+    CacheWriter(CacheObject *co);
+    ~CacheWriter();
+
+    bool write(DataChunk *chunk);
+    bool finish();
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    CacheWriter(const CacheWriter&);
+    CacheWriter& operator=(const CacheWriter&);
+
+    static void *staticRun(void *writer);
+    void run();
+
+    CacheObject *cacheObject;
+
+    std::queue<DataChunk *> chunks;
+    pthread_mutex_t queueMutex;
+    pthread_cond_t queueCond;
+    pthread_t thread;
+
+    bool bStarted;
+    bool bClosing;
+    bool bFailed;
+};
+
+#endif
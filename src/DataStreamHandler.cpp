@@ -36,12 +36,15 @@
 #define VERSION "x.y.z"
 #endif
 #include <string>
+#include <sstream>
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <log4cxx/logger.h>
 
@@ -51,16 +54,97 @@ log4cxx::LoggerPtr xmlDataStreamHlrLog(
 
 #include "DataStreamHandler.h"
 #include "CacheObject.h"
+#include "CacheRevalidator.h"
 #include "HttpStream.h"
 #include "FileStream.h"
+#include "FilePrefetcher.h"
+#include "FileWatcher.h"
+#include "DtdCache.h"
+#include "ReadAheadStream.h"
+#include "XmlElementIndex.h"
+#include "XmlError.h"
+#include "ZipDirectory.h"
+#include "ZipStream.h"
 #ifdef HAVE_LIBTIDY
 #include "TidyStream.h"
 #endif
 
-#define MAX_CACHE_SIZE 4194304 // 2048*2048
+#define DEFAULT_CACHE_BUDGET 4194304 // 2048*2048
+
+// Local files whose element index is kept
+#define MAX_FILE_INDEXES 64
+
+// Zip archives whose central directory is kept
+#define MAX_ZIP_DIRECTORIES 8
+
+// HTML documents whose verdict is kept
+#define MAX_HTML_VERDICTS 256
 
 using namespace std;
 
+// Holds a mutex for as long as it is in scope
+class MutexLock
+{
+public:
+    MutexLock(pthread_mutex_t *m) :
+            mutex(m)
+    {
+        pthread_mutex_lock(mutex);
+    }
+    ~MutexLock()
+    {
+        pthread_mutex_unlock(mutex);
+    }
+
+private:
+    MutexLock(const MutexLock&);
+    MutexLock& operator=(const MutexLock&);
+
+    pthread_mutex_t *mutex;
+};
+
+// Names of the transformations in cache keys
+static const char *transformNames[CACHE_TRANSFORMS] = { "", "tidied" };
+
+// Key of a transformation of an url in the cache, raw entries are keyed by
+// the url alone. Urls can not contain the tab that separates the name.
+static std::string cacheKey(const std::string &url, CacheTransform transform)
+{
+    if (transform == CACHE_RAW)
+        return url;
+    return url + "\t" + transformNames[transform];
+}
+
+// Path of the local file holding a cache entry, the archive for zip entries
+static std::string localPath(const std::string &key)
+{
+    std::string url = key.substr(0, key.find('\t'));
+    std::string archive, name;
+    if (ZipStream::splitUrl(url, archive, name))
+        return archive;
+    return url;
+}
+
+// Compare two optional header values
+static bool sameHeader(const char *a, const char *b)
+{
+    if (a == NULL || b == NULL)
+        return a == b;
+    return strcmp(a, b) == 0;
+}
+
+// Check by the ETag and Last-Modified of the response that a transformed
+// entry was made from the contents of a raw one. Without either header the
+// contents can not be compared.
+static bool sameContents(const CacheObject *raw, const CacheObject *transformed)
+{
+    if (raw->getEtag() == NULL && raw->getLastModified() == NULL)
+        return false;
+    return sameHeader(raw->getEtag(), transformed->getEtag())
+            && sameHeader(raw->getLastModified(),
+                    transformed->getLastModified());
+}
+
 DataStreamHandler* DataStreamHandler::pinstance = 0;
 
 /**
@@ -97,7 +181,8 @@ DataStreamHandler::DataStreamHandler():
     CURL_LOCK_DATA_COOKIE_MUTEX(),
     CURL_LOCK_DATA_DNS_MUTEX(),
     CURL_LOCK_DATA_SSL_SESSION_MUTEX(),
-    CURL_LOCK_DATA_CONNECT_MUTEX()
+    CURL_LOCK_DATA_CONNECT_MUTEX(),
+    cacheMutex()
 {
     // Allocate the curl multi handle
     fMulti = curl_multi_init();
@@ -112,6 +197,13 @@ DataStreamHandler::DataStreamHandler():
     pthread_mutex_init(&CURL_LOCK_DATA_SSL_SESSION_MUTEX, NULL);
     pthread_mutex_init(&CURL_LOCK_DATA_CONNECT_MUTEX, NULL);
 
+    // Cache methods call each other, so the lock is recursive
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cacheMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
     curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
     curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
     curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
@@ -124,6 +216,17 @@ DataStreamHandler::DataStreamHandler():
     mUseragent = string(PACKAGE)+"/"+string(VERSION);
     mTimeout = 30;
     bDebugmode = false;
+    bStaleWhileRevalidate = false;
+    bReadAhead = false;
+    filePrefetcher = NULL;
+    fileWatcher = NULL;
+    dtdCache = new DtdCache();
+
+    mCacheBudget = DEFAULT_CACHE_BUDGET;
+    mCacheHits = 0;
+    mCacheMisses = 0;
+    mCacheEvictions = 0;
+    mAccessTick = 0;
 }
 
 /**
@@ -150,19 +253,46 @@ DataStreamHandler::~DataStreamHandler()
      }
      */
 
+    // Wait for background revalidations, they use the share handle
+    while (!revalidations.empty())
+    {
+        delete revalidations.front();
+        revalidations.pop_front();
+    }
+
     while (!HttpCache.empty())
     {
         LOG4CXX_DEBUG(xmlDataStreamHlrLog,
                 "Freeing cacheObject for url: " << HttpCache.begin()->first << " => " << HttpCache.begin()->second->getContentLength() << "(" << HttpCache.begin()->second->getBufferSize() << ")");
-        delete HttpCache.begin()->second;
+        HttpCache.begin()->second->unref();
         HttpCache.erase(HttpCache.begin());
     }
+    CacheObject::freeCodecPool();
+    delete fileWatcher;
+
+    delete filePrefetcher;
+
+    delete dtdCache;
+
+    while (!ZipDirectories.empty())
+    {
+        delete ZipDirectories.begin()->second;
+        ZipDirectories.erase(ZipDirectories.begin());
+    }
+
+    while (!FileIndexes.empty())
+    {
+        delete FileIndexes.begin()->second;
+        FileIndexes.erase(FileIndexes.begin());
+    }
 
     // Cleanup the multi handle
     curl_multi_cleanup(fMulti);
 
     // Cleanup the share handle
     curl_share_cleanup(fShare);
+
+    pthread_mutex_destroy(&cacheMutex);
 }
 
 /**
@@ -201,20 +331,318 @@ void DataStreamHandler::setDebugmode(bool setting)
     bDebugmode = setting;
 }
 
+/**
+ * Toggle stale-while-revalidate mode on or off
+ *
+ * When on, a cached resource whose freshness has expired is served from the
+ * cache right away while a conditional request is sent in the background. A
+ * changed resource replaces the cache entry once the request completes.
+ * Entries marked no-cache or must-revalidate are always revalidated first.
+ *
+ * The default value is off.
+ *
+ * @param setting true for on, false for off
+ */
+void DataStreamHandler::setStaleWhileRevalidate(bool setting)
+{
+    bStaleWhileRevalidate = setting;
+}
+
+/**
+ * Toggle read-ahead mode on or off
+ *
+ * When on, every new stream is read by a worker thread that keeps a few
+ * buffers ahead of the parser, so that disk and network waits overlap with
+ * parsing. Http streams then drive their transfer with a curl multi handle
+ * of their own.
+ *
+ * The default value is off.
+ *
+ * @param setting true for on, false for off
+ */
+void DataStreamHandler::setReadAhead(bool setting)
+{
+    bReadAhead = setting;
+}
+
+/**
+ * Use a local DTD for a public identifier
+ *
+ * Documents with a DOCTYPE of the identifier get the entities declared in
+ * the DTD. The DTD is parsed once, when the first such document is parsed.
+ *
+ * No DTDs are bundled with the library, the application provides its own
+ * copies of the DTDs it needs.
+ *
+ * @param publicId the public identifier, e.g. "-//NISO//DTD dtbook 2005-1//EN"
+ * @param uri path or file: url of the DTD
+ */
+void DataStreamHandler::addCatalogEntry(const std::string &publicId,
+        const std::string &uri)
+{
+    dtdCache->addEntry(publicId, uri);
+}
+
+/**
+ * Find local DTDs with an XML catalog
+ *
+ * Identifiers not added with addCatalogEntry() are looked up in the
+ * catalogs, in the order they were added, and then in the catalogs of the
+ * system. DTDs are never fetched from the network.
+ *
+ * @param file path of the catalog
+ * @return false if the catalog can not be used
+ */
+bool DataStreamHandler::addCatalog(const std::string &file)
+{
+    return dtdCache->addCatalog(file);
+}
+
+/**
+ * Get the parsed DTD of a DOCTYPE
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * @param publicId the public identifier of the DOCTYPE, may be NULL
+ * @param systemId the system identifier of the DOCTYPE, may be NULL
+ * @return pointer to the DTD, shared by all readers
+ * @retval NULL if there is no local DTD for the DOCTYPE
+ */
+const CachedDtd *DataStreamHandler::getDtd(const char *publicId,
+        const char *systemId)
+{
+    return dtdCache->get((const xmlChar *) publicId,
+            (const xmlChar *) systemId);
+}
+
+/**
+ * Start loading a set of local files in the background
+ *
+ * The opens and reads of all the files are issued at once on a few worker
+ * threads, typically for the files of a book that is being opened. A stream
+ * opened later for one of the paths uses the loaded contents if the file is
+ * unchanged. Loaded files of an earlier call that were never opened are
+ * dropped.
+ *
+ * @param paths the paths of the files, as they will be passed to newStream
+ */
+void DataStreamHandler::prefetchFiles(const std::vector<std::string> &paths)
+{
+    MutexLock lock(&cacheMutex);
+    if (filePrefetcher == NULL)
+        filePrefetcher = new FilePrefetcher();
+    filePrefetcher->prefetch(paths);
+}
+
+/**
+ * Toggle watching of cached local files on or off
+ *
+ * Cached local files are checked against the size, modification time and
+ * inode of the file whenever they are used. When on, the files are watched
+ * with inotify instead and their entries are dropped as soon as they
+ * change. Where inotify is not available the checks stay in place.
+ *
+ * The default value is off.
+ *
+ * @param setting true for on, false for off
+ */
+void DataStreamHandler::setWatchFiles(bool setting)
+{
+    MutexLock lock(&cacheMutex);
+
+    if (!setting || fileWatcher != NULL)
+    {
+        if (!setting)
+        {
+            delete fileWatcher;
+            fileWatcher = NULL;
+        }
+        return;
+    }
+
+    fileWatcher = new FileWatcher();
+    if (!fileWatcher->isOpen())
+    {
+        LOG4CXX_WARN(xmlDataStreamHlrLog,
+                "Can not watch local files, checking them on use instead");
+        delete fileWatcher;
+        fileWatcher = NULL;
+        return;
+    }
+
+    // Start watching the files that are already cached, if still current
+    std::map<std::string, CacheObject*>::iterator it = HttpCache.begin();
+    while (it != HttpCache.end())
+    {
+        std::map<std::string, CacheObject*>::iterator entry = it++;
+        if (!(*entry).second->hasFileState())
+            continue;
+
+        struct stat st;
+        fileWatcher->watch((*entry).first, localPath((*entry).first));
+        if (stat(localPath((*entry).first).c_str(), &st) != 0
+                || !(*entry).second->matchesFileState(st.st_size,
+                        st.st_mtime, st.st_ino))
+            eraseCacheEntry(entry);
+    }
+}
+
+/**
+ * Set the number of bytes the cache may use
+ *
+ * Entries are evicted right away if the cache is larger than the new budget.
+ * A budget of 0 disables caching.
+ *
+ * @param bytes the cache budget in bytes
+ */
+void DataStreamHandler::setCacheBudget(unsigned long bytes)
+{
+    MutexLock lock(&cacheMutex);
+    mCacheBudget = bytes;
+    checkCacheSize(NULL);
+}
+
+/**
+ * Get the number of bytes the cache may use
+ */
+unsigned long DataStreamHandler::getCacheBudget() const
+{
+    return mCacheBudget;
+}
+
+/**
+ * Get the number of bytes used by the cache
+ *
+ * This includes the cached data, the urls and headers of every entry and
+ * the bookkeeping of the cache itself.
+ *
+ * @return cache usage in bytes
+ */
+unsigned long DataStreamHandler::getCacheUsage()
+{
+    MutexLock lock(&cacheMutex);
+    unsigned long cacheSize = 0;
+    for (itHttpCache = HttpCache.begin(); itHttpCache != HttpCache.end();
+            itHttpCache++)
+        cacheSize += entrySize(itHttpCache);
+
+    return cacheSize;
+}
+
+/**
+ * Get usage and hit, miss and eviction counters of the cache
+ */
+CacheStatistics DataStreamHandler::getCacheStatistics()
+{
+    MutexLock lock(&cacheMutex);
+
+    CacheStatistics stats;
+    stats.budget = mCacheBudget;
+    stats.usage = getCacheUsage();
+    stats.entries = HttpCache.size();
+    stats.hits = mCacheHits;
+    stats.misses = mCacheMisses;
+    stats.evictions = mCacheEvictions;
+    return stats;
+}
+
+/**
+ * Zero the hit, miss and eviction counters
+ */
+void DataStreamHandler::resetCacheStatistics()
+{
+    MutexLock lock(&cacheMutex);
+    mCacheHits = 0;
+    mCacheMisses = 0;
+    mCacheEvictions = 0;
+}
+
 /**
  * Create data stream from an URL
  *
+ * A tidied copy in the cache is served without opening the resource while
+ * it is current: a local file has not changed, or the raw response it was
+ * made from is still fresh. Otherwise the resource is read, and revalidated
+ * when it is remote, before the tidied copy is used or made again.
+ *
+ * Entries of zip archives, named zip:archive#name or archive.epub#name,
+ * are never cached whatever useCache says, only their tidied copies are.
+ *
  * @param url the url for the online resource
  * @param tidy parse the resource with libtidy
  * @param useCache store resouce in cache
  */
 InputStream* DataStreamHandler::newStream(std::string url, bool tidy, bool useCache)
+{
+    InputStream *stream = NULL;
+    {
+        MutexLock lock(&cacheMutex);
+        stream = openStream(url, tidy, useCache);
+    }
+
+    if (stream != NULL && bReadAhead)
+        return new ReadAheadStream(stream);
+    return stream;
+}
+
+/**
+ * Create the stream for an URL, without read-ahead
+ */
+InputStream* DataStreamHandler::openStream(std::string url, bool tidy, bool useCache)
 {
     // cacheobject for this URL
     CacheObject *cacheObject = NULL;
 
+    // archive and entry for urls in zip archives
+    std::string archive, name;
+
+#ifdef HAVE_LIBTIDY
+    // Serve a current tidied copy without opening the resource
+    if (tidy && USE_CACHE && useCache)
+    {
+        cacheObject = getCacheObject(url, CACHE_TIDIED);
+        if (cacheObject != NULL && cacheObject->getTidyFlag()
+                && (url.find("http") != 0 || cacheObject->isFresh()))
+        {
+            LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                    "Serving tidied cacheObject for " << url);
+            return new TidyStream(url, cacheObject);
+        }
+        cacheObject = NULL;
+    }
+#endif
+
     if (url.find("http") == 0)
     {
+        // Check to see if we have a cached item for this URL
+        if (USE_CACHE && useCache)
+        {
+            cacheObject = getCacheObject(url);
+        }
+
+        // Serve fresh entries, or stale ones in stale-while-revalidate mode,
+        // without waiting for the server
+        if (cacheObject != NULL && cacheObject->getState() == CacheObject::FULL
+                && (cacheObject->isFresh()
+                        || (bStaleWhileRevalidate
+                                && !cacheObject->mustRevalidate())))
+        {
+            if (!cacheObject->isFresh())
+                startRevalidation(url, cacheObject);
+            else
+                LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                        "Serving fresh cacheObject for " << url);
+
+            HttpStream *cacheStream = new HttpStream(url, cacheObject);
+            cacheStream->useCache(useCache);
+#ifdef HAVE_LIBTIDY
+            if (tidy)
+                return new TidyStream(url, cacheStream);
+            else
+#endif
+                return cacheStream;
+        }
+
         // Create the HttpStream
         CURL *fEasy = NULL;
 
@@ -261,18 +689,33 @@ InputStream* DataStreamHandler::newStream(std::string url, bool tidy, bool useCa
                 curl_easy_setopt(fEasy, CURLOPT_VERBOSE, true);
         }
 
-        // Check to see if we have a cached item for this URL
-        if (USE_CACHE && useCache)
-        {
-            cacheObject = getCacheObject(url);
-        }
+        // A stream read by a worker thread must not share the multi stack
+        // with streams read by other threads
+        CURLM *multi = fMulti;
+        if (bReadAhead)
+            multi = curl_multi_init();
 
         HttpStream *newStream = NULL;
-        newStream = new HttpStream(url, fEasy, fMulti, cacheObject);
+        newStream = new HttpStream(url, fEasy, multi, cacheObject,
+                multi != fMulti);
         newStream->useCache(useCache);
 
         // Add easy handle to the multi stack
-        curl_multi_add_handle(fMulti, fEasy);
+        curl_multi_add_handle(multi, fEasy);
+#ifdef HAVE_LIBTIDY
+        if (tidy)
+            return new TidyStream(url, newStream);
+        else
+#endif
+            return newStream;
+    }
+    else if (ZipStream::splitUrl(url, archive, name))
+    {
+        // Entries of zip archives are inflated straight from the archive and
+        // never cached, only their tidied copies are
+        ZipStream *newStream = new ZipStream(archive, name,
+                getZipDirectory(archive));
+        newStream->useCache(useCache);
 #ifdef HAVE_LIBTIDY
         if (tidy)
             return new TidyStream(url, newStream);
@@ -288,9 +731,13 @@ InputStream* DataStreamHandler::newStream(std::string url, bool tidy, bool useCa
             cacheObject = getCacheObject(url);
         }
 
+        PrefetchedFile *prefetched = NULL;
+        if (cacheObject == NULL && filePrefetcher != NULL)
+            prefetched = filePrefetcher->take(url);
+
         // Create a filestream
         FileStream *newStream = NULL;
-        newStream = new FileStream(url, cacheObject);
+        newStream = new FileStream(url, cacheObject, prefetched);
         newStream->useCache(useCache);
 #ifdef HAVE_LIBTIDY
         if (tidy)
@@ -312,6 +759,7 @@ InputStream* DataStreamHandler::newStream(std::string url, bool tidy, bool useCa
  */
 void DataStreamHandler::releaseHandle(CURL *fEasy)
 {
+    MutexLock lock(&cacheMutex);
     // Remove the easy handle from the multi stack
     curl_multi_remove_handle(fMulti, fEasy);
 
@@ -326,43 +774,167 @@ void DataStreamHandler::releaseHandle(CURL *fEasy)
     }
 }
 
+/**
+ * Get the number of bytes a cache entry uses, including the key and map node
+ */
+unsigned long DataStreamHandler::entrySize(
+        const std::map<std::string, CacheObject*>::iterator &entry) const
+{
+    // A map node holds the pair, three links and a color
+    return (*entry).second->getMemoryUsage() + (*entry).first.capacity()
+            + sizeof(*entry) + 4 * sizeof(void *);
+}
+
 /**
  * Check and free cached objects
  *
- * Cached objects are freed until current cache size is smaller then MAX_CACHE_SIZE.
+ * Cached objects are freed, least recently used first, until current cache
+ * size is within the budget. The item that was just added is freed last.
  *
- * @param item
+ * @param item the newly added object, or NULL
  */
 void DataStreamHandler::checkCacheSize(CacheObject *item)
 {
     // Check that the cache size don't exceed the maximum size allowed
+    unsigned long cacheSize = getCacheUsage();
+    if (cacheSize <= mCacheBudget)
+        return;
 
-    unsigned long cacheSize = 0;
+    // Order the other entries by their last access
+    std::vector<std::pair<unsigned long, std::string> > victims;
     for (itHttpCache = HttpCache.begin(); itHttpCache != HttpCache.end();
             itHttpCache++)
     {
-        cacheSize += (*itHttpCache).second->getBufferSize();
+        if ((*itHttpCache).second != item)
+            victims.push_back(
+                    std::make_pair((*itHttpCache).second->getLastAccess(),
+                            (*itHttpCache).first));
+    }
+    std::sort(victims.begin(), victims.end());
+
+    for (size_t i = 0; i < victims.size() && cacheSize > mCacheBudget; i++)
+    {
+        itHttpCache = HttpCache.find(victims[i].second);
+        unsigned long size = entrySize(itHttpCache);
+        cacheSize -= size;
+
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                "Freeing " << size << " bytes for url '" << (*itHttpCache).first << "'");
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog, "Cache size after: " << cacheSize);
 
-        //LOG4CXX_DEBUG(xmlDataStreamHlrLog, (*itHttpCache).first << " => " << (*itHttpCache).second->getContentLength() << "(" << (*itHttpCache).second->getBufferSize() << ")");
+        // Streams still reading the entry keep it alive
+        eraseCacheEntry(itHttpCache);
+        mCacheEvictions++;
     }
 
-    itHttpCache = HttpCache.end();
-    while (cacheSize > MAX_CACHE_SIZE && --itHttpCache != HttpCache.begin())
+    // An entry larger than the whole budget is not kept either
+    if (cacheSize > mCacheBudget && item != NULL)
     {
-        if ((*itHttpCache).second != NULL && (*itHttpCache).second != item
-                && (*itHttpCache).second->getState() != CacheObject::BUSY)
+        for (itHttpCache = HttpCache.begin(); itHttpCache != HttpCache.end();
+                itHttpCache++)
         {
+            if ((*itHttpCache).second == item)
+            {
+                LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                        "Not caching '" << (*itHttpCache).first << "', larger than the cache budget");
+                eraseCacheEntry(itHttpCache);
+                mCacheEvictions++;
+                break;
+            }
+        }
+    }
+}
 
-            cacheSize -= (*itHttpCache).second->getBufferSize();
+/**
+ * Start a background conditional request for a stale cache entry
+ *
+ * @param url the url of the resource
+ * @param item the stale cached object
+ */
+void DataStreamHandler::startRevalidation(const std::string &url,
+        CacheObject *item)
+{
+    // Only one request per url at a time
+    std::list<CacheRevalidator*>::iterator it;
+    for (it = revalidations.begin(); it != revalidations.end(); it++)
+    {
+        if ((*it)->getUrl() == url)
+            return;
+    }
 
-            LOG4CXX_DEBUG(xmlDataStreamHlrLog,
-                    "Freeing " << (*itHttpCache).second->getBufferSize() << " bytes for url '" << (*itHttpCache).first << "'");
-            LOG4CXX_DEBUG(xmlDataStreamHlrLog,
-                    "Cache size after: " << cacheSize);
+    LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+            "Serving stale cacheObject for " << url << " while revalidating");
+
+    CacheRevalidator *revalidator = new CacheRevalidator(url, item, fShare,
+            mUseragent, mTimeout);
+    if (revalidator->start())
+        revalidations.push_back(revalidator);
+    else
+        delete revalidator;
+}
+
+/**
+ * Refresh the freshness of a cached entry after a 304 response
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * The entry is shared with other readers, so it is only changed under the
+ * cache lock. A 304 without Cache-Control keeps the stored freshness.
+ *
+ * @param item the cached object that was revalidated
+ * @param cacheControl the Cache-Control of the 304 response, may be empty
+ */
+void DataStreamHandler::refreshCacheObject(CacheObject *item,
+        const std::string &cacheControl)
+{
+    if (cacheControl.empty())
+        return;
 
-            delete (*itHttpCache).second;
-            HttpCache.erase(itHttpCache);
+    MutexLock lock(&cacheMutex);
+    item->resetFreshness();
+    item->setCacheControl(cacheControl.c_str());
+}
+
+/**
+ * Apply the results of completed background revalidations
+ *
+ * A 304 refreshes the freshness of the cached entry, a 200 replaces it, or
+ * drops it when the new response may not be stored. Streams reading the
+ * old entry keep their own reference to it.
+ */
+void DataStreamHandler::checkRevalidations()
+{
+    std::list<CacheRevalidator*>::iterator it = revalidations.begin();
+    while (it != revalidations.end())
+    {
+        CacheRevalidator *revalidator = *it;
+        if (!revalidator->isDone())
+        {
+            it++;
+            continue;
+        }
+
+        std::map<std::string, CacheObject*>::iterator item = HttpCache.find(
+                revalidator->getUrl());
+
+        revalidator->join();
+        if (revalidator->getHttpCode() == 304 && item != HttpCache.end())
+        {
+            LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                    "cacheObject for " << revalidator->getUrl() << " not modified");
+            refreshCacheObject((*item).second, revalidator->getCacheControl());
         }
+        else if (revalidator->getHttpCode() == 200)
+        {
+            CacheObject *co = revalidator->takeCacheObject();
+            if (co != NULL)
+                addCacheObject(revalidator->getUrl(), co);
+            else if (item != HttpCache.end())
+                eraseCacheEntry(item);
+        }
+
+        delete revalidator;
+        it = revalidations.erase(it);
     }
 }
 
@@ -371,37 +943,47 @@ void DataStreamHandler::checkCacheSize(CacheObject *item)
  *
  * Do not invoke this method. It shall only be used internally by xmlreader.
  *
+ * The cache takes over the caller's reference to the object.
+ *
+ * A new raw entry of a remote resource replaces the other transformations
+ * of the url, unless its ETag and Last-Modified show that they were made
+ * from the same contents. A new transformation takes over those headers and
+ * the freshness of the raw entry. Transformations of local files are
+ * checked against the file instead.
+ *
  * @param url the url of the resource
  * @param item pointer to the cached object
+ * @param transform transformation applied to the cached data
  * @return boolean of the result
  * @retval true when the object was added or already cached
  * @retval false when the object was not added
  */
-bool DataStreamHandler::addCacheObject(std::string url, CacheObject *item)
+bool DataStreamHandler::addCacheObject(std::string url, CacheObject *item,
+        CacheTransform transform)
 {
-    // Add an object to a cache, identify it by the URL
+    MutexLock lock(&cacheMutex);
+    // Add an object to a cache, identify it by the URL and transformation
+    std::string key = cacheKey(url, transform);
     LOG4CXX_DEBUG(xmlDataStreamHlrLog, "adding object " << url);
     if (USE_CACHE)
     {
         // Check if we already have a cache item for this url
-        itHttpCache = HttpCache.find(url);
-        if (itHttpCache != HttpCache.end() && (*itHttpCache).second != item)
+        itHttpCache = HttpCache.find(key);
+        if (itHttpCache != HttpCache.end() && (*itHttpCache).second == item)
         {
-
-            if ((*itHttpCache).second->getState() == CacheObject::BUSY)
-            {
-                LOG4CXX_DEBUG(xmlDataStreamHlrLog,
-                        "Not replacing busy cacheObject for url '" << (*itHttpCache).first << "'");
-                delete item;
-                return true;
-            }
-
+            // Already cached, drop the extra reference
+            item->unref();
+            return true;
+        }
+        else if (itHttpCache != HttpCache.end())
+        {
+            // Readers of the old entry hold references of their own, so it
+            // can be replaced while it is being read
             LOG4CXX_DEBUG(xmlDataStreamHlrLog,
                     "Replacing cacheObject for url '" << (*itHttpCache).first << "'");
             LOG4CXX_DEBUG(xmlDataStreamHlrLog,
                     "Freeing cacheObject for url '" << (*itHttpCache).first << "' addr: " << (*itHttpCache).second << "/" << item);
-            delete (*itHttpCache).second;
-            HttpCache.erase(itHttpCache);
+            eraseCacheEntry(itHttpCache);
         }
         else
         {
@@ -411,13 +993,58 @@ bool DataStreamHandler::addCacheObject(std::string url, CacheObject *item)
 
         LOG4CXX_DEBUG(xmlDataStreamHlrLog, "Adding cache object for " << url);
 
-        HttpCache.insert(pair<std::string, CacheObject*>(url, item));
+        if (transform == CACHE_RAW)
+        {
+            for (int t = CACHE_RAW + 1;
+                    t < CACHE_TRANSFORMS && url.find("http") == 0; t++)
+            {
+                itHttpCache = HttpCache.find(
+                        cacheKey(url, (CacheTransform) t));
+                if (itHttpCache != HttpCache.end()
+                        && !sameContents(item, (*itHttpCache).second))
+                    eraseCacheEntry(itHttpCache);
+            }
+        }
+        else if (url.find("http") == 0)
+        {
+            itHttpCache = HttpCache.find(url);
+            if (itHttpCache != HttpCache.end())
+            {
+                CacheObject *raw = (*itHttpCache).second;
+                if (raw->getEtag() != NULL)
+                    item->setEtag(raw->getEtag());
+                if (raw->getLastModified() != NULL)
+                    item->setLastModified(raw->getLastModified());
+                item->setExpires(raw->isFresh() ? raw->getExpires() : 0);
+            }
+        }
+
+        // Entries of local files are checked against the file on use, the
+        // watch is added first so that no change goes unnoticed
+        if (url.find("http") != 0)
+        {
+            struct stat st;
+            bool watched = fileWatcher != NULL
+                    && fileWatcher->watch(key, localPath(key));
+            if (stat(localPath(key).c_str(), &st) != 0)
+            {
+                if (watched)
+                    fileWatcher->unwatch(key);
+                item->unref();
+                return false;
+            }
+            item->setFileState(st.st_size, st.st_mtime, st.st_ino);
+        }
+
+        item->setLastAccess(++mAccessTick);
+        HttpCache.insert(pair<std::string, CacheObject*>(key, item));
 
         checkCacheSize(item);
 
         return true;
     }
 
+    item->unref();
     return false;
 }
 
@@ -426,14 +1053,25 @@ bool DataStreamHandler::addCacheObject(std::string url, CacheObject *item)
  *
  * Do not invoke this method. It shall only be used internally by xmlreader.
  *
+ * The pointer is borrowed, streams that keep the object take a reference
+ * of their own with CacheObject::ref().
+ *
  * @param url the url of the resource
+ * @param transform transformation of the resource to look for
  * @return pointer to the cached object
  * @retval NULL if the object not was found
  */
-CacheObject *DataStreamHandler::getCacheObject(const std::string &url)
+CacheObject *DataStreamHandler::getCacheObject(const std::string &url,
+        CacheTransform transform)
 {
+    MutexLock lock(&cacheMutex);
     CacheObject *cacheObject = NULL;
 
+    if (!revalidations.empty())
+        checkRevalidations();
+    if (fileWatcher != NULL)
+        checkFileChanges();
+
     LOG4CXX_DEBUG(xmlDataStreamHlrLog,
             "Getting cacheobject for " << url << " cache size: " << HttpCache.size());
 
@@ -443,19 +1081,387 @@ CacheObject *DataStreamHandler::getCacheObject(const std::string &url)
      }
      */
 
-    itHttpCache = HttpCache.find(url);
+    itHttpCache = HttpCache.find(cacheKey(url, transform));
+    if (itHttpCache != HttpCache.end() && !isCurrent(itHttpCache))
+    {
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                "Dropping cacheObject of changed file " << url);
+        eraseCacheEntry(itHttpCache);
+        itHttpCache = HttpCache.end();
+    }
+
+    // A transformation of a remote resource follows the raw entry, which
+    // is revalidated with the server
+    if (itHttpCache != HttpCache.end() && transform != CACHE_RAW
+            && url.find("http") == 0)
+    {
+        std::map<std::string, CacheObject*>::iterator raw = HttpCache.find(url);
+        if (raw != HttpCache.end()
+                && !sameContents((*raw).second, (*itHttpCache).second))
+        {
+            LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                    "Dropping cacheObject made from other contents of " << url);
+            eraseCacheEntry(itHttpCache);
+            itHttpCache = HttpCache.end();
+        }
+        else if (raw != HttpCache.end())
+        {
+            (*itHttpCache).second->setExpires(
+                    (*raw).second->isFresh() ? (*raw).second->getExpires() : 0);
+        }
+    }
+
     if (itHttpCache != HttpCache.end())
     {
-        if ((*itHttpCache).second->getState() != CacheObject::BUSY)
-            cacheObject = (*itHttpCache).second;
-        else
-            LOG4CXX_WARN(xmlDataStreamHlrLog,
-                    "cacheObject for '" << url << "' BUSY");
+        cacheObject = (*itHttpCache).second;
+        cacheObject->setLastAccess(++mAccessTick);
+        mCacheHits++;
     }
+    else
+        mCacheMisses++;
 
     return cacheObject;
 }
 
+/**
+ * Check that the entry of a local file still matches the file
+ *
+ * Entries of watched files are current until the watcher reports a change.
+ *
+ * @return true for remote resources and unchanged files
+ */
+bool DataStreamHandler::isCurrent(
+        const std::map<std::string, CacheObject*>::iterator &entry)
+{
+    CacheObject *item = (*entry).second;
+    if (!item->hasFileState())
+        return true;
+    if (fileWatcher != NULL && fileWatcher->isWatched((*entry).first))
+        return true;
+
+    struct stat st;
+    return stat(localPath((*entry).first).c_str(), &st) == 0
+            && item->matchesFileState(st.st_size, st.st_mtime, st.st_ino);
+}
+
+/**
+ * Drop the entries of local files the watcher reports as changed
+ */
+void DataStreamHandler::checkFileChanges()
+{
+    std::vector<std::string> changed;
+    if (!fileWatcher->readChanges(changed))
+    {
+        // Events were lost, check every local file on its next use
+        LOG4CXX_WARN(xmlDataStreamHlrLog,
+                "Missed changes of watched files, checking them on use");
+        std::map<std::string, CacheObject*>::iterator it;
+        for (it = HttpCache.begin(); it != HttpCache.end(); it++)
+            fileWatcher->unwatch((*it).first);
+    }
+
+    for (size_t i = 0; i < changed.size(); i++)
+    {
+        std::map<std::string, CacheObject*>::iterator it = HttpCache.find(
+                changed[i]);
+        if (it == HttpCache.end() || !(*it).second->hasFileState())
+            continue;
+
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                "Dropping cacheObject of changed file " << changed[i]);
+        eraseCacheEntry(it);
+    }
+}
+
+/**
+ * Remove an entry from the cache and stop watching its file
+ *
+ * Streams still reading the entry keep it alive.
+ */
+void DataStreamHandler::eraseCacheEntry(
+        std::map<std::string, CacheObject*>::iterator entry)
+{
+    if (fileWatcher != NULL)
+        fileWatcher->unwatch((*entry).first);
+    (*entry).second->unref();
+    HttpCache.erase(entry);
+}
+
+/**
+ * Store the element index of a resource
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * The index of a remote resource is kept with its cache entry and goes
+ * away with it. The index of a local file is kept along with the size,
+ * modification time and inode of the file.
+ *
+ * @param url the url of the resource
+ * @param index pointer to the index, which the handler takes over, or
+ * NULL to drop the current one
+ */
+void DataStreamHandler::setElementIndex(const std::string &url,
+        XmlElementIndex *index)
+{
+    MutexLock lock(&cacheMutex);
+    if (url.find("http") == 0)
+    {
+        itHttpCache = HttpCache.find(url);
+        if (itHttpCache == HttpCache.end())
+        {
+            delete index;
+            return;
+        }
+
+        CacheObject *cacheObject = (*itHttpCache).second;
+        cacheObject->setElementIndex(index);
+        if (index != NULL)
+            checkCacheSize(cacheObject);
+        return;
+    }
+
+    std::map<std::string, XmlElementIndex*>::iterator it = FileIndexes.find(
+            url);
+    if (it != FileIndexes.end())
+    {
+        delete (*it).second;
+        FileIndexes.erase(it);
+    }
+
+    if (index == NULL)
+        return;
+
+    struct stat st;
+    if (stat(url.c_str(), &st) != 0)
+    {
+        delete index;
+        return;
+    }
+    index->setFileState(st.st_size, st.st_mtime, st.st_ino);
+
+    if (FileIndexes.size() >= MAX_FILE_INDEXES)
+    {
+        delete FileIndexes.begin()->second;
+        FileIndexes.erase(FileIndexes.begin());
+    }
+
+    LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+            "Indexed " << index->size() << " elements of " << url);
+    FileIndexes.insert(
+            pair<std::string, XmlElementIndex*>(url, index));
+}
+
+/**
+ * Get the validator of the current contents of a resource
+ *
+ * A remote resource is validated by the ETag and Last-Modified of its
+ * cache entry, fresh or not. A local file is validated by its size,
+ * modification time and inode.
+ *
+ * @param url the url of the resource
+ * @param validator set to the validator
+ * @return false if the contents can not be validated
+ */
+bool DataStreamHandler::getValidator(const std::string &url,
+        std::string &validator)
+{
+    std::ostringstream out;
+
+    if (url.find("http") == 0)
+    {
+        std::map<std::string, CacheObject*>::iterator it = HttpCache.find(url);
+        if (it == HttpCache.end()
+                || (*it).second->getState() != CacheObject::FULL)
+            return false;
+
+        CacheObject *item = (*it).second;
+        if (item->getEtag() == NULL && item->getLastModified() == NULL)
+            return false;
+        out << (item->getEtag() ? item->getEtag() : "") << "\n"
+                << (item->getLastModified() ? item->getLastModified() : "");
+    }
+    else
+    {
+        struct stat st;
+        if (stat(localPath(url).c_str(), &st) != 0)
+            return false;
+        out << st.st_size << "\n" << st.st_mtime << "\n" << st.st_ino;
+    }
+
+    validator = out.str();
+    return true;
+}
+
+/**
+ * Remember whether a HTML document parses without tidy
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * The verdict holds until the contents of the document change.
+ *
+ * @param url the url of the document
+ * @param verdict the verdict, HTML_UNKNOWN to forget it
+ */
+void DataStreamHandler::setHtmlVerdict(const std::string &url,
+        HtmlVerdict verdict)
+{
+    MutexLock lock(&cacheMutex);
+
+    std::string validator;
+    HtmlVerdicts.erase(url);
+    if (verdict == HTML_UNKNOWN || !getValidator(url, validator))
+        return;
+
+    if (HtmlVerdicts.size() >= MAX_HTML_VERDICTS)
+        HtmlVerdicts.erase(HtmlVerdicts.begin());
+    HtmlVerdicts.insert(
+            pair<std::string, std::pair<HtmlVerdict, std::string> >(url,
+                    std::pair<HtmlVerdict, std::string>(verdict, validator)));
+}
+
+/**
+ * Get whether a HTML document parses without tidy
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * The verdict of a remote document only holds while its cache entry is
+ * fresh. A stale entry is revalidated by the preparse, which reads the
+ * document anyway and records the verdict again, so a changed document is
+ * downloaded only once and never checked against the stale copy.
+ *
+ * @param url the url of the document
+ * @return the verdict
+ * @retval HTML_UNKNOWN if the document was not checked, has changed or
+ * needs to be revalidated
+ */
+HtmlVerdict DataStreamHandler::getHtmlVerdict(const std::string &url)
+{
+    MutexLock lock(&cacheMutex);
+
+    std::map<std::string, std::pair<HtmlVerdict, std::string> >::iterator it =
+            HtmlVerdicts.find(url);
+    if (it == HtmlVerdicts.end())
+        return HTML_UNKNOWN;
+
+    if (url.find("http") == 0)
+    {
+        std::map<std::string, CacheObject*>::iterator entry = HttpCache.find(
+                url);
+        if (entry == HttpCache.end() || !(*entry).second->isFresh())
+            return HTML_UNKNOWN;
+    }
+
+    std::string validator;
+    if (!getValidator(url, validator) || validator != (*it).second.second)
+    {
+        HtmlVerdicts.erase(it);
+        return HTML_UNKNOWN;
+    }
+
+    return (*it).second.first;
+}
+
+/**
+ * Get the central directory of a zip archive
+ *
+ * The directory is read on first use and kept until the archive changes.
+ *
+ * @param archive path of the archive
+ * @return pointer to the directory
+ * @retval NULL if the archive can not be read
+ */
+ZipDirectory *DataStreamHandler::getZipDirectory(const std::string &archive)
+{
+    struct stat st;
+    if (stat(archive.c_str(), &st) != 0)
+        return NULL;
+
+    std::map<std::string, ZipDirectory*>::iterator it = ZipDirectories.find(
+            archive);
+    if (it != ZipDirectories.end())
+    {
+        if ((*it).second->matchesFileState(st.st_size, st.st_mtime, st.st_ino))
+            return (*it).second;
+
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                "Dropping zip directory of changed archive " << archive);
+        delete (*it).second;
+        ZipDirectories.erase(it);
+    }
+
+    ZipDirectory *directory = new ZipDirectory();
+    if (!directory->load(archive))
+    {
+        LOG4CXX_WARN(xmlDataStreamHlrLog,
+                "Failed to read zip directory of " << archive << ": " << directory->getErrorMsg());
+        delete directory;
+        return NULL;
+    }
+
+    if (ZipDirectories.size() >= MAX_ZIP_DIRECTORIES)
+    {
+        delete ZipDirectories.begin()->second;
+        ZipDirectories.erase(ZipDirectories.begin());
+    }
+    ZipDirectories.insert(
+            pair<std::string, ZipDirectory*>(archive, directory));
+
+    return directory;
+}
+
+/**
+ * Look up an element in the element index of a resource
+ *
+ * Do not invoke this method. It shall only be used internally by xmlreader.
+ *
+ * The index may be replaced by another thread once the cache is unlocked,
+ * so the position is copied out while the lock is held.
+ *
+ * @param url the url of the resource
+ * @param id the id of the element
+ * @param offset set to the byte offset of the element
+ * @param depth set to the depth of the element
+ * @param namespaces set to the namespace declarations in scope
+ * @return boolean of the result
+ * @retval false if there is no index, the local file has changed or the
+ * element is not indexed
+ * @retval true if the element was found
+ */
+bool DataStreamHandler::findIndexedElement(const std::string &url,
+        const std::string &id, unsigned long &offset, int &depth,
+        std::string &namespaces)
+{
+    MutexLock lock(&cacheMutex);
+    if (url.find("http") == 0)
+    {
+        itHttpCache = HttpCache.find(url);
+        if (itHttpCache == HttpCache.end())
+            return false;
+        const XmlElementIndex *index =
+                (*itHttpCache).second->getElementIndex();
+        return index != NULL && index->find(id, offset, depth, namespaces);
+    }
+
+    std::map<std::string, XmlElementIndex*>::iterator it = FileIndexes.find(
+            url);
+    if (it == FileIndexes.end())
+        return false;
+
+    struct stat st;
+    if (stat(url.c_str(), &st) != 0
+            || !(*it).second->matchesFileState(st.st_size, st.st_mtime,
+                    st.st_ino))
+    {
+        LOG4CXX_DEBUG(xmlDataStreamHlrLog,
+                "Dropping element index of changed file " << url);
+        delete (*it).second;
+        FileIndexes.erase(it);
+        return false;
+    }
+
+    return (*it).second->find(id, offset, depth, namespaces);
+}
+
 /**
  * Implements a static lock callback function
  *
@@ -26,7 +26,9 @@
 #include <pthread.h>
 #include <string>
 #include <queue>
+#include <vector>
 #include <map>
+#include <list>
 
 #include "InputStream.h"
 
@@ -45,10 +47,50 @@
 
 // Forward declaration of class CacheObject, keeps interface clean
 class CacheObject;
+class CacheRevalidator;
+class XmlElementIndex;
+class FilePrefetcher;
+class ZipDirectory;
+class FileWatcher;
+class DtdCache;
+class CachedDtd;
+
+// Transformation applied to a resource before it was cached, every
+// transformation of a url is a separate cache entry
+enum CacheTransform
+{
+    CACHE_RAW, // the resource as received
+    CACHE_TIDIED, // the resource after libtidy
+    CACHE_TRANSFORMS
+};
+
+// Whether a HTML document parses as it is or has to be tidied first
+enum HtmlVerdict
+{
+    HTML_UNKNOWN, // not checked, or the document changed since
+    HTML_WELL_FORMED,
+    HTML_NEEDS_TIDY
+};
+
+// Usage and effectiveness of the cache
+struct CacheStatistics
+{
+    unsigned long budget; // Bytes the cache may use
+    unsigned long usage; // Bytes used by the cached entries, overhead included
+    unsigned long entries; // Number of cached entries
+    unsigned long hits; // Lookups that found an entry
+    unsigned long misses; // Lookups that found nothing
+    unsigned long evictions; // Entries dropped to stay within the budget
+};
 
 //
 // This class acts as a handler for all the active DataStreams
 //
+// No DTDs are bundled with the library. The entities of a DOCTYPE, such as
+// those of DTBook, XHTML or SMIL, are only expanded when its DTD is
+// registered with addCatalogEntry() or found in an XML catalog, otherwise
+// they are replaced by '_' with a warning.
+//
 
 class KOLIBRE_API DataStreamHandler
 {
@@ -62,10 +104,31 @@ public:
     void setUseragent(std::string useragent); // Useragent string to use
     void setTimeout(unsigned int timeout); // Timeout in seconds
     void setDebugmode(bool setting); // Will make transfers verbose (LOG_DEBUG)
+    void setStaleWhileRevalidate(bool setting); // Serve stale cache entries while revalidating
+    void setReadAhead(bool setting); // Read streams in a worker thread while parsing
+    void prefetchFiles(const std::vector<std::string> &paths); // Load local files before they are opened
+    void setWatchFiles(bool setting); // Drop cached local files as soon as they change
+    void addCatalogEntry(const std::string &publicId, const std::string &uri); // Local DTD of a public identifier
+    bool addCatalog(const std::string &file); // Find local DTDs with an XML catalog
+
+    void setCacheBudget(unsigned long bytes); // Bytes the cache may use
+    unsigned long getCacheBudget() const;
+    unsigned long getCacheUsage(); // Bytes currently used by the cache
+    CacheStatistics getCacheStatistics();
+    void resetCacheStatistics(); // Zero the hit, miss and eviction counters
 
     // only used internally by xmlreader
-    bool addCacheObject(std::string, CacheObject *);
-    CacheObject *getCacheObject(const std::string &);
+    bool addCacheObject(std::string, CacheObject *,
+            CacheTransform transform = CACHE_RAW);
+    CacheObject *getCacheObject(const std::string &,
+            CacheTransform transform = CACHE_RAW);
+    void refreshCacheObject(CacheObject *, const std::string &);
+    void setElementIndex(const std::string &, XmlElementIndex *);
+    bool findIndexedElement(const std::string &, const std::string &,
+            unsigned long &, int &, std::string &);
+    void setHtmlVerdict(const std::string &, HtmlVerdict);
+    HtmlVerdict getHtmlVerdict(const std::string &);
+    const CachedDtd *getDtd(const char *publicId, const char *systemId);
     void releaseHandle(CURL *fEasy);
 
 private:
@@ -101,17 +164,59 @@ private:
 
     DataStreamHandler();
 
+    InputStream* openStream(std::string url, bool tidy, bool useCache);
+
     std::queue<CURL *> freeHandles;
 
+    // Guards the cache and the free handles, which read-ahead threads use too
+    pthread_mutex_t cacheMutex;
+
     // Http Cache variables
     std::map<std::string, CacheObject*> HttpCache;
     std::map<std::string, CacheObject*>::iterator itHttpCache;
+    unsigned long mCacheBudget;
+    unsigned long mCacheHits;
+    unsigned long mCacheMisses;
+    unsigned long mCacheEvictions;
+    unsigned long mAccessTick; // Counts cache accesses, orders entries by use
+
+    // Watches the files of cached local resources, NULL if not enabled
+    FileWatcher *fileWatcher;
+    void checkFileChanges();
+    bool isCurrent(const std::map<std::string, CacheObject*>::iterator &);
+    void eraseCacheEntry(std::map<std::string, CacheObject*>::iterator);
+
+    // Element indexes of local files, checked against the file on use
+    std::map<std::string, XmlElementIndex*> FileIndexes;
+
+    // Verdicts on HTML documents along with the validator of the contents
+    // they were reached on
+    std::map<std::string, std::pair<HtmlVerdict, std::string> > HtmlVerdicts;
+    bool getValidator(const std::string &, std::string &);
+
+    // Central directories of zip archives, checked against the archive on use
+    std::map<std::string, ZipDirectory*> ZipDirectories;
+    ZipDirectory *getZipDirectory(const std::string &archive);
+
+    // Local files loaded ahead of their streams
+    FilePrefetcher *filePrefetcher;
+
+    // DTDs of DOCTYPEs, parsed once for all readers
+    DtdCache *dtdCache;
+
+    // Conditional requests running in the background
+    std::list<CacheRevalidator*> revalidations;
 
     std::string mUseragent;
     unsigned int mTimeout;
     bool bDebugmode;
+    bool bStaleWhileRevalidate;
+    bool bReadAhead;
 
     void checkCacheSize(CacheObject *);
+    unsigned long entrySize(const std::map<std::string, CacheObject*>::iterator &) const;
+    void startRevalidation(const std::string &, CacheObject *);
+    void checkRevalidations();
 };
 
 #endif
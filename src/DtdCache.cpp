@@ -0,0 +1,439 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <libxml/parser.h>
+#include <libxml/parserInternals.h>
+
+#include "DtdCache.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlDtdCacheLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.dtdcache"));
+
+// Entities referring to entities, deeper nesting is not expanded
+#define MAX_ENTITY_DEPTH 8
+
+static void freeEntity(void *payload, const xmlChar *name)
+{
+    xmlEntityPtr entity = (xmlEntityPtr) payload;
+    xmlFree((xmlChar *) entity->name);
+    xmlFree(entity->content);
+    free(entity);
+}
+
+#if LIBXML_VERSION >= 21200
+static void dtdErrorHandler(void *userData, const xmlError *error)
+#else
+static void dtdErrorHandler(void *userData, xmlErrorPtr error)
+#endif
+{
+    if (error != NULL && error->message != NULL)
+        LOG4CXX_WARN(xmlDtdCacheLog,
+                "DTD " << (error->file ? error->file : "") << ":" << error->line << ": " << error->message);
+}
+
+CachedDtd::CachedDtd(xmlDtdPtr dtd) :
+        pDtd(dtd), pEntities(NULL)
+{
+    pEntities = xmlHashCreate(0);
+    if (pDtd->entities != NULL)
+        xmlHashScan((xmlHashTablePtr) pDtd->entities, staticAddEntity, this);
+}
+
+CachedDtd::~CachedDtd()
+{
+    xmlHashFree(pEntities, freeEntity);
+    xmlFreeDtd(pDtd);
+}
+
+xmlDtdPtr CachedDtd::getDtd() const
+{
+    return pDtd;
+}
+
+/**
+ * Get a text entity declared in the DTD
+ *
+ * @param name the name of the entity
+ * @return pointer to a predefined entity holding the expanded text
+ * @retval NULL if the DTD declares no such entity or its content is markup
+ */
+xmlEntityPtr CachedDtd::getEntity(const xmlChar *name) const
+{
+    return (xmlEntityPtr) xmlHashLookup(pEntities, name);
+}
+
+void CachedDtd::staticAddEntity(void *payload, void *data,
+        const xmlChar *name)
+{
+    ((CachedDtd *) data)->addEntity((xmlEntityPtr) payload);
+}
+
+void CachedDtd::addEntity(xmlEntityPtr entity)
+{
+    if (entity->etype != XML_INTERNAL_GENERAL_ENTITY || entity->content == NULL)
+        return;
+
+    std::string text;
+    if (!expand(entity->content, text, 0))
+    {
+        LOG4CXX_DEBUG(xmlDtdCacheLog,
+                "Entity '" << entity->name << "' is not plain text");
+        return;
+    }
+
+    xmlEntityPtr copy = (xmlEntityPtr) calloc(1, sizeof(xmlEntity));
+    if (copy == NULL)
+        return;
+    copy->type = XML_ENTITY_DECL;
+    copy->name = xmlStrdup(entity->name);
+    copy->content = xmlStrndup(BAD_CAST text.data(), text.size());
+    copy->orig = copy->content;
+    copy->length = text.size();
+    copy->etype = XML_INTERNAL_PREDEFINED_ENTITY;
+
+    if (xmlHashAddEntry(pEntities, copy->name, copy) != 0)
+        freeEntity(copy, NULL);
+}
+
+/**
+ * Expand the references in the content of an entity
+ *
+ * @param content the content as stored by libxml2, with character
+ * references of the declaration already replaced
+ * @param text the expanded text is appended to this string
+ * @param depth number of entities being expanded
+ * @return false if the content holds markup or an unknown reference
+ */
+bool CachedDtd::expand(const xmlChar *content, std::string &text,
+        int depth) const
+{
+    if (depth > MAX_ENTITY_DEPTH)
+        return false;
+
+    const char *p = (const char *) content;
+    while (*p != '\0')
+    {
+        if (*p == '<')
+            return false;
+
+        if (*p != '&')
+        {
+            text += *p++;
+            continue;
+        }
+
+        const char *end = strchr(p, ';');
+        if (end == NULL || end == p + 1)
+            return false;
+
+        if (p[1] == '#')
+        {
+            char *last = NULL;
+            long value = (p[2] == 'x') ?
+                    strtol(p + 3, &last, 16) : strtol(p + 2, &last, 10);
+            xmlChar utf8[8];
+            if (last != end || value <= 0 || value > 0x10FFFF)
+                return false;
+            text.append((const char *) utf8,
+                    xmlCopyCharMultiByte(utf8, (int) value));
+        }
+        else
+        {
+            xmlChar *name = xmlStrndup(BAD_CAST p + 1, end - p - 1);
+            xmlEntityPtr entity = xmlGetPredefinedEntity(name);
+            if (entity == NULL && pDtd->entities != NULL)
+                entity = (xmlEntityPtr) xmlHashLookup(
+                        (xmlHashTablePtr) pDtd->entities, name);
+            xmlFree(name);
+
+            if (entity == NULL || entity->content == NULL)
+                return false;
+            if (entity->etype == XML_INTERNAL_PREDEFINED_ENTITY)
+                text += (const char *) entity->content;
+            else if (entity->etype != XML_INTERNAL_GENERAL_ENTITY
+                    || !expand(entity->content, text, depth + 1))
+                return false;
+        }
+
+        p = end + 1;
+    }
+
+    return true;
+}
+
+DtdCache::DtdCache() :
+        dtdMutex()
+{
+    pthread_mutex_init(&dtdMutex, NULL);
+}
+
+DtdCache::~DtdCache()
+{
+    std::map<std::string, CachedDtd*>::iterator it;
+    for (it = dtds.begin(); it != dtds.end(); ++it)
+        delete (*it).second;
+    dtds.clear();
+
+#ifdef LIBXML_CATALOG_ENABLED
+    for (size_t i = 0; i < catalogs.size(); i++)
+        xmlFreeCatalog(catalogs[i]);
+#endif
+
+    pthread_mutex_destroy(&dtdMutex);
+}
+
+/**
+ * Use a local DTD for a public identifier
+ *
+ * @param publicId the public identifier of the DOCTYPE
+ * @param uri path or file: url of the DTD
+ */
+void DtdCache::addEntry(const std::string &publicId, const std::string &uri)
+{
+    pthread_mutex_lock(&dtdMutex);
+    entries[publicId] = uri;
+    forgetUnresolved();
+    pthread_mutex_unlock(&dtdMutex);
+}
+
+/**
+ * Resolve identifiers with an XML catalog
+ *
+ * @param file path of the catalog
+ * @return false if the catalog can not be read
+ */
+bool DtdCache::addCatalog(const std::string &file)
+{
+    if (access(file.c_str(), R_OK) != 0)
+    {
+        LOG4CXX_ERROR(xmlDtdCacheLog, "Can not read catalog " << file);
+        return false;
+    }
+
+#ifdef LIBXML_CATALOG_ENABLED
+    xmlCatalogPtr catalog = xmlLoadACatalog(file.c_str());
+    if (catalog == NULL)
+    {
+        LOG4CXX_ERROR(xmlDtdCacheLog, "Failed to load catalog " << file);
+        return false;
+    }
+
+    pthread_mutex_lock(&dtdMutex);
+    catalogs.push_back(catalog);
+    forgetUnresolved();
+    pthread_mutex_unlock(&dtdMutex);
+    return true;
+#else
+    LOG4CXX_ERROR(xmlDtdCacheLog,
+            "libxml2 is built without catalogs, can not use " << file);
+    return false;
+#endif
+}
+
+/**
+ * Get the parsed DTD of a DOCTYPE
+ *
+ * The DTD is parsed on the first request for the identifier and shared
+ * from then on.
+ *
+ * @param publicId the public identifier, may be NULL
+ * @param systemId the system identifier, may be NULL
+ * @return pointer to the DTD, owned by the cache
+ * @retval NULL if no local DTD is known for the identifiers or it could
+ * not be parsed
+ */
+const CachedDtd *DtdCache::get(const xmlChar *publicId,
+        const xmlChar *systemId)
+{
+    if (publicId == NULL && systemId == NULL)
+        return NULL;
+
+    std::string key((const char *) (publicId != NULL ? publicId : systemId));
+
+    pthread_mutex_lock(&dtdMutex);
+
+    std::map<std::string, CachedDtd*>::iterator it = dtds.find(key);
+    if (it != dtds.end())
+    {
+        pthread_mutex_unlock(&dtdMutex);
+        return (*it).second;
+    }
+
+    // Make room by forgetting a DTD that was not found, parsed DTDs may
+    // be in use by other readers
+    if (dtds.size() >= MAX_CACHED_DTDS)
+    {
+        for (it = dtds.begin(); it != dtds.end(); ++it)
+        {
+            if ((*it).second == NULL)
+            {
+                dtds.erase(it);
+                break;
+            }
+        }
+
+        if (dtds.size() >= MAX_CACHED_DTDS)
+        {
+            pthread_mutex_unlock(&dtdMutex);
+            LOG4CXX_WARN(xmlDtdCacheLog,
+                    "DTD cache is full, not loading '" << key << "'");
+            return NULL;
+        }
+    }
+
+    CachedDtd *cachedDtd = NULL;
+    std::string uri = resolve(publicId, systemId);
+    if (uri.empty())
+    {
+        LOG4CXX_DEBUG(xmlDtdCacheLog, "No local DTD for '" << key << "'");
+    }
+    else
+    {
+        LOG4CXX_INFO(xmlDtdCacheLog, "Loading DTD '" << key << "' from " << uri);
+        xmlDtdPtr dtd = load(uri, publicId, systemId);
+        if (dtd != NULL)
+            cachedDtd = new CachedDtd(dtd);
+    }
+
+    dtds[key] = cachedDtd;
+    pthread_mutex_unlock(&dtdMutex);
+
+    return cachedDtd;
+}
+
+/**
+ * Find the local DTD of a DOCTYPE
+ *
+ * @return path or file: url of the DTD
+ * @retval "" if there is no local DTD
+ */
+std::string DtdCache::resolve(const xmlChar *publicId,
+        const xmlChar *systemId)
+{
+    std::string uri;
+
+    if (publicId != NULL)
+    {
+        std::map<std::string, std::string>::iterator it = entries.find(
+                (const char *) publicId);
+        if (it != entries.end())
+            uri = (*it).second;
+    }
+
+#ifdef LIBXML_CATALOG_ENABLED
+    if (uri.empty())
+    {
+        xmlChar *resolved = NULL;
+        for (size_t i = 0; i < catalogs.size() && resolved == NULL; i++)
+            resolved = xmlACatalogResolve(catalogs[i], publicId, systemId);
+        if (resolved == NULL)
+            resolved = xmlCatalogResolve(publicId, systemId);
+        if (resolved != NULL)
+        {
+            uri = (const char *) resolved;
+            xmlFree(resolved);
+        }
+    }
+#endif
+
+    // Only local files, remote DTDs would be fetched for every process
+    if (uri.find("://") != std::string::npos && uri.compare(0, 5, "file:") != 0)
+    {
+        LOG4CXX_WARN(xmlDtdCacheLog, "Not loading remote DTD " << uri);
+        uri.clear();
+    }
+
+    return uri;
+}
+
+/**
+ * Parse a DTD file
+ *
+ * Entities the DTD refers to are loaded too, but not from the network.
+ *
+ * @return pointer to the DTD, not attached to any document
+ * @retval NULL if the DTD could not be read or is not well-formed
+ */
+xmlDtdPtr DtdCache::load(const std::string &uri, const xmlChar *publicId,
+        const xmlChar *systemId)
+{
+    xmlParserCtxtPtr ctxt = xmlNewParserCtxt();
+    if (ctxt == NULL)
+        return NULL;
+
+    xmlCtxtUseOptions(ctxt, XML_PARSE_NONET | XML_PARSE_DTDLOAD);
+    ctxt->sax->serror = dtdErrorHandler;
+
+    xmlParserInputPtr input = xmlNewInputFromFile(ctxt, uri.c_str());
+    if (input == NULL)
+    {
+        LOG4CXX_ERROR(xmlDtdCacheLog, "Can not read DTD " << uri);
+        xmlFreeParserCtxt(ctxt);
+        return NULL;
+    }
+    xmlPushInput(ctxt, input);
+
+    // Parse the file as the external subset of an empty document
+    ctxt->inSubset = 2;
+    ctxt->myDoc = xmlNewDoc(BAD_CAST "1.0");
+    ctxt->myDoc->extSubset = xmlNewDtd(ctxt->myDoc, BAD_CAST "none",
+            publicId, systemId);
+    xmlParseExternalSubset(ctxt, publicId, systemId);
+
+    xmlDtdPtr dtd = NULL;
+    if (ctxt->wellFormed)
+    {
+        dtd = ctxt->myDoc->extSubset;
+        ctxt->myDoc->extSubset = NULL;
+        dtd->doc = NULL;
+        for (xmlNodePtr node = dtd->children; node != NULL; node = node->next)
+            node->doc = NULL;
+    }
+    else
+    {
+        LOG4CXX_ERROR(xmlDtdCacheLog, "DTD " << uri << " is not well-formed");
+    }
+
+    xmlFreeDoc(ctxt->myDoc);
+    ctxt->myDoc = NULL;
+    xmlFreeParserCtxt(ctxt);
+
+    return dtd;
+}
+
+/**
+ * Forget the identifiers that had no local DTD, new entries may have one
+ */
+void DtdCache::forgetUnresolved()
+{
+    std::map<std::string, CachedDtd*>::iterator it = dtds.begin();
+    while (it != dtds.end())
+    {
+        if ((*it).second == NULL)
+            dtds.erase(it++);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DTDCACHE_H
+#define DTDCACHE_H
+
+#include <pthread.h>
+#include <string>
+#include <map>
+#include <vector>
+
+#include <libxml/tree.h>
+#include <libxml/hash.h>
+#include <libxml/entities.h>
+#include <libxml/catalog.h>
+
+// DTDs kept, a DTD is parsed once and kept until the cache is destroyed
+#define MAX_CACHED_DTDS 32
+
+//
+// A DTD parsed once and shared by all readers. The entities it declares
+// that expand to plain text are kept as predefined entities, which libxml2
+// substitutes without parsing their content again.
+//
+
+class CachedDtd
+{
+public:
+    CachedDtd(xmlDtdPtr dtd);
+    ~CachedDtd();
+
+    xmlDtdPtr getDtd() const;
+    xmlEntityPtr getEntity(const xmlChar *name) const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    CachedDtd(const CachedDtd&);
+    CachedDtd& operator=(const CachedDtd&);
+
+    static void staticAddEntity(void *payload, void *data, const xmlChar *name);
+    void addEntity(xmlEntityPtr entity);
+    bool expand(const xmlChar *content, std::string &text, int depth) const;
+
+    xmlDtdPtr pDtd;
+    xmlHashTablePtr pEntities;
+};
+
+//
+// This class maps the public identifiers of DOCTYPEs to local DTD files
+// and keeps the parsed DTDs. Identifiers are looked up in the entries
+// added with addEntry(), then in the catalogs added with addCatalog() and
+// last in the catalogs of the system. DTDs are never fetched from the
+// network.
+//
+
+class DtdCache
+{
+public:
+    DtdCache();
+    ~DtdCache();
+
+    void addEntry(const std::string &publicId, const std::string &uri);
+    bool addCatalog(const std::string &file);
+
+    const CachedDtd *get(const xmlChar *publicId, const xmlChar *systemId);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    DtdCache(const DtdCache&);
+    DtdCache& operator=(const DtdCache&);
+
+    std::string resolve(const xmlChar *publicId, const xmlChar *systemId);
+    static xmlDtdPtr load(const std::string &uri, const xmlChar *publicId,
+            const xmlChar *systemId);
+    void forgetUnresolved();
+
+    // Local DTDs of public identifiers
+    std::map<std::string, std::string> entries;
+
+#ifdef LIBXML_CATALOG_ENABLED
+    // Catalogs added with addCatalog(), in order
+    std::vector<xmlCatalogPtr> catalogs;
+#endif
+
+    // Parsed DTDs by identifier, NULL for DTDs that could not be loaded
+    std::map<std::string, CachedDtd*> dtds;
+
+    pthread_mutex_t dtdMutex;
+};
+
+#endif
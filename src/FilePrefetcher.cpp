@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "FilePrefetcher.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlFilePrefetcherLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.fileprefetcher"));
+
+FilePrefetcher::FilePrefetcher() :
+        mBytes(0), queueMutex(), queueCond(), loadedCond(), bStopping(false)
+{
+    pthread_mutex_init(&queueMutex, NULL);
+    pthread_cond_init(&queueCond, NULL);
+    pthread_cond_init(&loadedCond, NULL);
+}
+
+FilePrefetcher::~FilePrefetcher()
+{
+    pthread_mutex_lock(&queueMutex);
+    bStopping = true;
+    pthread_cond_broadcast(&queueCond);
+    pthread_mutex_unlock(&queueMutex);
+
+    for (size_t i = 0; i < threads.size(); i++)
+        pthread_join(threads[i], NULL);
+
+    std::map<std::string, PrefetchedFile*>::iterator it;
+    for (it = files.begin(); it != files.end(); it++)
+        delete (*it).second;
+
+    pthread_cond_destroy(&loadedCond);
+    pthread_cond_destroy(&queueCond);
+    pthread_mutex_destroy(&queueMutex);
+}
+
+/**
+ * Start loading a batch of files
+ *
+ * Files of an earlier batch that were loaded but not taken are dropped.
+ * Files that do not fit in the budget are left to be read by their stream.
+ *
+ * @param batch paths of the files, as they will be passed to take()
+ */
+void FilePrefetcher::prefetch(const std::vector<std::string> &batch)
+{
+    pthread_mutex_lock(&queueMutex);
+    dropLoaded();
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        if (files.find(batch[i]) != files.end())
+            continue;
+        files.insert(
+                std::pair<std::string, PrefetchedFile*>(batch[i], NULL));
+        paths.push(batch[i]);
+    }
+
+    while (threads.size() < PREFETCH_THREADS && threads.size() < paths.size())
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, staticRun, this) != 0)
+        {
+            LOG4CXX_ERROR(xmlFilePrefetcherLog, "Failed to start prefetch thread");
+            break;
+        }
+        threads.push_back(thread);
+    }
+
+    // Without a thread the files are read by their streams as usual
+    if (threads.empty())
+    {
+        while (!paths.empty())
+        {
+            files.erase(paths.front());
+            paths.pop();
+        }
+    }
+
+    pthread_cond_broadcast(&queueCond);
+    pthread_mutex_unlock(&queueMutex);
+}
+
+/**
+ * Take the contents of a prefetched file
+ *
+ * Waits if the file is queued or being read.
+ *
+ * @param path path of the file
+ * @return pointer to the contents, which the caller takes over
+ * @retval NULL if the file was not prefetched or could not be read
+ */
+PrefetchedFile *FilePrefetcher::take(const std::string &path)
+{
+    PrefetchedFile *file = NULL;
+
+    pthread_mutex_lock(&queueMutex);
+    std::map<std::string, PrefetchedFile*>::iterator it = files.find(path);
+    while (it != files.end() && (*it).second == NULL)
+    {
+        pthread_cond_wait(&loadedCond, &queueMutex);
+        it = files.find(path);
+    }
+
+    if (it != files.end())
+    {
+        file = (*it).second;
+        mBytes -= file->size;
+        files.erase(it);
+    }
+    pthread_mutex_unlock(&queueMutex);
+
+    return file;
+}
+
+/**
+ * Drop files that were loaded but not taken, the queue mutex must be held
+ */
+void FilePrefetcher::dropLoaded()
+{
+    std::map<std::string, PrefetchedFile*>::iterator it = files.begin();
+    while (it != files.end())
+    {
+        if ((*it).second == NULL)
+        {
+            it++;
+            continue;
+        }
+        mBytes -= (*it).second->size;
+        delete (*it).second;
+        files.erase(it++);
+    }
+}
+
+void *FilePrefetcher::staticRun(void *prefetcher)
+{
+    ((FilePrefetcher*) prefetcher)->run();
+    return NULL;
+}
+
+void FilePrefetcher::run()
+{
+    pthread_mutex_lock(&queueMutex);
+    for (;;)
+    {
+        while (paths.empty() && !bStopping)
+            pthread_cond_wait(&queueCond, &queueMutex);
+        if (bStopping)
+            break;
+
+        std::string path = paths.front();
+        paths.pop();
+        pthread_mutex_unlock(&queueMutex);
+
+        PrefetchedFile *file = load(path);
+
+        pthread_mutex_lock(&queueMutex);
+        std::map<std::string, PrefetchedFile*>::iterator it = files.find(path);
+        if (file != NULL && it != files.end())
+            (*it).second = file;
+        else
+        {
+            if (file != NULL)
+            {
+                mBytes -= file->size;
+                delete file;
+            }
+            if (it != files.end())
+                files.erase(it);
+        }
+        pthread_cond_broadcast(&loadedCond);
+    }
+    pthread_mutex_unlock(&queueMutex);
+}
+
+/**
+ * Read a whole file
+ *
+ * @return pointer to the contents
+ * @retval NULL if the file could not be read or does not fit in the budget
+ */
+PrefetchedFile *FilePrefetcher::load(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Reserve the bytes before reading them
+    size_t size = st.st_size;
+    pthread_mutex_lock(&queueMutex);
+    bool fits = mBytes + size <= PREFETCH_BUDGET;
+    if (fits)
+        mBytes += size;
+    pthread_mutex_unlock(&queueMutex);
+    if (!fits)
+    {
+        LOG4CXX_DEBUG(xmlFilePrefetcherLog,
+                "Not prefetching " << path << ", " << size << " bytes do not fit");
+        close(fd);
+        return NULL;
+    }
+
+    PrefetchedFile *file = new PrefetchedFile;
+    file->size = size;
+    file->mtime = st.st_mtime;
+    file->inode = st.st_ino;
+    file->data = (char *) malloc(size > 0 ? size : 1);
+
+    size_t done = 0;
+    while (file->data != NULL && done < size)
+    {
+        ssize_t bytes = read(fd, file->data + done, size - done);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            break;
+        done += bytes;
+    }
+    close(fd);
+
+    if (done != size)
+    {
+        LOG4CXX_DEBUG(xmlFilePrefetcherLog, "Failed to prefetch " << path);
+        pthread_mutex_lock(&queueMutex);
+        mBytes -= size;
+        pthread_mutex_unlock(&queueMutex);
+        delete file;
+        return NULL;
+    }
+
+    LOG4CXX_DEBUG(xmlFilePrefetcherLog, "Prefetched " << size << " bytes of " << path);
+    return file;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILEPREFETCHER_H
+#define FILEPREFETCHER_H
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <queue>
+#include <map>
+
+// Number of threads loading files and bytes they may keep loaded
+#define PREFETCH_THREADS 4
+#define PREFETCH_BUDGET 8388608
+
+/**
+ * Contents of a local file read ahead of its FileStream
+ *
+ * The size, modification time and inode are those of the file when it was
+ * read, the stream compares them with the file before using the data.
+ */
+struct PrefetchedFile
+{
+    char *data; /**< contents of the file */
+    size_t size; /**< number of bytes in data */
+    time_t mtime; /**< modification time of the file */
+    ino_t inode; /**< inode of the file */
+
+    PrefetchedFile() :
+            data(0), size(0), mtime(0), inode(0)
+    {
+    }
+    ~PrefetchedFile()
+    {
+        free(data);
+    }
+
+private:
+    PrefetchedFile(const PrefetchedFile&);
+    PrefetchedFile& operator=(const PrefetchedFile&);
+};
+
+//
+// This class reads a batch of local files on a few worker threads, so that
+// the opens and reads of all the files of a book are in flight at once
+// instead of one after another as they are parsed.
+//
+
+class FilePrefetcher
+{
+public:
+    FilePrefetcher();
+    ~FilePrefetcher();
+
+    void prefetch(const std::vector<std::string> &paths);
+    PrefetchedFile *take(const std::string &path);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    FilePrefetcher(const FilePrefetcher&);
+    FilePrefetcher& operator=(const FilePrefetcher&);
+
+    static void *staticRun(void *prefetcher);
+    void run();
+    PrefetchedFile *load(const std::string &path);
+    void dropLoaded();
+
+    // Queued and loaded files, the value is NULL until the file is loaded
+    std::map<std::string, PrefetchedFile*> files;
+    std::queue<std::string> paths;
+    unsigned long mBytes;
+
+    pthread_mutex_t queueMutex;
+    pthread_cond_t queueCond;
+    pthread_cond_t loadedCond;
+    std::vector<pthread_t> threads;
+    bool bStopping;
+};
+
+#endif
@@ -30,20 +30,30 @@
 log4cxx::LoggerPtr xmlFileStreamLog(
         log4cxx::Logger::getLogger("kolibre.xmlreader.filestream"));
 
-FileStream::FileStream(const std::string filename, CacheObject *co) :
-        cacheObject(0), fTotalBytesRead(0), fSize(0), fp(0)
+FileStream::FileStream(const std::string filename, CacheObject *co,
+        PrefetchedFile *pf) :
+        cacheReader(0), prefetched(pf), fTotalBytesRead(0), fSize(0), fp(0), zStream(
+                0), zInput(0), bInflateEnded(false)
 {
     sFilename = filename;
     LOG4CXX_DEBUG(xmlFileStreamLog, "constructor for " << sFilename);
 
     if (co != NULL)
     {
-        cacheObject = co;
+        cacheReader = new CacheReader(co);
         mode = CACHED;
         bIsOpen = true;
         return;
     }
 
+    // The contents are used once openStream has checked the file
+    if (prefetched != NULL)
+    {
+        mode = PREFETCHED;
+        bIsOpen = false;
+        return;
+    }
+
     // If we do not have a cached object open the file
     mode = READ;
     bIsOpen = false;
@@ -153,10 +163,20 @@ FileStream::~FileStream()
             fclose(fp);
         break;
     case CACHED:
-        if (cacheObject != NULL)
-            cacheObject->resetState();
+        if (cacheReader != NULL)
+            delete cacheReader;
+        break;
+    case PREFETCHED:
         break;
     }
+    delete prefetched;
+
+    if (zStream != NULL)
+    {
+        inflateEnd(zStream);
+        delete zStream;
+    }
+    delete[] zInput;
 }
 
 void FileStream::useCache(bool setting)
@@ -178,6 +198,33 @@ bool FileStream::openStream()
     // Get the file size
     fSize = stat_p.st_size;
 
+    // Use the prefetched contents unless the file has changed since
+    if (mode == PREFETCHED)
+    {
+        if (prefetched->size == fSize && prefetched->mtime == stat_p.st_mtime
+                && prefetched->inode == stat_p.st_ino)
+        {
+            // Compressed contents are inflated from memory
+            if (fSize >= 2 && (unsigned char) prefetched->data[0] == 0x1f
+                    && (unsigned char) prefetched->data[1] == 0x8b)
+            {
+                if (!startInflate())
+                    return false;
+                zStream->next_in = (Bytef *) prefetched->data;
+                zStream->avail_in = fSize;
+            }
+
+            bIsOpen = true;
+            return bIsOpen;
+        }
+
+        LOG4CXX_DEBUG(xmlFileStreamLog,
+                "file changed since it was prefetched, reading it again");
+        delete prefetched;
+        prefetched = NULL;
+        mode = READ;
+    }
+
     // Open the file for reading
     fp = fopen(sFilename.c_str(), "r");
     if (fp == NULL)
@@ -187,10 +234,105 @@ bool FileStream::openStream()
         return false;
     }
 
+    // Check for the gzip magic number
+    unsigned char magic[2];
+    if (fread(magic, 1, 2, fp) == 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+    {
+        zInput = new char[Z_CHUNK_SIZE];
+        if (!startInflate())
+            return false;
+    }
+    rewind(fp);
+
     bIsOpen = true;
     return bIsOpen;
 }
 
+/**
+ * Set up inflating of a gzip compressed file
+ *
+ * @return true if zlib was initialized
+ */
+bool FileStream::startInflate()
+{
+    LOG4CXX_DEBUG(xmlFileStreamLog, sFilename << " is gzip compressed");
+
+    zStream = new z_stream;
+    memset(zStream, 0, sizeof(z_stream));
+
+    // Accept only the gzip format
+    if (inflateInit2(zStream, 16 + MAX_WBITS) != Z_OK)
+    {
+        delete zStream;
+        zStream = NULL;
+        mErrorMsg = "Failed to initialize zlib";
+        mErrorCode = UNKNOWN_ERROR;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Inflate bytes of a gzip compressed file
+ *
+ * Concatenated gzip members are inflated one after another, anything else
+ * after the last member is ignored like gzip does.
+ *
+ * @return number of bytes inflated, 0 at the end of the data and -1 on error
+ */
+int FileStream::inflateBytes(char* const toFill, const unsigned int maxToRead)
+{
+    zStream->next_out = (Bytef *) toFill;
+    zStream->avail_out = maxToRead;
+
+    while (zStream->avail_out == maxToRead)
+    {
+        // Prefetched contents are all handed to zlib at once
+        if (zStream->avail_in == 0 && mode == READ)
+        {
+            size_t bytes = fread(zInput, 1, Z_CHUNK_SIZE, fp);
+            if (ferror(fp))
+            {
+                mErrorMsg = strerror(errno);
+                mErrorCode = READ_FAILED;
+                return -1;
+            }
+            zStream->next_in = (Bytef *) zInput;
+            zStream->avail_in = bytes;
+        }
+
+        if (zStream->avail_in == 0
+                || (bInflateEnded && zStream->next_in[0] != 0x1f))
+        {
+            if (bInflateEnded)
+                break;
+            mErrorMsg = "Unexpected end of gzip data";
+            mErrorCode = READ_FAILED;
+            return -1;
+        }
+
+        if (bInflateEnded)
+        {
+            inflateReset(zStream);
+            bInflateEnded = false;
+        }
+
+        int err = inflate(zStream, Z_NO_FLUSH);
+        if (err == Z_STREAM_END)
+            bInflateEnded = true;
+        else if (err != Z_OK)
+        {
+            mErrorMsg = "Corrupt gzip data";
+            mErrorCode = READ_FAILED;
+            LOG4CXX_ERROR(xmlFileStreamLog,
+                    "failed to inflate " << sFilename << ": " << (zStream->msg ? zStream->msg : ""));
+            return -1;
+        }
+    }
+
+    return maxToRead - zStream->avail_out;
+}
+
 int FileStream::readBytes(char* const toFill, const unsigned int maxToRead)
 {
     size_t fBytesRead = 0;
@@ -203,6 +345,16 @@ int FileStream::readBytes(char* const toFill, const unsigned int maxToRead)
             if (!openStream())
                 return -1;
 
+        if (zStream != NULL)
+        {
+            int bytes = inflateBytes(toFill, maxToRead);
+            if (bytes < 0)
+                return -1;
+            fBytesRead = bytes;
+            fTotalBytesRead += fBytesRead;
+            break;
+        }
+
         LOG4CXX_DEBUG(xmlFileStreamLog, "reading bytes");
         fBytesRead = fread((char *) toFill, 1, maxToRead, fp);
 
@@ -222,11 +374,72 @@ int FileStream::readBytes(char* const toFill, const unsigned int maxToRead)
 
         break;
     case CACHED:
-        fBytesRead = cacheObject->readBytes((char *) toFill, maxToRead);
+        fBytesRead = cacheReader->readBytes((char *) toFill, maxToRead);
         LOG4CXX_DEBUG(xmlFileStreamLog,
                 "read " << fBytesRead << " bytes from cacheObject");
         fTotalBytesRead += fBytesRead;
         break;
+    case PREFETCHED:
+        if (!bIsOpen)
+            if (!openStream())
+                return -1;
+
+        // openStream falls back to reading the file if it has changed
+        if (mode == READ)
+            return readBytes(toFill, maxToRead);
+
+        if (zStream != NULL)
+        {
+            int bytes = inflateBytes(toFill, maxToRead);
+            if (bytes < 0)
+                return -1;
+            fBytesRead = bytes;
+            fTotalBytesRead += fBytesRead;
+            break;
+        }
+
+        fBytesRead = fSize - fTotalBytesRead;
+        if (fBytesRead > maxToRead)
+            fBytesRead = maxToRead;
+        memcpy(toFill, prefetched->data + fTotalBytesRead, fBytesRead);
+        fTotalBytesRead += fBytesRead;
+        break;
     }
     return fBytesRead;
 }
+
+/**
+ * Skip bytes in the file
+ *
+ * A file on disk is seeked, a prefetched one is skipped in memory and a
+ * cached or compressed one is read and discarded.
+ *
+ * @param count number of bytes to skip
+ * @return boolean
+ * @retval true if the bytes were skipped
+ * @retval false if the file is shorter or could not be opened
+ */
+bool FileStream::skipBytes(unsigned long count)
+{
+    if (mode == CACHED)
+        return InputStream::skipBytes(count);
+
+    if (!bIsOpen)
+        if (!openStream())
+            return false;
+
+    // Compressed data has to be inflated to find the offset
+    if (zStream != NULL)
+        return InputStream::skipBytes(count);
+
+    if (fTotalBytesRead + count > fSize
+            || (mode == READ && fseek(fp, count, SEEK_CUR) != 0))
+    {
+        mErrorMsg = "Can not skip past the end of the file";
+        mErrorCode = READ_FAILED;
+        return false;
+    }
+
+    fTotalBytesRead += count;
+    return true;
+}
@@ -23,9 +23,12 @@
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
+#include <zlib.h>
 
 #include "InputStream.h"
 #include "CacheObject.h"
+#include "CacheReader.h"
+#include "FilePrefetcher.h"
 
 //
 // This class implements the BinInputStream interface specified by the XML
@@ -35,16 +38,18 @@
 class FileStream: public InputStream
 {
 public:
-    FileStream(const std::string filename, CacheObject *co = NULL);
+    FileStream(const std::string filename, CacheObject *co = NULL,
+            PrefetchedFile *pf = NULL);
     ~FileStream();
 
     unsigned int curPos() const;
     int readBytes(char* const toFill, const unsigned int maxToRead);
+    bool skipBytes(unsigned long count);
 
     void useCache(bool);
     enum ParseMode
     {
-        READ, CACHED
+        READ, CACHED, PREFETCHED
     };
 
 private:
@@ -59,9 +64,14 @@ private:
 
     bool openStream();
 
+    // gzip compressed files are inflated while they are read
+    bool startInflate();
+    int inflateBytes(char* const toFill, const unsigned int maxToRead);
+
     ParseMode mode;
 
-    CacheObject *cacheObject;
+    CacheReader *cacheReader;
+    PrefetchedFile *prefetched;
 
     std::string sFilename;
 
@@ -69,6 +79,10 @@ private:
     size_t fSize;
     FILE *fp;
 
+    z_stream *zStream;
+    char *zInput;
+    bool bInflateEnded;
+
     bool bUseCache;
     bool bIsOpen;
 };
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
+#include "FileWatcher.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlFileWatcherLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.filewatcher"));
+
+#ifdef HAVE_SYS_INOTIFY_H
+// Changes to the contents or the identity of a file
+#define WATCH_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVE_SELF \
+        | IN_DELETE_SELF)
+#endif
+
+FileWatcher::FileWatcher() :
+        fd(-1)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        LOG4CXX_WARN(xmlFileWatcherLog,
+                "Failed to initialize inotify: " << strerror(errno));
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (fd >= 0)
+        close(fd);
+}
+
+/**
+ * Check if files can be watched
+ */
+bool FileWatcher::isOpen() const
+{
+    return fd >= 0;
+}
+
+/**
+ * Watch the file of an url
+ *
+ * @param url the url, as reported by readChanges()
+ * @param path the local file holding the resource
+ * @return true if the file is watched
+ */
+bool FileWatcher::watch(const std::string &url, const std::string &path)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+    if (fd < 0)
+        return false;
+
+    unwatch(url);
+
+    int wd = inotify_add_watch(fd, path.c_str(), WATCH_MASK);
+    if (wd < 0)
+    {
+        LOG4CXX_DEBUG(xmlFileWatcherLog,
+                "Failed to watch " << path << ": " << strerror(errno));
+        return false;
+    }
+
+    watches[url] = wd;
+    urls.insert(std::pair<int, std::string>(wd, url));
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Stop watching the file of an url
+ */
+void FileWatcher::unwatch(const std::string &url)
+{
+    std::map<std::string, int>::iterator it = watches.find(url);
+    if (it == watches.end())
+        return;
+
+    int wd = (*it).second;
+    watches.erase(it);
+
+    std::multimap<int, std::string>::iterator u = urls.lower_bound(wd);
+    while (u != urls.end() && (*u).first == wd)
+    {
+        if ((*u).second == url)
+            urls.erase(u++);
+        else
+            u++;
+    }
+
+#ifdef HAVE_SYS_INOTIFY_H
+    // The watch is shared by all urls of the same file
+    if (urls.find(wd) == urls.end())
+        inotify_rm_watch(fd, wd);
+#endif
+}
+
+/**
+ * Check if the file of an url is watched
+ */
+bool FileWatcher::isWatched(const std::string &url) const
+{
+    return watches.find(url) != watches.end();
+}
+
+/**
+ * Collect the urls whose files changed since the last call
+ *
+ * The urls are no longer watched afterwards. Does not block.
+ *
+ * @param changed urls of the changed files are appended here
+ * @return boolean
+ * @retval true if all changes were seen
+ * @retval false if the kernel dropped events, any watched file may have
+ * changed
+ */
+bool FileWatcher::readChanges(std::vector<std::string> &changed)
+{
+    bool complete = true;
+
+#ifdef HAVE_SYS_INOTIFY_H
+    if (fd < 0)
+        return true;
+
+    char buffer[4096]
+            __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    for (;;)
+    {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char *p = buffer; p < buffer + length;)
+        {
+            struct inotify_event *event = (struct inotify_event *) p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                complete = false;
+                continue;
+            }
+
+            std::multimap<int, std::string>::iterator u = urls.lower_bound(
+                    event->wd);
+            while (u != urls.end() && (*u).first == event->wd)
+            {
+                changed.push_back((*u).second);
+                watches.erase((*u).second);
+                urls.erase(u++);
+            }
+
+            if ((event->mask & IN_IGNORED) == 0)
+                inotify_rm_watch(fd, event->wd);
+        }
+    }
+#endif
+
+    return complete;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+//
+// This class watches local files with inotify so that cache entries of
+// files that change can be dropped before they are used. Events are read
+// without blocking whenever the cache is used. Where inotify is not
+// available isOpen() returns false.
+//
+
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    bool isOpen() const;
+
+    bool watch(const std::string &url, const std::string &path);
+    void unwatch(const std::string &url);
+    bool isWatched(const std::string &url) const;
+
+    bool readChanges(std::vector<std::string> &urls);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    FileWatcher(const FileWatcher&);
+    FileWatcher& operator=(const FileWatcher&);
+
+    int fd;
+
+    // Watch descriptor of every url, several urls may share a file
+    std::map<std::string, int> watches;
+    std::multimap<int, std::string> urls;
+};
+
+#endif
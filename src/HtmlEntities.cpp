@@ -0,0 +1,2388 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generated by gen_htmlentities.py, do not edit
+
+#include <pthread.h>
+#include <string.h>
+
+#include "HtmlEntities.h"
+
+#define HTML_ENTITY_COUNT 2125
+
+struct HtmlEntityValue
+{
+    const char *name;
+    const char *value;
+    int length;
+};
+
+static const HtmlEntityValue htmlEntityValues[HTML_ENTITY_COUNT] =
+{
+    { "lne", "\342\252\207", 3 },
+    { "pscr", "\360\235\223\205", 4 },
+    { "thetav", "\317\221", 2 },
+    { "ltrie", "\342\212\264", 3 },
+    { "RightUpDownVector", "\342\245\217", 3 },
+    { "Uarrocir", "\342\245\211", 3 },
+    { "lat", "\342\252\253", 3 },
+    { "vsupne", "\342\212\213\357\270\200", 6 },
+    { "upsilon", "\317\205", 2 },
+    { "csupe", "\342\253\222", 3 },
+    { "squ", "\342\226\241", 3 },
+    { "OverParenthesis", "\342\217\234", 3 },
+    { "sce", "\342\252\260", 3 },
+    { "sfr", "\360\235\224\260", 4 },
+    { "psi", "\317\210", 2 },
+    { "Longleftarrow", "\342\237\270", 3 },
+    { "oelig", "\305\223", 2 },
+    { "mp", "\342\210\223", 3 },
+    { "puncsp", "\342\200\210", 3 },
+    { "Eacute", "\303\211", 2 },
+    { "wedbar", "\342\251\237", 3 },
+    { "darr", "\342\206\223", 3 },
+    { "upuparrows", "\342\207\210", 3 },
+    { "diam", "\342\213\204", 3 },
+    { "qfr", "\360\235\224\256", 4 },
+    { "gnE", "\342\211\251", 3 },
+    { "dsol", "\342\247\266", 3 },
+    { "nvinfin", "\342\247\236", 3 },
+    { "wopf", "\360\235\225\250", 4 },
+    { "lesges", "\342\252\223", 3 },
+    { "dd", "\342\205\206", 3 },
+    { "rAtail", "\342\244\234", 3 },
+    { "kcy", "\320\272", 2 },
+    { "frac16", "\342\205\231", 3 },
+    { "lopar", "\342\246\205", 3 },
+    { "simdot", "\342\251\252", 3 },
+    { "gnsim", "\342\213\247", 3 },
+    { "rang", "\342\237\251", 3 },
+    { "RightArrowLeftArrow", "\342\207\204", 3 },
+    { "DoubleContourIntegral", "\342\210\257", 3 },
+    { "mfr", "\360\235\224\252", 4 },
+    { "qint", "\342\250\214", 3 },
+    { "cirmid", "\342\253\257", 3 },
+    { "odblac", "\305\221", 2 },
+    { "subsup", "\342\253\223", 3 },
+    { "sqsupe", "\342\212\222", 3 },
+    { "hstrok", "\304\247", 2 },
+    { "maltese", "\342\234\240", 3 },
+    { "bumpe", "\342\211\217", 3 },
+    { "VerticalSeparator", "\342\235\230", 3 },
+    { "CircleDot", "\342\212\231", 3 },
+    { "phone", "\342\230\216", 3 },
+    { "blank", "\342\220\243", 3 },
+    { "LeftRightArrow", "\342\206\224", 3 },
+    { "UpTee", "\342\212\245", 3 },
+    { "frac12", "\302\275", 2 },
+    { "COPY", "\302\251", 2 },
+    { "square", "\342\226\241", 3 },
+    { "elinters", "\342\217\247", 3 },
+    { "rarrfs", "\342\244\236", 3 },
+    { "hcirc", "\304\245", 2 },
+    { "csup", "\342\253\220", 3 },
+    { "lagran", "\342\204\222", 3 },
+    { "Xscr", "\360\235\222\263", 4 },
+    { "nsub", "\342\212\204", 3 },
+    { "njcy", "\321\232", 2 },
+    { "Uring", "\305\256", 2 },
+    { "rarrap", "\342\245\265", 3 },
+    { "npart", "\342\210\202\314\270", 5 },
+    { "latail", "\342\244\231", 3 },
+    { "timesb", "\342\212\240", 3 },
+    { "nsupseteq", "\342\212\211", 3 },
+    { "NotGreater", "\342\211\257", 3 },
+    { "iuml", "\303\257", 2 },
+    { "SucceedsSlantEqual", "\342\211\275", 3 },
+    { "bigcap", "\342\213\202", 3 },
+    { "ffllig", "\357\254\204", 3 },
+    { "homtht", "\342\210\273", 3 },
+    { "vprop", "\342\210\235", 3 },
+    { "curlyeqsucc", "\342\213\237", 3 },
+    { "Amacr", "\304\200", 2 },
+    { "Dcaron", "\304\216", 2 },
+    { "ncedil", "\305\206", 2 },
+    { "Uogon", "\305\262", 2 },
+    { "DownTee", "\342\212\244", 3 },
+    { "frown", "\342\214\242", 3 },
+    { "malt", "\342\234\240", 3 },
+    { "ngt", "\342\211\257", 3 },
+    { "doublebarwedge", "\342\214\206", 3 },
+    { "div", "\303\267", 2 },
+    { "zopf", "\360\235\225\253", 4 },
+    { "risingdotseq", "\342\211\223", 3 },
+    { "gcy", "\320\263", 2 },
+    { "lfisht", "\342\245\274", 3 },
+    { "zwnj", "\342\200\214", 3 },
+    { "vBarv", "\342\253\251", 3 },
+    { "upharpoonright", "\342\206\276", 3 },
+    { "nvge", "\342\211\245\342\203\222", 6 },
+    { "gsiml", "\342\252\220", 3 },
+    { "quot", "\042", 1 },
+    { "infintie", "\342\247\235", 3 },
+    { "NotPrecedesSlantEqual", "\342\213\240", 3 },
+    { "sigmav", "\317\202", 2 },
+    { "imacr", "\304\253", 2 },
+    { "Sub", "\342\213\220", 3 },
+    { "ssetmn", "\342\210\226", 3 },
+    { "Zacute", "\305\271", 2 },
+    { "rightleftarrows", "\342\207\204", 3 },
+    { "rbrace", "\175", 1 },
+    { "acE", "\342\210\276\314\263", 5 },
+    { "prap", "\342\252\267", 3 },
+    { "bottom", "\342\212\245", 3 },
+    { "circlearrowleft", "\342\206\272", 3 },
+    { "UpTeeArrow", "\342\206\245", 3 },
+    { "DiacriticalGrave", "\140", 1 },
+    { "Uarr", "\342\206\237", 3 },
+    { "diamond", "\342\213\204", 3 },
+    { "flat", "\342\231\255", 3 },
+    { "lparlt", "\342\246\223", 3 },
+    { "ogon", "\313\233", 2 },
+    { "UpArrow", "\342\206\221", 3 },
+    { "checkmark", "\342\234\223", 3 },
+    { "NegativeVeryThinSpace", "\342\200\213", 3 },
+    { "block", "\342\226\210", 3 },
+    { "nu", "\316\275", 2 },
+    { "plusdo", "\342\210\224", 3 },
+    { "Sfr", "\360\235\224\226", 4 },
+    { "iprod", "\342\250\274", 3 },
+    { "cirfnint", "\342\250\220", 3 },
+    { "ShortLeftArrow", "\342\206\220", 3 },
+    { "cdot", "\304\213", 2 },
+    { "Ll", "\342\213\230", 3 },
+    { "nsmid", "\342\210\244", 3 },
+    { "varrho", "\317\261", 2 },
+    { "fllig", "\357\254\202", 3 },
+    { "backsim", "\342\210\275", 3 },
+    { "bcong", "\342\211\214", 3 },
+    { "gg", "\342\211\253", 3 },
+    { "topfork", "\342\253\232", 3 },
+    { "ldquor", "\342\200\236", 3 },
+    { "GreaterTilde", "\342\211\263", 3 },
+    { "parsl", "\342\253\275", 3 },
+    { "Jfr", "\360\235\224\215", 4 },
+    { "equals", "\075", 1 },
+    { "NotReverseElement", "\342\210\214", 3 },
+    { "rect", "\342\226\255", 3 },
+    { "jukcy", "\321\224", 2 },
+    { "wr", "\342\211\200", 3 },
+    { "trianglerighteq", "\342\212\265", 3 },
+    { "notin", "\342\210\211", 3 },
+    { "bigwedge", "\342\213\200", 3 },
+    { "wcirc", "\305\265", 2 },
+    { "LJcy", "\320\211", 2 },
+    { "digamma", "\317\235", 2 },
+    { "sqsub", "\342\212\217", 3 },
+    { "supdsub", "\342\253\230", 3 },
+    { "fork", "\342\213\224", 3 },
+    { "dollar", "\044", 1 },
+    { "rbrke", "\342\246\214", 3 },
+    { "backepsilon", "\317\266", 2 },
+    { "egsdot", "\342\252\230", 3 },
+    { "isinE", "\342\213\271", 3 },
+    { "triangleright", "\342\226\271", 3 },
+    { "Dopf", "\360\235\224\273", 4 },
+    { "thicksim", "\342\210\274", 3 },
+    { "nshortparallel", "\342\210\246", 3 },
+    { "lbrkslu", "\342\246\215", 3 },
+    { "vBar", "\342\253\250", 3 },
+    { "boxHD", "\342\225\246", 3 },
+    { "bdquo", "\342\200\236", 3 },
+    { "xhArr", "\342\237\272", 3 },
+    { "swnwar", "\342\244\252", 3 },
+    { "gnapprox", "\342\252\212", 3 },
+    { "YAcy", "\320\257", 2 },
+    { "hfr", "\360\235\224\245", 4 },
+    { "boxuL", "\342\225\233", 3 },
+    { "coloneq", "\342\211\224", 3 },
+    { "suplarr", "\342\245\273", 3 },
+    { "thetasym", "\317\221", 2 },
+    { "Sc", "\342\252\274", 3 },
+    { "nbumpe", "\342\211\217\314\270", 5 },
+    { "ntrianglelefteq", "\342\213\254", 3 },
+    { "boxVr", "\342\225\237", 3 },
+    { "mapstoleft", "\342\206\244", 3 },
+    { "mapstoup", "\342\206\245", 3 },
+    { "tridot", "\342\227\254", 3 },
+    { "rBarr", "\342\244\217", 3 },
+    { "thkap", "\342\211\210", 3 },
+    { "gtcc", "\342\252\247", 3 },
+    { "oast", "\342\212\233", 3 },
+    { "angmsdah", "\342\246\257", 3 },
+    { "circledS", "\342\223\210", 3 },
+    { "Scedil", "\305\236", 2 },
+    { "lstrok", "\305\202", 2 },
+    { "angmsdaa", "\342\246\250", 3 },
+    { "RightTee", "\342\212\242", 3 },
+    { "tcedil", "\305\243", 2 },
+    { "succeq", "\342\252\260", 3 },
+    { "NotHumpEqual", "\342\211\217\314\270", 5 },
+    { "sqsupseteq", "\342\212\222", 3 },
+    { "RightArrow", "\342\206\222", 3 },
+    { "nvlArr", "\342\244\202", 3 },
+    { "Conint", "\342\210\257", 3 },
+    { "oacute", "\303\263", 2 },
+    { "marker", "\342\226\256", 3 },
+    { "ntrianglerighteq", "\342\213\255", 3 },
+    { "lnsim", "\342\213\246", 3 },
+    { "boxhu", "\342\224\264", 3 },
+    { "comma", "\054", 1 },
+    { "Colon", "\342\210\267", 3 },
+    { "nlE", "\342\211\246\314\270", 5 },
+    { "InvisibleComma", "\342\201\243", 3 },
+    { "check", "\342\234\223", 3 },
+    { "smashp", "\342\250\263", 3 },
+    { "napE", "\342\251\260\314\270", 5 },
+    { "siml", "\342\252\235", 3 },
+    { "Emacr", "\304\222", 2 },
+    { "utdot", "\342\213\260", 3 },
+    { "NotSubset", "\342\212\202\342\203\222", 6 },
+    { "RightTriangleBar", "\342\247\220", 3 },
+    { "lbbrk", "\342\235\262", 3 },
+    { "Pcy", "\320\237", 2 },
+    { "gneqq", "\342\211\251", 3 },
+    { "RightCeiling", "\342\214\211", 3 },
+    { "succnsim", "\342\213\251", 3 },
+    { "boxv", "\342\224\202", 3 },
+    { "Acy", "\320\220", 2 },
+    { "bemptyv", "\342\246\260", 3 },
+    { "star", "\342\230\206", 3 },
+    { "auml", "\303\244", 2 },
+    { "drcrop", "\342\214\214", 3 },
+    { "ordm", "\302\272", 2 },
+    { "ZeroWidthSpace", "\342\200\213", 3 },
+    { "nvltrie", "\342\212\264\342\203\222", 6 },
+    { "mid", "\342\210\243", 3 },
+    { "tritime", "\342\250\273", 3 },
+    { "iinfin", "\342\247\234", 3 },
+    { "trianglelefteq", "\342\212\264", 3 },
+    { "rlarr", "\342\207\204", 3 },
+    { "ReverseElement", "\342\210\213", 3 },
+    { "scedil", "\305\237", 2 },
+    { "varsupsetneq", "\342\212\213\357\270\200", 6 },
+    { "uogon", "\305\263", 2 },
+    { "ubreve", "\305\255", 2 },
+    { "nwnear", "\342\244\247", 3 },
+    { "bsime", "\342\213\215", 3 },
+    { "szlig", "\303\237", 2 },
+    { "Zeta", "\316\226", 2 },
+    { "seArr", "\342\207\230", 3 },
+    { "nsucc", "\342\212\201", 3 },
+    { "le", "\342\211\244", 3 },
+    { "Rarr", "\342\206\240", 3 },
+    { "fcy", "\321\204", 2 },
+    { "langd", "\342\246\221", 3 },
+    { "Vfr", "\360\235\224\231", 4 },
+    { "cacute", "\304\207", 2 },
+    { "prE", "\342\252\263", 3 },
+    { "circledcirc", "\342\212\232", 3 },
+    { "because", "\342\210\265", 3 },
+    { "copysr", "\342\204\227", 3 },
+    { "lopf", "\360\235\225\235", 4 },
+    { "NotPrecedesEqual", "\342\252\257\314\270", 5 },
+    { "Tab", "\011", 1 },
+    { "AElig", "\303\206", 2 },
+    { "ngeq", "\342\211\261", 3 },
+    { "ngeqq", "\342\211\247\314\270", 5 },
+    { "harrcir", "\342\245\210", 3 },
+    { "clubsuit", "\342\231\243", 3 },
+    { "bnot", "\342\214\220", 3 },
+    { "ltri", "\342\227\203", 3 },
+    { "boxHU", "\342\225\251", 3 },
+    { "dotsquare", "\342\212\241", 3 },
+    { "NotEqual", "\342\211\240", 3 },
+    { "nbsp", "\302\240", 2 },
+    { "acy", "\320\260", 2 },
+    { "Subset", "\342\213\220", 3 },
+    { "capand", "\342\251\204", 3 },
+    { "NotExists", "\342\210\204", 3 },
+    { "Tfr", "\360\235\224\227", 4 },
+    { "gt", "\076", 1 },
+    { "supsetneqq", "\342\253\214", 3 },
+    { "sime", "\342\211\203", 3 },
+    { "late", "\342\252\255", 3 },
+    { "cir", "\342\227\213", 3 },
+    { "bbrktbrk", "\342\216\266", 3 },
+    { "triangleq", "\342\211\234", 3 },
+    { "parallel", "\342\210\245", 3 },
+    { "bkarow", "\342\244\215", 3 },
+    { "varsigma", "\317\202", 2 },
+    { "dfisht", "\342\245\277", 3 },
+    { "Epsilon", "\316\225", 2 },
+    { "CounterClockwiseContourIntegral", "\342\210\263", 3 },
+    { "Popf", "\342\204\231", 3 },
+    { "lharul", "\342\245\252", 3 },
+    { "ntilde", "\303\261", 2 },
+    { "delta", "\316\264", 2 },
+    { "rangle", "\342\237\251", 3 },
+    { "rnmid", "\342\253\256", 3 },
+    { "lvertneqq", "\342\211\250\357\270\200", 6 },
+    { "shortparallel", "\342\210\245", 3 },
+    { "omicron", "\316\277", 2 },
+    { "reg", "\302\256", 2 },
+    { "rmoust", "\342\216\261", 3 },
+    { "sqcups", "\342\212\224\357\270\200", 6 },
+    { "qopf", "\360\235\225\242", 4 },
+    { "verbar", "\174", 1 },
+    { "qscr", "\360\235\223\206", 4 },
+    { "Lscr", "\342\204\222", 3 },
+    { "bscr", "\360\235\222\267", 4 },
+    { "quatint", "\342\250\226", 3 },
+    { "simne", "\342\211\206", 3 },
+    { "Uopf", "\360\235\225\214", 4 },
+    { "swarhk", "\342\244\246", 3 },
+    { "ovbar", "\342\214\275", 3 },
+    { "bigtriangleup", "\342\226\263", 3 },
+    { "Sacute", "\305\232", 2 },
+    { "Cap", "\342\213\222", 3 },
+    { "lrcorner", "\342\214\237", 3 },
+    { "gtreqqless", "\342\252\214", 3 },
+    { "zfr", "\360\235\224\267", 4 },
+    { "hslash", "\342\204\217", 3 },
+    { "roarr", "\342\207\276", 3 },
+    { "yacy", "\321\217", 2 },
+    { "zdot", "\305\274", 2 },
+    { "boxdl", "\342\224\220", 3 },
+    { "olarr", "\342\206\272", 3 },
+    { "tfr", "\360\235\224\261", 4 },
+    { "Aogon", "\304\204", 2 },
+    { "sum", "\342\210\221", 3 },
+    { "Iuml", "\303\217", 2 },
+    { "Efr", "\360\235\224\210", 4 },
+    { "plusmn", "\302\261", 2 },
+    { "ncy", "\320\275", 2 },
+    { "DZcy", "\320\217", 2 },
+    { "SquareSuperset", "\342\212\220", 3 },
+    { "sup3", "\302\263", 2 },
+    { "Scy", "\320\241", 2 },
+    { "Kappa", "\316\232", 2 },
+    { "gtcir", "\342\251\272", 3 },
+    { "vartheta", "\317\221", 2 },
+    { "fjlig", "fj", 2 },
+    { "ccupssm", "\342\251\220", 3 },
+    { "xi", "\316\276", 2 },
+    { "ccirc", "\304\211", 2 },
+    { "supsup", "\342\253\226", 3 },
+    { "emptyv", "\342\210\205", 3 },
+    { "eqsim", "\342\211\202", 3 },
+    { "mlcp", "\342\253\233", 3 },
+    { "glj", "\342\252\244", 3 },
+    { "sext", "\342\234\266", 3 },
+    { "bnequiv", "\342\211\241\342\203\245", 6 },
+    { "Equilibrium", "\342\207\214", 3 },
+    { "gfr", "\360\235\224\244", 4 },
+    { "rightharpoondown", "\342\207\201", 3 },
+    { "subsub", "\342\253\225", 3 },
+    { "piv", "\317\226", 2 },
+    { "rightharpoonup", "\342\207\200", 3 },
+    { "Bernoullis", "\342\204\254", 3 },
+    { "vrtri", "\342\212\263", 3 },
+    { "notniva", "\342\210\214", 3 },
+    { "lbrack", "\133", 1 },
+    { "downharpoonright", "\342\207\202", 3 },
+    { "DDotrahd", "\342\244\221", 3 },
+    { "UpEquilibrium", "\342\245\256", 3 },
+    { "minusd", "\342\210\270", 3 },
+    { "lBarr", "\342\244\216", 3 },
+    { "KJcy", "\320\214", 2 },
+    { "rarrc", "\342\244\263", 3 },
+    { "RightVectorBar", "\342\245\223", 3 },
+    { "smtes", "\342\252\254\357\270\200", 6 },
+    { "midast", "\052", 1 },
+    { "DoubleUpArrow", "\342\207\221", 3 },
+    { "geq", "\342\211\245", 3 },
+    { "gnap", "\342\252\212", 3 },
+    { "Hacek", "\313\207", 2 },
+    { "dotplus", "\342\210\224", 3 },
+    { "easter", "\342\251\256", 3 },
+    { "sol", "\057", 1 },
+    { "dtri", "\342\226\277", 3 },
+    { "ouml", "\303\266", 2 },
+    { "DownLeftTeeVector", "\342\245\236", 3 },
+    { "Jukcy", "\320\204", 2 },
+    { "prod", "\342\210\217", 3 },
+    { "Ucy", "\320\243", 2 },
+    { "eDDot", "\342\251\267", 3 },
+    { "middot", "\302\267", 2 },
+    { "gvnE", "\342\211\251\357\270\200", 6 },
+    { "Prime", "\342\200\263", 3 },
+    { "setmn", "\342\210\226", 3 },
+    { "orarr", "\342\206\273", 3 },
+    { "Cscr", "\360\235\222\236", 4 },
+    { "csub", "\342\253\217", 3 },
+    { "supseteq", "\342\212\207", 3 },
+    { "epar", "\342\213\225", 3 },
+    { "rfr", "\360\235\224\257", 4 },
+    { "LeftRightVector", "\342\245\216", 3 },
+    { "eDot", "\342\211\221", 3 },
+    { "ocy", "\320\276", 2 },
+    { "nsc", "\342\212\201", 3 },
+    { "rightarrowtail", "\342\206\243", 3 },
+    { "uharl", "\342\206\277", 3 },
+    { "boxVL", "\342\225\243", 3 },
+    { "hopf", "\360\235\225\231", 4 },
+    { "intlarhk", "\342\250\227", 3 },
+    { "nwarr", "\342\206\226", 3 },
+    { "Map", "\342\244\205", 3 },
+    { "solbar", "\342\214\277", 3 },
+    { "gacute", "\307\265", 2 },
+    { "larr", "\342\206\220", 3 },
+    { "pound", "\302\243", 2 },
+    { "times", "\303\227", 2 },
+    { "racute", "\305\225", 2 },
+    { "Ugrave", "\303\231", 2 },
+    { "Rang", "\342\237\253", 3 },
+    { "Poincareplane", "\342\204\214", 3 },
+    { "Intersection", "\342\213\202", 3 },
+    { "capcap", "\342\251\213", 3 },
+    { "cupdot", "\342\212\215", 3 },
+    { "dharr", "\342\207\202", 3 },
+    { "gsime", "\342\252\216", 3 },
+    { "sc", "\342\211\273", 3 },
+    { "succneqq", "\342\252\266", 3 },
+    { "swArr", "\342\207\231", 3 },
+    { "downarrow", "\342\206\223", 3 },
+    { "NotLess", "\342\211\256", 3 },
+    { "mldr", "\342\200\246", 3 },
+    { "lvnE", "\342\211\250\357\270\200", 6 },
+    { "Aopf", "\360\235\224\270", 4 },
+    { "Hfr", "\342\204\214", 3 },
+    { "EmptyVerySmallSquare", "\342\226\253", 3 },
+    { "demptyv", "\342\246\261", 3 },
+    { "scy", "\321\201", 2 },
+    { "NotRightTriangleBar", "\342\247\220\314\270", 5 },
+    { "lnE", "\342\211\250", 3 },
+    { "chi", "\317\207", 2 },
+    { "dzcy", "\321\237", 2 },
+    { "Lacute", "\304\271", 2 },
+    { "Sup", "\342\213\221", 3 },
+    { "circledR", "\302\256", 2 },
+    { "jcy", "\320\271", 2 },
+    { "pcy", "\320\277", 2 },
+    { "el", "\342\252\231", 3 },
+    { "omega", "\317\211", 2 },
+    { "boxhU", "\342\225\250", 3 },
+    { "hairsp", "\342\200\212", 3 },
+    { "bull", "\342\200\242", 3 },
+    { "horbar", "\342\200\225", 3 },
+    { "NotRightTriangleEqual", "\342\213\255", 3 },
+    { "abreve", "\304\203", 2 },
+    { "ratail", "\342\244\232", 3 },
+    { "vscr", "\360\235\223\213", 4 },
+    { "rdsh", "\342\206\263", 3 },
+    { "nwArr", "\342\207\226", 3 },
+    { "nap", "\342\211\211", 3 },
+    { "vee", "\342\210\250", 3 },
+    { "rrarr", "\342\207\211", 3 },
+    { "ulcorner", "\342\214\234", 3 },
+    { "xmap", "\342\237\274", 3 },
+    { "nsubE", "\342\253\205\314\270", 5 },
+    { "sqsubset", "\342\212\217", 3 },
+    { "els", "\342\252\225", 3 },
+    { "dlcorn", "\342\214\236", 3 },
+    { "GJcy", "\320\203", 2 },
+    { "llhard", "\342\245\253", 3 },
+    { "DownLeftVector", "\342\206\275", 3 },
+    { "order", "\342\204\264", 3 },
+    { "circeq", "\342\211\227", 3 },
+    { "Leftrightarrow", "\342\207\224", 3 },
+    { "ntriangleright", "\342\213\253", 3 },
+    { "gesdot", "\342\252\200", 3 },
+    { "awconint", "\342\210\263", 3 },
+    { "ncap", "\342\251\203", 3 },
+    { "QUOT", "\042", 1 },
+    { "searhk", "\342\244\245", 3 },
+    { "rtimes", "\342\213\212", 3 },
+    { "lEg", "\342\252\213", 3 },
+    { "DoubleLongLeftRightArrow", "\342\237\272", 3 },
+    { "boxvl", "\342\224\244", 3 },
+    { "andv", "\342\251\232", 3 },
+    { "multimap", "\342\212\270", 3 },
+    { "escr", "\342\204\257", 3 },
+    { "sqcap", "\342\212\223", 3 },
+    { "xoplus", "\342\250\201", 3 },
+    { "Zcaron", "\305\275", 2 },
+    { "LeftVectorBar", "\342\245\222", 3 },
+    { "sup", "\342\212\203", 3 },
+    { "zwj", "\342\200\215", 3 },
+    { "gtlPar", "\342\246\225", 3 },
+    { "otimes", "\342\212\227", 3 },
+    { "llcorner", "\342\214\236", 3 },
+    { "lthree", "\342\213\213", 3 },
+    { "DownRightVector", "\342\207\201", 3 },
+    { "bowtie", "\342\213\210", 3 },
+    { "yen", "\302\245", 2 },
+    { "Mu", "\316\234", 2 },
+    { "smte", "\342\252\254", 3 },
+    { "itilde", "\304\251", 2 },
+    { "frasl", "\342\201\204", 3 },
+    { "nltri", "\342\213\252", 3 },
+    { "dfr", "\360\235\224\241", 4 },
+    { "yacute", "\303\275", 2 },
+    { "Psi", "\316\250", 2 },
+    { "nisd", "\342\213\272", 3 },
+    { "mscr", "\360\235\223\202", 4 },
+    { "urtri", "\342\227\271", 3 },
+    { "LeftFloor", "\342\214\212", 3 },
+    { "Vdashl", "\342\253\246", 3 },
+    { "nhArr", "\342\207\216", 3 },
+    { "Chi", "\316\247", 2 },
+    { "TRADE", "\342\204\242", 3 },
+    { "dtrif", "\342\226\276", 3 },
+    { "apid", "\342\211\213", 3 },
+    { "isin", "\342\210\210", 3 },
+    { "boxDL", "\342\225\227", 3 },
+    { "rtrie", "\342\212\265", 3 },
+    { "leftrightsquigarrow", "\342\206\255", 3 },
+    { "umacr", "\305\253", 2 },
+    { "ltcir", "\342\251\271", 3 },
+    { "smid", "\342\210\243", 3 },
+    { "DoubleLeftArrow", "\342\207\220", 3 },
+    { "boxVR", "\342\225\240", 3 },
+    { "Lcedil", "\304\273", 2 },
+    { "propto", "\342\210\235", 3 },
+    { "cudarrl", "\342\244\270", 3 },
+    { "eparsl", "\342\247\243", 3 },
+    { "prnsim", "\342\213\250", 3 },
+    { "subne", "\342\212\212", 3 },
+    { "lesssim", "\342\211\262", 3 },
+    { "Rarrtl", "\342\244\226", 3 },
+    { "Auml", "\303\204", 2 },
+    { "therefore", "\342\210\264", 3 },
+    { "atilde", "\303\243", 2 },
+    { "boxdL", "\342\225\225", 3 },
+    { "ratio", "\342\210\266", 3 },
+    { "lrm", "\342\200\216", 3 },
+    { "nleftrightarrow", "\342\206\256", 3 },
+    { "Lcaron", "\304\275", 2 },
+    { "notnivb", "\342\213\276", 3 },
+    { "xuplus", "\342\250\204", 3 },
+    { "topcir", "\342\253\261", 3 },
+    { "FilledSmallSquare", "\342\227\274", 3 },
+    { "NotElement", "\342\210\211", 3 },
+    { "natural", "\342\231\256", 3 },
+    { "LeftDownVectorBar", "\342\245\231", 3 },
+    { "xharr", "\342\237\267", 3 },
+    { "DiacriticalDot", "\313\231", 2 },
+    { "iexcl", "\302\241", 2 },
+    { "Gg", "\342\213\231", 3 },
+    { "nspar", "\342\210\246", 3 },
+    { "erarr", "\342\245\261", 3 },
+    { "Cconint", "\342\210\260", 3 },
+    { "ApplyFunction", "\342\201\241", 3 },
+    { "rtri", "\342\226\271", 3 },
+    { "topf", "\360\235\225\245", 4 },
+    { "Lt", "\342\211\252", 3 },
+    { "Ograve", "\303\222", 2 },
+    { "nequiv", "\342\211\242", 3 },
+    { "mu", "\316\274", 2 },
+    { "DiacriticalDoubleAcute", "\313\235", 2 },
+    { "notinvc", "\342\213\266", 3 },
+    { "lsquo", "\342\200\230", 3 },
+    { "Bscr", "\342\204\254", 3 },
+    { "rcub", "\175", 1 },
+    { "Gopf", "\360\235\224\276", 4 },
+    { "nlarr", "\342\206\232", 3 },
+    { "downdownarrows", "\342\207\212", 3 },
+    { "DoubleLongLeftArrow", "\342\237\270", 3 },
+    { "langle", "\342\237\250", 3 },
+    { "duarr", "\342\207\265", 3 },
+    { "lbrace", "\173", 1 },
+    { "Aring", "\303\205", 2 },
+    { "radic", "\342\210\232", 3 },
+    { "bbrk", "\342\216\265", 3 },
+    { "Mfr", "\360\235\224\220", 4 },
+    { "Egrave", "\303\210", 2 },
+    { "gtrarr", "\342\245\270", 3 },
+    { "lambda", "\316\273", 2 },
+    { "Ecy", "\320\255", 2 },
+    { "ufisht", "\342\245\276", 3 },
+    { "forkv", "\342\253\231", 3 },
+    { "leftrightharpoons", "\342\207\213", 3 },
+    { "doteqdot", "\342\211\221", 3 },
+    { "cupbrcap", "\342\251\210", 3 },
+    { "phiv", "\317\225", 2 },
+    { "isinsv", "\342\213\263", 3 },
+    { "blacktriangleleft", "\342\227\202", 3 },
+    { "commat", "\100", 1 },
+    { "xfr", "\360\235\224\265", 4 },
+    { "boxvL", "\342\225\241", 3 },
+    { "gamma", "\316\263", 2 },
+    { "image", "\342\204\221", 3 },
+    { "Otilde", "\303\225", 2 },
+    { "Esim", "\342\251\263", 3 },
+    { "sdotb", "\342\212\241", 3 },
+    { "epsilon", "\316\265", 2 },
+    { "ogt", "\342\247\201", 3 },
+    { "longleftrightarrow", "\342\237\267", 3 },
+    { "fflig", "\357\254\200", 3 },
+    { "lAtail", "\342\244\233", 3 },
+    { "Icy", "\320\230", 2 },
+    { "compfn", "\342\210\230", 3 },
+    { "equest", "\342\211\237", 3 },
+    { "ruluhar", "\342\245\250", 3 },
+    { "minusdu", "\342\250\252", 3 },
+    { "Tcedil", "\305\242", 2 },
+    { "ang", "\342\210\240", 3 },
+    { "NotSuperset", "\342\212\203\342\203\222", 6 },
+    { "nvrArr", "\342\244\203", 3 },
+    { "nlsim", "\342\211\264", 3 },
+    { "Wfr", "\360\235\224\232", 4 },
+    { "amacr", "\304\201", 2 },
+    { "udblac", "\305\261", 2 },
+    { "bsemi", "\342\201\217", 3 },
+    { "neArr", "\342\207\227", 3 },
+    { "hookleftarrow", "\342\206\251", 3 },
+    { "isinv", "\342\210\210", 3 },
+    { "ImaginaryI", "\342\205\210", 3 },
+    { "lates", "\342\252\255\357\270\200", 6 },
+    { "triangleleft", "\342\227\203", 3 },
+    { "nvdash", "\342\212\254", 3 },
+    { "cularrp", "\342\244\275", 3 },
+    { "utri", "\342\226\265", 3 },
+    { "Assign", "\342\211\224", 3 },
+    { "int", "\342\210\253", 3 },
+    { "Wscr", "\360\235\222\262", 4 },
+    { "LeftArrowBar", "\342\207\244", 3 },
+    { "zigrarr", "\342\207\235", 3 },
+    { "Oacute", "\303\223", 2 },
+    { "shcy", "\321\210", 2 },
+    { "SquareUnion", "\342\212\224", 3 },
+    { "target", "\342\214\226", 3 },
+    { "lsime", "\342\252\215", 3 },
+    { "ccaps", "\342\251\215", 3 },
+    { "HumpDownHump", "\342\211\216", 3 },
+    { "Congruent", "\342\211\241", 3 },
+    { "gtrsim", "\342\211\263", 3 },
+    { "loz", "\342\227\212", 3 },
+    { "leftthreetimes", "\342\213\213", 3 },
+    { "lArr", "\342\207\220", 3 },
+    { "ycirc", "\305\267", 2 },
+    { "excl", "\041", 1 },
+    { "subplus", "\342\252\277", 3 },
+    { "nvle", "\342\211\244\342\203\222", 6 },
+    { "plustwo", "\342\250\247", 3 },
+    { "NotTildeTilde", "\342\211\211", 3 },
+    { "isindot", "\342\213\265", 3 },
+    { "origof", "\342\212\266", 3 },
+    { "lrarr", "\342\207\206", 3 },
+    { "boxDl", "\342\225\226", 3 },
+    { "Cacute", "\304\206", 2 },
+    { "conint", "\342\210\256", 3 },
+    { "bigodot", "\342\250\200", 3 },
+    { "GreaterSlantEqual", "\342\251\276", 3 },
+    { "shchcy", "\321\211", 2 },
+    { "boxUr", "\342\225\231", 3 },
+    { "boxvh", "\342\224\274", 3 },
+    { "copy", "\302\251", 2 },
+    { "gtdot", "\342\213\227", 3 },
+    { "Uparrow", "\342\207\221", 3 },
+    { "tcaron", "\305\245", 2 },
+    { "boxvr", "\342\224\234", 3 },
+    { "angrt", "\342\210\237", 3 },
+    { "Coproduct", "\342\210\220", 3 },
+    { "iiiint", "\342\250\214", 3 },
+    { "rightsquigarrow", "\342\206\235", 3 },
+    { "gvertneqq", "\342\211\251\357\270\200", 6 },
+    { "imagpart", "\342\204\221", 3 },
+    { "shortmid", "\342\210\243", 3 },
+    { "khcy", "\321\205", 2 },
+    { "DJcy", "\320\202", 2 },
+    { "trade", "\342\204\242", 3 },
+    { "ge", "\342\211\245", 3 },
+    { "subE", "\342\253\205", 3 },
+    { "rarrlp", "\342\206\254", 3 },
+    { "rarrbfs", "\342\244\240", 3 },
+    { "supne", "\342\212\213", 3 },
+    { "bigtriangledown", "\342\226\275", 3 },
+    { "LeftTeeArrow", "\342\206\244", 3 },
+    { "sim", "\342\210\274", 3 },
+    { "supplus", "\342\253\200", 3 },
+    { "Mellintrf", "\342\204\263", 3 },
+    { "sqsubseteq", "\342\212\221", 3 },
+    { "angmsdag", "\342\246\256", 3 },
+    { "SquareSubset", "\342\212\217", 3 },
+    { "IEcy", "\320\225", 2 },
+    { "rlhar", "\342\207\214", 3 },
+    { "sup1", "\302\271", 2 },
+    { "asymp", "\342\211\210", 3 },
+    { "sbquo", "\342\200\232", 3 },
+    { "Jcy", "\320\231", 2 },
+    { "lsimg", "\342\252\217", 3 },
+    { "emsp14", "\342\200\205", 3 },
+    { "NotSupersetEqual", "\342\212\211", 3 },
+    { "boxDr", "\342\225\223", 3 },
+    { "sub", "\342\212\202", 3 },
+    { "lozf", "\342\247\253", 3 },
+    { "bsolhsub", "\342\237\210", 3 },
+    { "HumpEqual", "\342\211\217", 3 },
+    { "lrtri", "\342\212\277", 3 },
+    { "Iota", "\316\231", 2 },
+    { "sdote", "\342\251\246", 3 },
+    { "notindot", "\342\213\265\314\270", 5 },
+    { "Pi", "\316\240", 2 },
+    { "natur", "\342\231\256", 3 },
+    { "searrow", "\342\206\230", 3 },
+    { "nrightarrow", "\342\206\233", 3 },
+    { "xsqcup", "\342\250\206", 3 },
+    { "rcedil", "\305\227", 2 },
+    { "profline", "\342\214\222", 3 },
+    { "NotPrecedes", "\342\212\200", 3 },
+    { "LT", "\074", 1 },
+    { "DiacriticalTilde", "\313\234", 2 },
+    { "nabla", "\342\210\207", 3 },
+    { "Ouml", "\303\226", 2 },
+    { "Ubreve", "\305\254", 2 },
+    { "theta", "\316\270", 2 },
+    { "supe", "\342\212\207", 3 },
+    { "dArr", "\342\207\223", 3 },
+    { "ll", "\342\211\252", 3 },
+    { "vDash", "\342\212\250", 3 },
+    { "Lambda", "\316\233", 2 },
+    { "sqcup", "\342\212\224", 3 },
+    { "Gt", "\342\211\253", 3 },
+    { "nedot", "\342\211\220\314\270", 5 },
+    { "DownLeftVectorBar", "\342\245\226", 3 },
+    { "Vee", "\342\213\201", 3 },
+    { "CloseCurlyQuote", "\342\200\231", 3 },
+    { "fopf", "\360\235\225\227", 4 },
+    { "NegativeThinSpace", "\342\200\213", 3 },
+    { "diams", "\342\231\246", 3 },
+    { "lesdotor", "\342\252\203", 3 },
+    { "Fcy", "\320\244", 2 },
+    { "hyphen", "\342\200\220", 3 },
+    { "bumpE", "\342\252\256", 3 },
+    { "NegativeMediumSpace", "\342\200\213", 3 },
+    { "Wcirc", "\305\264", 2 },
+    { "GreaterFullEqual", "\342\211\247", 3 },
+    { "ngE", "\342\211\247\314\270", 5 },
+    { "Atilde", "\303\203", 2 },
+    { "Ccaron", "\304\214", 2 },
+    { "Sum", "\342\210\221", 3 },
+    { "boxVh", "\342\225\253", 3 },
+    { "cudarrr", "\342\244\265", 3 },
+    { "approx", "\342\211\210", 3 },
+    { "simlE", "\342\252\237", 3 },
+    { "Nacute", "\305\203", 2 },
+    { "filig", "\357\254\201", 3 },
+    { "curlyvee", "\342\213\216", 3 },
+    { "RightTeeVector", "\342\245\233", 3 },
+    { "LessTilde", "\342\211\262", 3 },
+    { "Rscr", "\342\204\233", 3 },
+    { "NotVerticalBar", "\342\210\244", 3 },
+    { "Yacute", "\303\235", 2 },
+    { "slarr", "\342\206\220", 3 },
+    { "oplus", "\342\212\225", 3 },
+    { "spar", "\342\210\245", 3 },
+    { "RightAngleBracket", "\342\237\251", 3 },
+    { "circ", "\313\206", 2 },
+    { "rsh", "\342\206\261", 3 },
+    { "VeryThinSpace", "\342\200\212", 3 },
+    { "bigoplus", "\342\250\201", 3 },
+    { "colon", "\072", 1 },
+    { "harr", "\342\206\224", 3 },
+    { "olcir", "\342\246\276", 3 },
+    { "gesles", "\342\252\224", 3 },
+    { "bsol", "\134", 1 },
+    { "xdtri", "\342\226\275", 3 },
+    { "ii", "\342\205\210", 3 },
+    { "Element", "\342\210\210", 3 },
+    { "DifferentialD", "\342\205\206", 3 },
+    { "Ecaron", "\304\232", 2 },
+    { "Agrave", "\303\200", 2 },
+    { "rbrkslu", "\342\246\220", 3 },
+    { "SquareIntersection", "\342\212\223", 3 },
+    { "inodot", "\304\261", 2 },
+    { "frac56", "\342\205\232", 3 },
+    { "complement", "\342\210\201", 3 },
+    { "frac15", "\342\205\225", 3 },
+    { "plusdu", "\342\250\245", 3 },
+    { "dashv", "\342\212\243", 3 },
+    { "NotSquareSubset", "\342\212\217\314\270", 5 },
+    { "tstrok", "\305\247", 2 },
+    { "Ffr", "\360\235\224\211", 4 },
+    { "EmptySmallSquare", "\342\227\273", 3 },
+    { "wp", "\342\204\230", 3 },
+    { "SHCHcy", "\320\251", 2 },
+    { "Iukcy", "\320\206", 2 },
+    { "varr", "\342\206\225", 3 },
+    { "gEl", "\342\252\214", 3 },
+    { "duhar", "\342\245\257", 3 },
+    { "squf", "\342\226\252", 3 },
+    { "notni", "\342\210\214", 3 },
+    { "nsucceq", "\342\252\260\314\270", 5 },
+    { "isins", "\342\213\264", 3 },
+    { "realine", "\342\204\233", 3 },
+    { "NotLessEqual", "\342\211\260", 3 },
+    { "ap", "\342\211\210", 3 },
+    { "uscr", "\360\235\223\212", 4 },
+    { "trisb", "\342\247\215", 3 },
+    { "topbot", "\342\214\266", 3 },
+    { "lessgtr", "\342\211\266", 3 },
+    { "LongRightArrow", "\342\237\266", 3 },
+    { "nsup", "\342\212\205", 3 },
+    { "iquest", "\302\277", 2 },
+    { "Otimes", "\342\250\267", 3 },
+    { "acd", "\342\210\277", 3 },
+    { "lHar", "\342\245\242", 3 },
+    { "precneqq", "\342\252\265", 3 },
+    { "gesl", "\342\213\233\357\270\200", 6 },
+    { "roang", "\342\237\255", 3 },
+    { "cwconint", "\342\210\262", 3 },
+    { "Gamma", "\316\223", 2 },
+    { "para", "\302\266", 2 },
+    { "varphi", "\317\225", 2 },
+    { "ee", "\342\205\207", 3 },
+    { "Proportion", "\342\210\267", 3 },
+    { "Re", "\342\204\234", 3 },
+    { "ltrif", "\342\227\202", 3 },
+    { "rsqb", "\135", 1 },
+    { "thksim", "\342\210\274", 3 },
+    { "aleph", "\342\204\265", 3 },
+    { "SubsetEqual", "\342\212\206", 3 },
+    { "Ccirc", "\304\210", 2 },
+    { "supmult", "\342\253\202", 3 },
+    { "Zopf", "\342\204\244", 3 },
+    { "Rfr", "\342\204\234", 3 },
+    { "gap", "\342\252\206", 3 },
+    { "Uacute", "\303\232", 2 },
+    { "top", "\342\212\244", 3 },
+    { "Lstrok", "\305\201", 2 },
+    { "oS", "\342\223\210", 3 },
+    { "pr", "\342\211\272", 3 },
+    { "LessSlantEqual", "\342\251\275", 3 },
+    { "frac18", "\342\205\233", 3 },
+    { "straightphi", "\317\225", 2 },
+    { "tshcy", "\321\233", 2 },
+    { "boxHu", "\342\225\247", 3 },
+    { "in", "\342\210\210", 3 },
+    { "planck", "\342\204\217", 3 },
+    { "timesd", "\342\250\260", 3 },
+    { "InvisibleTimes", "\342\201\242", 3 },
+    { "ncongdot", "\342\251\255\314\270", 5 },
+    { "nis", "\342\213\274", 3 },
+    { "zeetrf", "\342\204\250", 3 },
+    { "Vcy", "\320\222", 2 },
+    { "leg", "\342\213\232", 3 },
+    { "Fopf", "\360\235\224\275", 4 },
+    { "Rcaron", "\305\230", 2 },
+    { "nLeftrightarrow", "\342\207\216", 3 },
+    { "boxbox", "\342\247\211", 3 },
+    { "les", "\342\251\275", 3 },
+    { "angsph", "\342\210\242", 3 },
+    { "otilde", "\303\265", 2 },
+    { "larrbfs", "\342\244\237", 3 },
+    { "gescc", "\342\252\251", 3 },
+    { "iota", "\316\271", 2 },
+    { "leqq", "\342\211\246", 3 },
+    { "boxh", "\342\224\200", 3 },
+    { "YIcy", "\320\207", 2 },
+    { "Gcedil", "\304\242", 2 },
+    { "andslope", "\342\251\230", 3 },
+    { "cirscir", "\342\247\202", 3 },
+    { "Phi", "\316\246", 2 },
+    { "ClockwiseContourIntegral", "\342\210\262", 3 },
+    { "sstarf", "\342\213\206", 3 },
+    { "mnplus", "\342\210\223", 3 },
+    { "cire", "\342\211\227", 3 },
+    { "apE", "\342\251\260", 3 },
+    { "rbrack", "\135", 1 },
+    { "Iopf", "\360\235\225\200", 4 },
+    { "circleddash", "\342\212\235", 3 },
+    { "Racute", "\305\224", 2 },
+    { "DScy", "\320\205", 2 },
+    { "rpargt", "\342\246\224", 3 },
+    { "sqsupset", "\342\212\220", 3 },
+    { "Im", "\342\204\221", 3 },
+    { "curlyeqprec", "\342\213\236", 3 },
+    { "FilledVerySmallSquare", "\342\226\252", 3 },
+    { "iscr", "\360\235\222\276", 4 },
+    { "kjcy", "\321\234", 2 },
+    { "rarrw", "\342\206\235", 3 },
+    { "LessLess", "\342\252\241", 3 },
+    { "Beta", "\316\222", 2 },
+    { "xlarr", "\342\237\265", 3 },
+    { "sigmaf", "\317\202", 2 },
+    { "frac58", "\342\205\235", 3 },
+    { "nge", "\342\211\261", 3 },
+    { "larrb", "\342\207\244", 3 },
+    { "lescc", "\342\252\250", 3 },
+    { "jcirc", "\304\265", 2 },
+    { "ulcrop", "\342\214\217", 3 },
+    { "grave", "\140", 1 },
+    { "succcurlyeq", "\342\211\275", 3 },
+    { "leftharpoonup", "\342\206\274", 3 },
+    { "DD", "\342\205\205", 3 },
+    { "Upsi", "\317\222", 2 },
+    { "hArr", "\342\207\224", 3 },
+    { "cirE", "\342\247\203", 3 },
+    { "ugrave", "\303\271", 2 },
+    { "PrecedesTilde", "\342\211\276", 3 },
+    { "asympeq", "\342\211\215", 3 },
+    { "OpenCurlyDoubleQuote", "\342\200\234", 3 },
+    { "bigstar", "\342\230\205", 3 },
+    { "nGg", "\342\213\231\314\270", 5 },
+    { "supE", "\342\253\206", 3 },
+    { "imped", "\306\265", 2 },
+    { "Lsh", "\342\206\260", 3 },
+    { "Gscr", "\360\235\222\242", 4 },
+    { "crarr", "\342\206\265", 3 },
+    { "REG", "\302\256", 2 },
+    { "centerdot", "\302\267", 2 },
+    { "Ofr", "\360\235\224\222", 4 },
+    { "Oopf", "\360\235\225\206", 4 },
+    { "gE", "\342\211\247", 3 },
+    { "Fouriertrf", "\342\204\261", 3 },
+    { "blacktriangle", "\342\226\264", 3 },
+    { "or", "\342\210\250", 3 },
+    { "cupcap", "\342\251\206", 3 },
+    { "nLt", "\342\211\252\342\203\222", 6 },
+    { "subset", "\342\212\202", 3 },
+    { "Sscr", "\360\235\222\256", 4 },
+    { "subrarr", "\342\245\271", 3 },
+    { "NotTildeFullEqual", "\342\211\207", 3 },
+    { "eng", "\305\213", 2 },
+    { "gtrless", "\342\211\267", 3 },
+    { "scsim", "\342\211\277", 3 },
+    { "percnt", "\045", 1 },
+    { "esim", "\342\211\202", 3 },
+    { "xrarr", "\342\237\266", 3 },
+    { "vsupnE", "\342\253\214\357\270\200", 6 },
+    { "Kscr", "\360\235\222\246", 4 },
+    { "Ubrcy", "\320\216", 2 },
+    { "rHar", "\342\245\244", 3 },
+    { "rmoustache", "\342\216\261", 3 },
+    { "Copf", "\342\204\202", 3 },
+    { "amp", "\046", 1 },
+    { "rbarr", "\342\244\215", 3 },
+    { "exist", "\342\210\203", 3 },
+    { "Bumpeq", "\342\211\216", 3 },
+    { "seswar", "\342\244\251", 3 },
+    { "Odblac", "\305\220", 2 },
+    { "longmapsto", "\342\237\274", 3 },
+    { "straightepsilon", "\317\265", 2 },
+    { "profsurf", "\342\214\223", 3 },
+    { "eth", "\303\260", 2 },
+    { "CupCap", "\342\211\215", 3 },
+    { "NotEqualTilde", "\342\211\202\314\270", 5 },
+    { "nsupset", "\342\212\203\342\203\222", 6 },
+    { "lotimes", "\342\250\264", 3 },
+    { "mapstodown", "\342\206\247", 3 },
+    { "xodot", "\342\250\200", 3 },
+    { "Ocy", "\320\236", 2 },
+    { "ring", "\313\232", 2 },
+    { "Yuml", "\305\270", 2 },
+    { "dzigrarr", "\342\237\277", 3 },
+    { "longrightarrow", "\342\237\266", 3 },
+    { "barwed", "\342\214\205", 3 },
+    { "nvrtrie", "\342\212\265\342\203\222", 6 },
+    { "oopf", "\360\235\225\240", 4 },
+    { "xotime", "\342\250\202", 3 },
+    { "looparrowright", "\342\206\254", 3 },
+    { "Alpha", "\316\221", 2 },
+    { "angmsdad", "\342\246\253", 3 },
+    { "Dscr", "\360\235\222\237", 4 },
+    { "Nu", "\316\235", 2 },
+    { "kfr", "\360\235\224\250", 4 },
+    { "nbump", "\342\211\216\314\270", 5 },
+    { "iecy", "\320\265", 2 },
+    { "sqsube", "\342\212\221", 3 },
+    { "questeq", "\342\211\237", 3 },
+    { "Hstrok", "\304\246", 2 },
+    { "LowerRightArrow", "\342\206\230", 3 },
+    { "zacute", "\305\272", 2 },
+    { "nshortmid", "\342\210\244", 3 },
+    { "Cdot", "\304\212", 2 },
+    { "zcy", "\320\267", 2 },
+    { "lesg", "\342\213\232\357\270\200", 6 },
+    { "vdash", "\342\212\242", 3 },
+    { "die", "\302\250", 2 },
+    { "precnapprox", "\342\252\271", 3 },
+    { "Zfr", "\342\204\250", 3 },
+    { "ic", "\342\201\243", 3 },
+    { "DoubleRightArrow", "\342\207\222", 3 },
+    { "xcup", "\342\213\203", 3 },
+    { "cup", "\342\210\252", 3 },
+    { "RightUpVector", "\342\206\276", 3 },
+    { "nearrow", "\342\206\227", 3 },
+    { "xopf", "\360\235\225\251", 4 },
+    { "succnapprox", "\342\252\272", 3 },
+    { "dlcrop", "\342\214\215", 3 },
+    { "Yfr", "\360\235\224\234", 4 },
+    { "rfloor", "\342\214\213", 3 },
+    { "sung", "\342\231\252", 3 },
+    { "subnE", "\342\253\213", 3 },
+    { "forall", "\342\210\200", 3 },
+    { "PrecedesEqual", "\342\252\257", 3 },
+    { "gtrapprox", "\342\252\206", 3 },
+    { "simg", "\342\252\236", 3 },
+    { "scpolint", "\342\250\223", 3 },
+    { "Precedes", "\342\211\272", 3 },
+    { "uacute", "\303\272", 2 },
+    { "uharr", "\342\206\276", 3 },
+    { "ntlg", "\342\211\270", 3 },
+    { "SOFTcy", "\320\254", 2 },
+    { "lceil", "\342\214\210", 3 },
+    { "RightTeeArrow", "\342\206\246", 3 },
+    { "nleq", "\342\211\260", 3 },
+    { "SquareSubsetEqual", "\342\212\221", 3 },
+    { "varkappa", "\317\260", 2 },
+    { "lmoust", "\342\216\260", 3 },
+    { "DownArrowBar", "\342\244\223", 3 },
+    { "ecolon", "\342\211\225", 3 },
+    { "RightUpVectorBar", "\342\245\224", 3 },
+    { "Nfr", "\360\235\224\221", 4 },
+    { "lsim", "\342\211\262", 3 },
+    { "circlearrowright", "\342\206\273", 3 },
+    { "euml", "\303\253", 2 },
+    { "Colone", "\342\251\264", 3 },
+    { "rtriltri", "\342\247\216", 3 },
+    { "supdot", "\342\252\276", 3 },
+    { "sdot", "\342\213\205", 3 },
+    { "srarr", "\342\206\222", 3 },
+    { "ni", "\342\210\213", 3 },
+    { "hamilt", "\342\204\213", 3 },
+    { "strns", "\302\257", 2 },
+    { "Umacr", "\305\252", 2 },
+    { "frac23", "\342\205\224", 3 },
+    { "plusacir", "\342\250\243", 3 },
+    { "nvHarr", "\342\244\204", 3 },
+    { "rhov", "\317\261", 2 },
+    { "frac45", "\342\205\230", 3 },
+    { "NotLeftTriangleBar", "\342\247\217\314\270", 5 },
+    { "Mcy", "\320\234", 2 },
+    { "robrk", "\342\237\247", 3 },
+    { "rharu", "\342\207\200", 3 },
+    { "orv", "\342\251\233", 3 },
+    { "ThickSpace", "\342\201\237\342\200\212", 6 },
+    { "blacktriangleright", "\342\226\270", 3 },
+    { "ifr", "\360\235\224\246", 4 },
+    { "mdash", "\342\200\224", 3 },
+    { "eg", "\342\252\232", 3 },
+    { "Star", "\342\213\206", 3 },
+    { "NotGreaterGreater", "\342\211\253\314\270", 5 },
+    { "lbrksld", "\342\246\217", 3 },
+    { "uwangle", "\342\246\247", 3 },
+    { "hearts", "\342\231\245", 3 },
+    { "NotSquareSubsetEqual", "\342\213\242", 3 },
+    { "Hscr", "\342\204\213", 3 },
+    { "Afr", "\360\235\224\204", 4 },
+    { "hybull", "\342\201\203", 3 },
+    { "subsetneqq", "\342\253\213", 3 },
+    { "biguplus", "\342\250\204", 3 },
+    { "Iscr", "\342\204\220", 3 },
+    { "Hopf", "\342\204\215", 3 },
+    { "rho", "\317\201", 2 },
+    { "triminus", "\342\250\272", 3 },
+    { "lfloor", "\342\214\212", 3 },
+    { "RightDoubleBracket", "\342\237\247", 3 },
+    { "Icirc", "\303\216", 2 },
+    { "range", "\342\246\245", 3 },
+    { "complexes", "\342\204\202", 3 },
+    { "TildeTilde", "\342\211\210", 3 },
+    { "Jsercy", "\320\210", 2 },
+    { "HilbertSpace", "\342\204\213", 3 },
+    { "tilde", "\313\234", 2 },
+    { "iukcy", "\321\226", 2 },
+    { "utilde", "\305\251", 2 },
+    { "vopf", "\360\235\225\247", 4 },
+    { "larrsim", "\342\245\263", 3 },
+    { "Proportional", "\342\210\235", 3 },
+    { "GreaterEqual", "\342\211\245", 3 },
+    { "RightVector", "\342\207\200", 3 },
+    { "DownTeeArrow", "\342\206\247", 3 },
+    { "gsim", "\342\211\263", 3 },
+    { "rdca", "\342\244\267", 3 },
+    { "lbrke", "\342\246\213", 3 },
+    { "vzigzag", "\342\246\232", 3 },
+    { "comp", "\342\210\201", 3 },
+    { "UpArrowBar", "\342\244\222", 3 },
+    { "urcorner", "\342\214\235", 3 },
+    { "pertenk", "\342\200\261", 3 },
+    { "intprod", "\342\250\274", 3 },
+    { "GT", "\076", 1 },
+    { "Therefore", "\342\210\264", 3 },
+    { "and", "\342\210\247", 3 },
+    { "kopf", "\360\235\225\234", 4 },
+    { "caps", "\342\210\251\357\270\200", 6 },
+    { "SucceedsTilde", "\342\211\277", 3 },
+    { "Wopf", "\360\235\225\216", 4 },
+    { "supedot", "\342\253\204", 3 },
+    { "quest", "\077", 1 },
+    { "Dashv", "\342\253\244", 3 },
+    { "Eogon", "\304\230", 2 },
+    { "Cross", "\342\250\257", 3 },
+    { "RBarr", "\342\244\220", 3 },
+    { "twixt", "\342\211\254", 3 },
+    { "qprime", "\342\201\227", 3 },
+    { "lurdshar", "\342\245\212", 3 },
+    { "backprime", "\342\200\265", 3 },
+    { "equiv", "\342\211\241", 3 },
+    { "rarrhk", "\342\206\252", 3 },
+    { "Ycirc", "\305\266", 2 },
+    { "Rcedil", "\305\226", 2 },
+    { "LessGreater", "\342\211\266", 3 },
+    { "nfr", "\360\235\224\253", 4 },
+    { "lpar", "\050", 1 },
+    { "esdot", "\342\211\220", 3 },
+    { "scnsim", "\342\213\251", 3 },
+    { "Diamond", "\342\213\204", 3 },
+    { "trie", "\342\211\234", 3 },
+    { "ijlig", "\304\263", 2 },
+    { "nleftarrow", "\342\206\232", 3 },
+    { "odot", "\342\212\231", 3 },
+    { "rtrif", "\342\226\270", 3 },
+    { "lcaron", "\304\276", 2 },
+    { "Leftarrow", "\342\207\220", 3 },
+    { "numero", "\342\204\226", 3 },
+    { "ape", "\342\211\212", 3 },
+    { "uopf", "\360\235\225\246", 4 },
+    { "bcy", "\320\261", 2 },
+    { "curren", "\302\244", 2 },
+    { "boxUR", "\342\225\232", 3 },
+    { "supsetneq", "\342\212\213", 3 },
+    { "ncaron", "\305\210", 2 },
+    { "curvearrowleft", "\342\206\266", 3 },
+    { "subdot", "\342\252\275", 3 },
+    { "lhard", "\342\206\275", 3 },
+    { "acute", "\302\264", 2 },
+    { "part", "\342\210\202", 3 },
+    { "Delta", "\316\224", 2 },
+    { "loang", "\342\237\254", 3 },
+    { "dharl", "\342\207\203", 3 },
+    { "LeftTee", "\342\212\243", 3 },
+    { "LeftUpTeeVector", "\342\245\240", 3 },
+    { "Dagger", "\342\200\241", 3 },
+    { "dbkarow", "\342\244\217", 3 },
+    { "Ncaron", "\305\207", 2 },
+    { "gtquest", "\342\251\274", 3 },
+    { "Idot", "\304\260", 2 },
+    { "larrlp", "\342\206\253", 3 },
+    { "raemptyv", "\342\246\263", 3 },
+    { "lt", "\074", 1 },
+    { "oline", "\342\200\276", 3 },
+    { "lgE", "\342\252\221", 3 },
+    { "Longleftrightarrow", "\342\237\272", 3 },
+    { "bfr", "\360\235\224\237", 4 },
+    { "between", "\342\211\254", 3 },
+    { "NotCupCap", "\342\211\255", 3 },
+    { "bullet", "\342\200\242", 3 },
+    { "frac25", "\342\205\226", 3 },
+    { "zscr", "\360\235\223\217", 4 },
+    { "curvearrowright", "\342\206\267", 3 },
+    { "cularr", "\342\206\266", 3 },
+    { "nsqsupe", "\342\213\243", 3 },
+    { "eqvparsl", "\342\247\245", 3 },
+    { "DoubleRightTee", "\342\212\250", 3 },
+    { "cemptyv", "\342\246\262", 3 },
+    { "Sqrt", "\342\210\232", 3 },
+    { "Breve", "\313\230", 2 },
+    { "nrtrie", "\342\213\255", 3 },
+    { "pointint", "\342\250\225", 3 },
+    { "gneq", "\342\252\210", 3 },
+    { "disin", "\342\213\262", 3 },
+    { "Gdot", "\304\240", 2 },
+    { "nsqsube", "\342\213\242", 3 },
+    { "colone", "\342\211\224", 3 },
+    { "looparrowleft", "\342\206\253", 3 },
+    { "Wedge", "\342\213\200", 3 },
+    { "Kopf", "\360\235\225\202", 4 },
+    { "Scaron", "\305\240", 2 },
+    { "cap", "\342\210\251", 3 },
+    { "nVdash", "\342\212\256", 3 },
+    { "divide", "\303\267", 2 },
+    { "lrhard", "\342\245\255", 3 },
+    { "macr", "\302\257", 2 },
+    { "micro", "\302\265", 2 },
+    { "angmsd", "\342\210\241", 3 },
+    { "nsubset", "\342\212\202\342\203\222", 6 },
+    { "nexists", "\342\210\204", 3 },
+    { "SquareSupersetEqual", "\342\212\222", 3 },
+    { "DownRightTeeVector", "\342\245\237", 3 },
+    { "ccedil", "\303\247", 2 },
+    { "TildeEqual", "\342\211\203", 3 },
+    { "varsubsetneq", "\342\212\212\357\270\200", 6 },
+    { "npr", "\342\212\200", 3 },
+    { "Uuml", "\303\234", 2 },
+    { "gne", "\342\252\210", 3 },
+    { "GreaterLess", "\342\211\267", 3 },
+    { "awint", "\342\250\221", 3 },
+    { "minus", "\342\210\222", 3 },
+    { "LeftCeiling", "\342\214\210", 3 },
+    { "rcy", "\321\200", 2 },
+    { "sect", "\302\247", 2 },
+    { "Del", "\342\210\207", 3 },
+    { "leftrightarrow", "\342\206\224", 3 },
+    { "fnof", "\306\222", 2 },
+    { "And", "\342\251\223", 3 },
+    { "toea", "\342\244\250", 3 },
+    { "epsiv", "\317\265", 2 },
+    { "npre", "\342\252\257\314\270", 5 },
+    { "AMP", "\046", 1 },
+    { "Pr", "\342\252\273", 3 },
+    { "Or", "\342\251\224", 3 },
+    { "Euml", "\303\213", 2 },
+    { "Not", "\342\253\254", 3 },
+    { "sigma", "\317\203", 2 },
+    { "Dot", "\302\250", 2 },
+    { "leftleftarrows", "\342\207\207", 3 },
+    { "setminus", "\342\210\226", 3 },
+    { "yucy", "\321\216", 2 },
+    { "uarr", "\342\206\221", 3 },
+    { "bigsqcup", "\342\250\206", 3 },
+    { "KHcy", "\320\245", 2 },
+    { "angrtvb", "\342\212\276", 3 },
+    { "acirc", "\303\242", 2 },
+    { "Udblac", "\305\260", 2 },
+    { "DoubleDownArrow", "\342\207\223", 3 },
+    { "nscr", "\360\235\223\203", 4 },
+    { "uml", "\302\250", 2 },
+    { "rx", "\342\204\236", 3 },
+    { "UpDownArrow", "\342\206\225", 3 },
+    { "xvee", "\342\213\201", 3 },
+    { "NotSquareSupersetEqual", "\342\213\243", 3 },
+    { "scE", "\342\252\264", 3 },
+    { "Ifr", "\342\204\221", 3 },
+    { "udarr", "\342\207\205", 3 },
+    { "ominus", "\342\212\226", 3 },
+    { "SupersetEqual", "\342\212\207", 3 },
+    { "oscr", "\342\204\264", 3 },
+    { "coprod", "\342\210\220", 3 },
+    { "pitchfork", "\342\213\224", 3 },
+    { "Ufr", "\360\235\224\230", 4 },
+    { "laquo", "\302\253", 2 },
+    { "subsim", "\342\253\207", 3 },
+    { "IOcy", "\320\201", 2 },
+    { "CircleMinus", "\342\212\226", 3 },
+    { "IJlig", "\304\262", 2 },
+    { "LeftDownTeeVector", "\342\245\241", 3 },
+    { "bump", "\342\211\216", 3 },
+    { "models", "\342\212\247", 3 },
+    { "ultri", "\342\227\270", 3 },
+    { "operp", "\342\246\271", 3 },
+    { "NotGreaterTilde", "\342\211\265", 3 },
+    { "naturals", "\342\204\225", 3 },
+    { "vnsub", "\342\212\202\342\203\222", 6 },
+    { "ange", "\342\246\244", 3 },
+    { "NotGreaterFullEqual", "\342\211\247\314\270", 5 },
+    { "RightArrowBar", "\342\207\245", 3 },
+    { "Zdot", "\305\273", 2 },
+    { "ctdot", "\342\213\257", 3 },
+    { "TScy", "\320\246", 2 },
+    { "barvee", "\342\212\275", 3 },
+    { "omacr", "\305\215", 2 },
+    { "nsupe", "\342\212\211", 3 },
+    { "VerticalTilde", "\342\211\200", 3 },
+    { "lcedil", "\304\274", 2 },
+    { "suphsub", "\342\253\227", 3 },
+    { "phi", "\317\206", 2 },
+    { "iogon", "\304\257", 2 },
+    { "eta", "\316\267", 2 },
+    { "nle", "\342\211\260", 3 },
+    { "ropar", "\342\246\206", 3 },
+    { "sube", "\342\212\206", 3 },
+    { "VerticalLine", "\174", 1 },
+    { "bumpeq", "\342\211\217", 3 },
+    { "bigotimes", "\342\250\202", 3 },
+    { "dscy", "\321\225", 2 },
+    { "LessEqualGreater", "\342\213\232", 3 },
+    { "NotLessLess", "\342\211\252\314\270", 5 },
+    { "Dfr", "\360\235\224\207", 4 },
+    { "vert", "\174", 1 },
+    { "boxhd", "\342\224\254", 3 },
+    { "wedgeq", "\342\211\231", 3 },
+    { "LessFullEqual", "\342\211\246", 3 },
+    { "HorizontalLine", "\342\224\200", 3 },
+    { "NegativeThickSpace", "\342\200\213", 3 },
+    { "djcy", "\321\222", 2 },
+    { "Qopf", "\342\204\232", 3 },
+    { "GreaterGreater", "\342\252\242", 3 },
+    { "jscr", "\360\235\222\277", 4 },
+    { "cscr", "\360\235\222\270", 4 },
+    { "Iogon", "\304\256", 2 },
+    { "ocirc", "\303\264", 2 },
+    { "rationals", "\342\204\232", 3 },
+    { "Acirc", "\303\202", 2 },
+    { "rightrightarrows", "\342\207\211", 3 },
+    { "glE", "\342\252\222", 3 },
+    { "scnap", "\342\252\272", 3 },
+    { "yuml", "\303\277", 2 },
+    { "RightDownVector", "\342\207\202", 3 },
+    { "boxH", "\342\225\220", 3 },
+    { "triangle", "\342\226\265", 3 },
+    { "lozenge", "\342\227\212", 3 },
+    { "gcirc", "\304\235", 2 },
+    { "doteq", "\342\211\220", 3 },
+    { "LeftTriangleBar", "\342\247\217", 3 },
+    { "orslope", "\342\251\227", 3 },
+    { "nvDash", "\342\212\255", 3 },
+    { "nleqslant", "\342\251\275\314\270", 5 },
+    { "icy", "\320\270", 2 },
+    { "scap", "\342\252\270", 3 },
+    { "iff", "\342\207\224", 3 },
+    { "nrtri", "\342\213\253", 3 },
+    { "NotTilde", "\342\211\201", 3 },
+    { "Aacute", "\303\201", 2 },
+    { "sacute", "\305\233", 2 },
+    { "NotLessGreater", "\342\211\270", 3 },
+    { "rbrksld", "\342\246\216", 3 },
+    { "dagger", "\342\200\240", 3 },
+    { "fscr", "\360\235\222\273", 4 },
+    { "lAarr", "\342\207\232", 3 },
+    { "PrecedesSlantEqual", "\342\211\274", 3 },
+    { "oslash", "\303\270", 2 },
+    { "DotEqual", "\342\211\220", 3 },
+    { "boxplus", "\342\212\236", 3 },
+    { "measuredangle", "\342\210\241", 3 },
+    { "rightarrow", "\342\206\222", 3 },
+    { "boxminus", "\342\212\237", 3 },
+    { "DownRightVectorBar", "\342\245\227", 3 },
+    { "ldrushar", "\342\245\213", 3 },
+    { "eqcirc", "\342\211\226", 3 },
+    { "Bcy", "\320\221", 2 },
+    { "notinva", "\342\210\211", 3 },
+    { "Dstrok", "\304\220", 2 },
+    { "bprime", "\342\200\265", 3 },
+    { "jsercy", "\321\230", 2 },
+    { "nsccue", "\342\213\241", 3 },
+    { "nsime", "\342\211\204", 3 },
+    { "swarr", "\342\206\231", 3 },
+    { "ngeqslant", "\342\251\276\314\270", 5 },
+    { "kcedil", "\304\267", 2 },
+    { "ccups", "\342\251\214", 3 },
+    { "Verbar", "\342\200\226", 3 },
+    { "angle", "\342\210\240", 3 },
+    { "pluse", "\342\251\262", 3 },
+    { "nLeftarrow", "\342\207\215", 3 },
+    { "primes", "\342\204\231", 3 },
+    { "rppolint", "\342\250\222", 3 },
+    { "urcorn", "\342\214\235", 3 },
+    { "egs", "\342\252\226", 3 },
+    { "scaron", "\305\241", 2 },
+    { "NotGreaterSlantEqual", "\342\251\276\314\270", 5 },
+    { "olt", "\342\247\200", 3 },
+    { "csube", "\342\253\221", 3 },
+    { "nVDash", "\342\212\257", 3 },
+    { "nearr", "\342\206\227", 3 },
+    { "varepsilon", "\317\265", 2 },
+    { "longleftarrow", "\342\237\265", 3 },
+    { "blacklozenge", "\342\247\253", 3 },
+    { "lnapprox", "\342\252\211", 3 },
+    { "rdquor", "\342\200\235", 3 },
+    { "ThinSpace", "\342\200\211", 3 },
+    { "intcal", "\342\212\272", 3 },
+    { "Lmidot", "\304\277", 2 },
+    { "gdot", "\304\241", 2 },
+    { "Rho", "\316\241", 2 },
+    { "ntgl", "\342\211\271", 3 },
+    { "ContourIntegral", "\342\210\256", 3 },
+    { "leftrightarrows", "\342\207\206", 3 },
+    { "bigcirc", "\342\227\257", 3 },
+    { "kappa", "\316\272", 2 },
+    { "ord", "\342\251\235", 3 },
+    { "ascr", "\360\235\222\266", 4 },
+    { "NotCongruent", "\342\211\242", 3 },
+    { "THORN", "\303\236", 2 },
+    { "lnap", "\342\252\211", 3 },
+    { "rlm", "\342\200\217", 3 },
+    { "uhblk", "\342\226\200", 3 },
+    { "NotSucceedsEqual", "\342\252\260\314\270", 5 },
+    { "nsupseteqq", "\342\253\206\314\270", 5 },
+    { "YUcy", "\320\256", 2 },
+    { "plankv", "\342\204\217", 3 },
+    { "simeq", "\342\211\203", 3 },
+    { "cupcup", "\342\251\212", 3 },
+    { "wreath", "\342\211\200", 3 },
+    { "ecirc", "\303\252", 2 },
+    { "rsaquo", "\342\200\272", 3 },
+    { "frac78", "\342\205\236", 3 },
+    { "mopf", "\360\235\225\236", 4 },
+    { "preceq", "\342\252\257", 3 },
+    { "Square", "\342\226\241", 3 },
+    { "copf", "\360\235\225\224", 4 },
+    { "alefsym", "\342\204\265", 3 },
+    { "blk14", "\342\226\221", 3 },
+    { "LeftTriangle", "\342\212\262", 3 },
+    { "smt", "\342\252\252", 3 },
+    { "it", "\342\201\242", 3 },
+    { "scirc", "\305\235", 2 },
+    { "tau", "\317\204", 2 },
+    { "Yopf", "\360\235\225\220", 4 },
+    { "Oscr", "\360\235\222\252", 4 },
+    { "vangrt", "\342\246\234", 3 },
+    { "Iacute", "\303\215", 2 },
+    { "Itilde", "\304\250", 2 },
+    { "Jopf", "\360\235\225\201", 4 },
+    { "aopf", "\360\235\225\222", 4 },
+    { "nesear", "\342\244\250", 3 },
+    { "dHar", "\342\245\245", 3 },
+    { "lfr", "\360\235\224\251", 4 },
+    { "squarf", "\342\226\252", 3 },
+    { "tosa", "\342\244\251", 3 },
+    { "congdot", "\342\251\255", 3 },
+    { "reals", "\342\204\235", 3 },
+    { "otimesas", "\342\250\266", 3 },
+    { "female", "\342\231\200", 3 },
+    { "ldrdhar", "\342\245\247", 3 },
+    { "dopf", "\360\235\225\225", 4 },
+    { "Lcy", "\320\233", 2 },
+    { "leftarrow", "\342\206\220", 3 },
+    { "LeftVector", "\342\206\274", 3 },
+    { "Tcy", "\320\242", 2 },
+    { "dtdot", "\342\213\261", 3 },
+    { "gel", "\342\213\233", 3 },
+    { "Rightarrow", "\342\207\222", 3 },
+    { "deg", "\302\260", 2 },
+    { "TripleDot", "\342\203\233", 3 },
+    { "xnis", "\342\213\273", 3 },
+    { "equivDD", "\342\251\270", 3 },
+    { "RightTriangle", "\342\212\263", 3 },
+    { "Nscr", "\360\235\222\251", 4 },
+    { "LongLeftArrow", "\342\237\265", 3 },
+    { "bigvee", "\342\213\201", 3 },
+    { "integers", "\342\204\244", 3 },
+    { "vsubnE", "\342\253\213\357\270\200", 6 },
+    { "igrave", "\303\254", 2 },
+    { "aelig", "\303\246", 2 },
+    { "eplus", "\342\251\261", 3 },
+    { "HARDcy", "\320\252", 2 },
+    { "emacr", "\304\223", 2 },
+    { "hksearow", "\342\244\245", 3 },
+    { "boxUL", "\342\225\235", 3 },
+    { "yopf", "\360\235\225\252", 4 },
+    { "napprox", "\342\211\211", 3 },
+    { "nltrie", "\342\213\254", 3 },
+    { "heartsuit", "\342\231\245", 3 },
+    { "ShortUpArrow", "\342\206\221", 3 },
+    { "NJcy", "\320\212", 2 },
+    { "Lfr", "\360\235\224\217", 4 },
+    { "rthree", "\342\213\214", 3 },
+    { "LeftArrowRightArrow", "\342\207\206", 3 },
+    { "Scirc", "\305\234", 2 },
+    { "DoubleLeftTee", "\342\253\244", 3 },
+    { "nvgt", "\076\342\203\222", 4 },
+    { "aogon", "\304\205", 2 },
+    { "nless", "\342\211\256", 3 },
+    { "angmsdab", "\342\246\251", 3 },
+    { "andd", "\342\251\234", 3 },
+    { "Succeeds", "\342\211\273", 3 },
+    { "Vvdash", "\342\212\252", 3 },
+    { "osol", "\342\212\230", 3 },
+    { "ufr", "\360\235\224\262", 4 },
+    { "ulcorn", "\342\214\234", 3 },
+    { "bigcup", "\342\213\203", 3 },
+    { "bepsi", "\317\266", 2 },
+    { "midcir", "\342\253\260", 3 },
+    { "andand", "\342\251\225", 3 },
+    { "Larr", "\342\206\236", 3 },
+    { "backsimeq", "\342\213\215", 3 },
+    { "TSHcy", "\320\213", 2 },
+    { "lowbar", "\137", 1 },
+    { "NotSucceedsSlantEqual", "\342\213\241", 3 },
+    { "NestedGreaterGreater", "\342\211\253", 3 },
+    { "afr", "\360\235\224\236", 4 },
+    { "epsi", "\316\265", 2 },
+    { "Sigma", "\316\243", 2 },
+    { "yicy", "\321\227", 2 },
+    { "wedge", "\342\210\247", 3 },
+    { "ecaron", "\304\233", 2 },
+    { "eopf", "\360\235\225\226", 4 },
+    { "barwedge", "\342\214\205", 3 },
+    { "smallsetminus", "\342\210\226", 3 },
+    { "subsetneq", "\342\212\212", 3 },
+    { "lE", "\342\211\246", 3 },
+    { "Eopf", "\360\235\224\274", 4 },
+    { "rbbrk", "\342\235\263", 3 },
+    { "Jcirc", "\304\264", 2 },
+    { "hscr", "\360\235\222\275", 4 },
+    { "Int", "\342\210\254", 3 },
+    { "ohbar", "\342\246\265", 3 },
+    { "lmidot", "\305\200", 2 },
+    { "NotLessSlantEqual", "\342\251\275\314\270", 5 },
+    { "Escr", "\342\204\260", 3 },
+    { "precsim", "\342\211\276", 3 },
+    { "Eta", "\316\227", 2 },
+    { "nsubseteqq", "\342\253\205\314\270", 5 },
+    { "lessdot", "\342\213\226", 3 },
+    { "NestedLessLess", "\342\211\252", 3 },
+    { "amalg", "\342\250\277", 3 },
+    { "Qfr", "\360\235\224\224", 4 },
+    { "dblac", "\313\235", 2 },
+    { "nparsl", "\342\253\275\342\203\245", 6 },
+    { "Topf", "\360\235\225\213", 4 },
+    { "Yscr", "\360\235\222\264", 4 },
+    { "yfr", "\360\235\224\266", 4 },
+    { "elsdot", "\342\252\227", 3 },
+    { "tprime", "\342\200\264", 3 },
+    { "cups", "\342\210\252\357\270\200", 6 },
+    { "ecir", "\342\211\226", 3 },
+    { "nopf", "\360\235\225\237", 4 },
+    { "ncong", "\342\211\207", 3 },
+    { "bot", "\342\212\245", 3 },
+    { "vnsup", "\342\212\203\342\203\222", 6 },
+    { "LeftTriangleEqual", "\342\212\264", 3 },
+    { "rdquo", "\342\200\235", 3 },
+    { "subseteq", "\342\212\206", 3 },
+    { "CloseCurlyDoubleQuote", "\342\200\235", 3 },
+    { "mapsto", "\342\206\246", 3 },
+    { "OverBar", "\342\200\276", 3 },
+    { "CirclePlus", "\342\212\225", 3 },
+    { "roplus", "\342\250\256", 3 },
+    { "supsim", "\342\253\210", 3 },
+    { "supset", "\342\212\203", 3 },
+    { "apos", "\047", 1 },
+    { "not", "\302\254", 2 },
+    { "nldr", "\342\200\245", 3 },
+    { "ljcy", "\321\231", 2 },
+    { "Vdash", "\342\212\251", 3 },
+    { "iiint", "\342\210\255", 3 },
+    { "af", "\342\201\241", 3 },
+    { "approxeq", "\342\211\212", 3 },
+    { "ncup", "\342\251\202", 3 },
+    { "frac14", "\302\274", 2 },
+    { "permil", "\342\200\260", 3 },
+    { "prurel", "\342\212\260", 3 },
+    { "Cayleys", "\342\204\255", 3 },
+    { "UpArrowDownArrow", "\342\207\205", 3 },
+    { "ntriangleleft", "\342\213\252", 3 },
+    { "UnderBar", "\137", 1 },
+    { "xlArr", "\342\237\270", 3 },
+    { "thickapprox", "\342\211\210", 3 },
+    { "nearhk", "\342\244\244", 3 },
+    { "capcup", "\342\251\207", 3 },
+    { "lneqq", "\342\211\250", 3 },
+    { "lltri", "\342\227\272", 3 },
+    { "imof", "\342\212\267", 3 },
+    { "nmid", "\342\210\244", 3 },
+    { "nLtv", "\342\211\252\314\270", 5 },
+    { "supsub", "\342\253\224", 3 },
+    { "boxVH", "\342\225\254", 3 },
+    { "uplus", "\342\212\216", 3 },
+    { "incare", "\342\204\205", 3 },
+    { "telrec", "\342\214\225", 3 },
+    { "nGtv", "\342\211\253\314\270", 5 },
+    { "uHar", "\342\245\243", 3 },
+    { "spades", "\342\231\240", 3 },
+    { "brvbar", "\302\246", 2 },
+    { "rArr", "\342\207\222", 3 },
+    { "RightTriangleEqual", "\342\212\265", 3 },
+    { "mcomma", "\342\250\251", 3 },
+    { "Kfr", "\360\235\224\216", 4 },
+    { "odash", "\342\212\235", 3 },
+    { "SucceedsEqual", "\342\252\260", 3 },
+    { "DownLeftRightVector", "\342\245\220", 3 },
+    { "dwangle", "\342\246\246", 3 },
+    { "icirc", "\303\256", 2 },
+    { "Jscr", "\360\235\222\245", 4 },
+    { "Tilde", "\342\210\274", 3 },
+    { "varsupsetneqq", "\342\253\214\357\270\200", 6 },
+    { "Gbreve", "\304\236", 2 },
+    { "ropf", "\360\235\225\243", 4 },
+    { "bne", "\075\342\203\245", 4 },
+    { "llarr", "\342\207\207", 3 },
+    { "Pscr", "\360\235\222\253", 4 },
+    { "downharpoonleft", "\342\207\203", 3 },
+    { "nleqq", "\342\211\246\314\270", 5 },
+    { "Gcy", "\320\223", 2 },
+    { "Gammad", "\317\234", 2 },
+    { "lneq", "\342\252\207", 3 },
+    { "capdot", "\342\251\200", 3 },
+    { "Ncy", "\320\235", 2 },
+    { "OpenCurlyQuote", "\342\200\230", 3 },
+    { "nvsim", "\342\210\274\342\203\222", 6 },
+    { "xcirc", "\342\227\257", 3 },
+    { "divonx", "\342\213\207", 3 },
+    { "iacute", "\303\255", 2 },
+    { "ldca", "\342\244\266", 3 },
+    { "sscr", "\360\235\223\210", 4 },
+    { "suphsol", "\342\237\211", 3 },
+    { "precnsim", "\342\213\250", 3 },
+    { "NotSubsetEqual", "\342\212\210", 3 },
+    { "Downarrow", "\342\207\223", 3 },
+    { "frac35", "\342\205\227", 3 },
+    { "nrarr", "\342\206\233", 3 },
+    { "UpperLeftArrow", "\342\206\226", 3 },
+    { "rpar", "\051", 1 },
+    { "prec", "\342\211\272", 3 },
+    { "RoundImplies", "\342\245\260", 3 },
+    { "ecy", "\321\215", 2 },
+    { "nles", "\342\251\275\314\270", 5 },
+    { "angrtvbd", "\342\246\235", 3 },
+    { "niv", "\342\210\213", 3 },
+    { "ucirc", "\303\273", 2 },
+    { "vartriangleright", "\342\212\263", 3 },
+    { "iiota", "\342\204\251", 3 },
+    { "Edot", "\304\226", 2 },
+    { "olcross", "\342\246\273", 3 },
+    { "SHcy", "\320\250", 2 },
+    { "loplus", "\342\250\255", 3 },
+    { "EqualTilde", "\342\211\202", 3 },
+    { "angmsdaf", "\342\246\255", 3 },
+    { "mcy", "\320\274", 2 },
+    { "softcy", "\321\214", 2 },
+    { "napos", "\305\211", 2 },
+    { "Vopf", "\360\235\225\215", 4 },
+    { "Gcirc", "\304\234", 2 },
+    { "Darr", "\342\206\241", 3 },
+    { "submult", "\342\253\201", 3 },
+    { "lesdoto", "\342\252\201", 3 },
+    { "pm", "\302\261", 2 },
+    { "alpha", "\316\261", 2 },
+    { "daleth", "\342\204\270", 3 },
+    { "ddagger", "\342\200\241", 3 },
+    { "rsquor", "\342\200\231", 3 },
+    { "harrw", "\342\206\255", 3 },
+    { "plusb", "\342\212\236", 3 },
+    { "prnap", "\342\252\271", 3 },
+    { "rdldhar", "\342\245\251", 3 },
+    { "nsupE", "\342\253\206\314\270", 5 },
+    { "Xfr", "\360\235\224\233", 4 },
+    { "kscr", "\360\235\223\200", 4 },
+    { "boxur", "\342\224\224", 3 },
+    { "gtreqless", "\342\213\233", 3 },
+    { "subseteqq", "\342\253\205", 3 },
+    { "lacute", "\304\272", 2 },
+    { "perp", "\342\212\245", 3 },
+    { "nGt", "\342\211\253\342\203\222", 6 },
+    { "Vscr", "\360\235\222\261", 4 },
+    { "OElig", "\305\222", 2 },
+    { "diamondsuit", "\342\231\246", 3 },
+    { "npreceq", "\342\252\257\314\270", 5 },
+    { "xrArr", "\342\237\271", 3 },
+    { "nLl", "\342\213\230\314\270", 5 },
+    { "RightDownVectorBar", "\342\245\225", 3 },
+    { "curarr", "\342\206\267", 3 },
+    { "hbar", "\342\204\217", 3 },
+    { "nprec", "\342\212\200", 3 },
+    { "Ecirc", "\303\212", 2 },
+    { "ddarr", "\342\207\212", 3 },
+    { "ograve", "\303\262", 2 },
+    { "nRightarrow", "\342\207\217", 3 },
+    { "gjcy", "\321\223", 2 },
+    { "nvap", "\342\211\215\342\203\222", 6 },
+    { "RightUpTeeVector", "\342\245\234", 3 },
+    { "euro", "\342\202\254", 3 },
+    { "timesbar", "\342\250\261", 3 },
+    { "ReverseUpEquilibrium", "\342\245\257", 3 },
+    { "Gfr", "\360\235\224\212", 4 },
+    { "Zcy", "\320\227", 2 },
+    { "rharul", "\342\245\254", 3 },
+    { "varpi", "\317\226", 2 },
+    { "DoubleDot", "\302\250", 2 },
+    { "gesdotol", "\342\252\204", 3 },
+    { "uring", "\305\257", 2 },
+    { "lesseqqgtr", "\342\252\213", 3 },
+    { "iopf", "\360\235\225\232", 4 },
+    { "hercon", "\342\212\271", 3 },
+    { "napid", "\342\211\213\314\270", 5 },
+    { "cwint", "\342\210\261", 3 },
+    { "scnE", "\342\252\266", 3 },
+    { "RuleDelayed", "\342\247\264", 3 },
+    { "boxdr", "\342\224\214", 3 },
+    { "lharu", "\342\206\274", 3 },
+    { "dcaron", "\304\217", 2 },
+    { "veebar", "\342\212\273", 3 },
+    { "NotNestedGreaterGreater", "\342\252\242\314\270", 5 },
+    { "preccurlyeq", "\342\211\274", 3 },
+    { "Omacr", "\305\214", 2 },
+    { "triangledown", "\342\226\277", 3 },
+    { "boxuR", "\342\225\230", 3 },
+    { "dot", "\313\231", 2 },
+    { "Implies", "\342\207\222", 3 },
+    { "Theta", "\316\230", 2 },
+    { "gopf", "\360\235\225\230", 4 },
+    { "nsimeq", "\342\211\204", 3 },
+    { "bNot", "\342\253\255", 3 },
+    { "yscr", "\360\235\223\216", 4 },
+    { "succsim", "\342\211\277", 3 },
+    { "rhard", "\342\207\201", 3 },
+    { "leq", "\342\211\244", 3 },
+    { "dash", "\342\200\220", 3 },
+    { "vartriangleleft", "\342\212\262", 3 },
+    { "dscr", "\360\235\222\271", 4 },
+    { "pre", "\342\252\257", 3 },
+    { "DoubleLongRightArrow", "\342\237\271", 3 },
+    { "varpropto", "\342\210\235", 3 },
+    { "DoubleLeftRightArrow", "\342\207\224", 3 },
+    { "lessapprox", "\342\252\205", 3 },
+    { "angmsdac", "\342\246\252", 3 },
+    { "eqslantgtr", "\342\252\226", 3 },
+    { "real", "\342\204\234", 3 },
+    { "boxul", "\342\224\230", 3 },
+    { "rarrsim", "\342\245\264", 3 },
+    { "ngtr", "\342\211\257", 3 },
+    { "LowerLeftArrow", "\342\206\231", 3 },
+    { "nsce", "\342\252\260\314\270", 5 },
+    { "map", "\342\206\246", 3 },
+    { "nexist", "\342\210\204", 3 },
+    { "LeftDownVector", "\342\207\203", 3 },
+    { "fpartint", "\342\250\215", 3 },
+    { "Cedilla", "\302\270", 2 },
+    { "emsp", "\342\200\203", 3 },
+    { "prnE", "\342\252\265", 3 },
+    { "ShortRightArrow", "\342\206\222", 3 },
+    { "NotLeftTriangle", "\342\213\252", 3 },
+    { "ffr", "\360\235\224\243", 4 },
+    { "blacksquare", "\342\226\252", 3 },
+    { "angmsdae", "\342\246\254", 3 },
+    { "Rsh", "\342\206\261", 3 },
+    { "simplus", "\342\250\244", 3 },
+    { "infin", "\342\210\236", 3 },
+    { "ccaron", "\304\215", 2 },
+    { "ReverseEquilibrium", "\342\207\213", 3 },
+    { "Ncedil", "\305\205", 2 },
+    { "ExponentialE", "\342\205\207", 3 },
+    { "efDot", "\342\211\222", 3 },
+    { "lsh", "\342\206\260", 3 },
+    { "sup2", "\302\262", 2 },
+    { "Superset", "\342\212\203", 3 },
+    { "Omicron", "\316\237", 2 },
+    { "aacute", "\303\241", 2 },
+    { "hkswarow", "\342\244\246", 3 },
+    { "NonBreakingSpace", "\302\240", 2 },
+    { "Ntilde", "\303\221", 2 },
+    { "succapprox", "\342\252\270", 3 },
+    { "omid", "\342\246\266", 3 },
+    { "upharpoonleft", "\342\206\277", 3 },
+    { "Longrightarrow", "\342\237\271", 3 },
+    { "lrhar", "\342\207\213", 3 },
+    { "ltquest", "\342\251\273", 3 },
+    { "gla", "\342\252\245", 3 },
+    { "sqsup", "\342\212\220", 3 },
+    { "gimel", "\342\204\267", 3 },
+    { "gl", "\342\211\267", 3 },
+    { "capbrcup", "\342\251\211", 3 },
+    { "semi", "\073", 1 },
+    { "triplus", "\342\250\271", 3 },
+    { "lap", "\342\252\205", 3 },
+    { "Omega", "\316\251", 2 },
+    { "boxvR", "\342\225\236", 3 },
+    { "ltcc", "\342\252\246", 3 },
+    { "Upsilon", "\316\245", 2 },
+    { "ETH", "\303\220", 2 },
+    { "cfr", "\360\235\224\240", 4 },
+    { "UnionPlus", "\342\212\216", 3 },
+    { "boxDR", "\342\225\224", 3 },
+    { "gtrdot", "\342\213\227", 3 },
+    { "nsube", "\342\212\210", 3 },
+    { "egrave", "\303\250", 2 },
+    { "rarrb", "\342\207\245", 3 },
+    { "gscr", "\342\204\212", 3 },
+    { "planckh", "\342\204\216", 3 },
+    { "agrave", "\303\240", 2 },
+    { "ofr", "\360\235\224\254", 4 },
+    { "ddotseq", "\342\251\267", 3 },
+    { "odsold", "\342\246\274", 3 },
+    { "mstpos", "\342\210\276", 3 },
+    { "Qscr", "\360\235\222\254", 4 },
+    { "precapprox", "\342\252\267", 3 },
+    { "lowast", "\342\210\227", 3 },
+    { "boxtimes", "\342\212\240", 3 },
+    { "NotSucceedsTilde", "\342\211\277\314\270", 5 },
+    { "ForAll", "\342\210\200", 3 },
+    { "dcy", "\320\264", 2 },
+    { "odiv", "\342\250\270", 3 },
+    { "tscr", "\360\235\223\211", 4 },
+    { "rarr", "\342\206\222", 3 },
+    { "angst", "\303\205", 2 },
+    { "ltlarr", "\342\245\266", 3 },
+    { "Barv", "\342\253\247", 3 },
+    { "VDash", "\342\212\253", 3 },
+    { "larrfs", "\342\244\235", 3 },
+    { "updownarrow", "\342\206\225", 3 },
+    { "thinsp", "\342\200\211", 3 },
+    { "lhblk", "\342\226\204", 3 },
+    { "Dcy", "\320\224", 2 },
+    { "rfisht", "\342\245\275", 3 },
+    { "Mopf", "\360\235\225\204", 4 },
+    { "LongLeftRightArrow", "\342\237\267", 3 },
+    { "simgE", "\342\252\240", 3 },
+    { "Updownarrow", "\342\207\225", 3 },
+    { "numsp", "\342\200\207", 3 },
+    { "rightleftharpoons", "\342\207\214", 3 },
+    { "UnderParenthesis", "\342\217\235", 3 },
+    { "Vert", "\342\200\226", 3 },
+    { "varsubsetneqq", "\342\253\213\357\270\200", 6 },
+    { "lscr", "\360\235\223\201", 4 },
+    { "sfrown", "\342\214\242", 3 },
+    { "UpperRightArrow", "\342\206\227", 3 },
+    { "spadesuit", "\342\231\240", 3 },
+    { "pi", "\317\200", 2 },
+    { "Bopf", "\360\235\224\271", 4 },
+    { "ocir", "\342\212\232", 3 },
+    { "lsqb", "\133", 1 },
+    { "lmoustache", "\342\216\260", 3 },
+    { "loarr", "\342\207\275", 3 },
+    { "succ", "\342\211\273", 3 },
+    { "Supset", "\342\213\221", 3 },
+    { "boxhD", "\342\225\245", 3 },
+    { "drbkarow", "\342\244\220", 3 },
+    { "eacute", "\303\251", 2 },
+    { "nlt", "\342\211\256", 3 },
+    { "lang", "\342\237\250", 3 },
+    { "NoBreak", "\342\201\240", 3 },
+    { "rangd", "\342\246\222", 3 },
+    { "weierp", "\342\204\230", 3 },
+    { "DownArrow", "\342\206\223", 3 },
+    { "cent", "\302\242", 2 },
+    { "leftharpoondown", "\342\206\275", 3 },
+    { "Equal", "\342\251\265", 3 },
+    { "pluscir", "\342\250\242", 3 },
+    { "MinusPlus", "\342\210\223", 3 },
+    { "curlywedge", "\342\213\217", 3 },
+    { "prsim", "\342\211\276", 3 },
+    { "angzarr", "\342\215\274", 3 },
+    { "apacir", "\342\251\257", 3 },
+    { "solb", "\342\247\204", 3 },
+    { "varnothing", "\342\210\205", 3 },
+    { "larrpl", "\342\244\271", 3 },
+    { "nesim", "\342\211\202\314\270", 5 },
+    { "Lang", "\342\237\252", 3 },
+    { "nacute", "\305\204", 2 },
+    { "half", "\302\275", 2 },
+    { "vArr", "\342\207\225", 3 },
+    { "imagline", "\342\204\220", 3 },
+    { "plussim", "\342\250\246", 3 },
+    { "Ccedil", "\303\207", 2 },
+    { "wscr", "\360\235\223\214", 4 },
+    { "NotLessTilde", "\342\211\264", 3 },
+    { "RightDownTeeVector", "\342\245\235", 3 },
+    { "Tau", "\316\244", 2 },
+    { "vltri", "\342\212\262", 3 },
+    { "gammad", "\317\235", 2 },
+    { "upsi", "\317\205", 2 },
+    { "thorn", "\303\276", 2 },
+    { "gbreve", "\304\237", 2 },
+    { "par", "\342\210\245", 3 },
+    { "hoarr", "\342\207\277", 3 },
+    { "ubrcy", "\321\236", 2 },
+    { "DoubleUpDownArrow", "\342\207\225", 3 },
+    { "tscy", "\321\206", 2 },
+    { "ycy", "\321\213", 2 },
+    { "LeftUpVector", "\342\206\277", 3 },
+    { "popf", "\360\235\225\241", 4 },
+    { "Rcy", "\320\240", 2 },
+    { "NotHumpDownHump", "\342\211\216\314\270", 5 },
+    { "period", "\056", 1 },
+    { "nsim", "\342\211\201", 3 },
+    { "quaternions", "\342\204\215", 3 },
+    { "zcaron", "\305\276", 2 },
+    { "becaus", "\342\210\265", 3 },
+    { "ENG", "\305\212", 2 },
+    { "boxUl", "\342\225\234", 3 },
+    { "Lopf", "\360\235\225\203", 4 },
+    { "starf", "\342\230\205", 3 },
+    { "xutri", "\342\226\263", 3 },
+    { "SmallCircle", "\342\210\230", 3 },
+    { "vsubne", "\342\212\212\357\270\200", 6 },
+    { "uArr", "\342\207\221", 3 },
+    { "there4", "\342\210\264", 3 },
+    { "Utilde", "\305\250", 2 },
+    { "boxHd", "\342\225\244", 3 },
+    { "veeeq", "\342\211\232", 3 },
+    { "NotSucceeds", "\342\212\201", 3 },
+    { "ltimes", "\342\213\211", 3 },
+    { "LeftUpVectorBar", "\342\245\230", 3 },
+    { "Ycy", "\320\253", 2 },
+    { "Ocirc", "\303\224", 2 },
+    { "PlusMinus", "\302\261", 2 },
+    { "NewLine", "\012", 1 },
+    { "NotSquareSuperset", "\342\212\220\314\270", 5 },
+    { "Laplacetrf", "\342\204\222", 3 },
+    { "sharp", "\342\231\257", 3 },
+    { "tbrk", "\342\216\264", 3 },
+    { "ne", "\342\211\240", 3 },
+    { "notinvb", "\342\213\267", 3 },
+    { "npar", "\342\210\246", 3 },
+    { "backcong", "\342\211\214", 3 },
+    { "nges", "\342\251\276\314\270", 5 },
+    { "boxvH", "\342\225\252", 3 },
+    { "caret", "\342\201\201", 3 },
+    { "Xi", "\316\236", 2 },
+    { "Pfr", "\360\235\224\223", 4 },
+    { "clubs", "\342\231\243", 3 },
+    { "Mscr", "\342\204\263", 3 },
+    { "cuwed", "\342\213\217", 3 },
+    { "Ascr", "\360\235\222\234", 4 },
+    { "mDDot", "\342\210\272", 3 },
+    { "frac38", "\342\205\234", 3 },
+    { "leqslant", "\342\251\275", 3 },
+    { "rsquo", "\342\200\231", 3 },
+    { "lesdot", "\342\251\277", 3 },
+    { "Kcy", "\320\232", 2 },
+    { "NotNestedLessLess", "\342\252\241\314\270", 5 },
+    { "Hcirc", "\304\244", 2 },
+    { "cuvee", "\342\213\216", 3 },
+    { "rightthreetimes", "\342\213\214", 3 },
+    { "UnderBracket", "\342\216\265", 3 },
+    { "NotDoubleVerticalBar", "\342\210\246", 3 },
+    { "Integral", "\342\210\253", 3 },
+    { "fltns", "\342\226\261", 3 },
+    { "bopf", "\360\235\225\223", 4 },
+    { "eogon", "\304\231", 2 },
+    { "RightFloor", "\342\214\213", 3 },
+    { "dotminus", "\342\210\270", 3 },
+    { "DownBreve", "\314\221", 2 },
+    { "kgreen", "\304\270", 2 },
+    { "Union", "\342\213\203", 3 },
+    { "smile", "\342\214\243", 3 },
+    { "sqcaps", "\342\212\223\357\270\200", 6 },
+    { "chcy", "\321\207", 2 },
+    { "luruhar", "\342\245\246", 3 },
+    { "kappav", "\317\260", 2 },
+    { "lobrk", "\342\237\246", 3 },
+    { "bernou", "\342\204\254", 3 },
+    { "TildeFullEqual", "\342\211\205", 3 },
+    { "Product", "\342\210\217", 3 },
+    { "rscr", "\360\235\223\207", 4 },
+    { "Igrave", "\303\214", 2 },
+    { "vellip", "\342\213\256", 3 },
+    { "CHcy", "\320\247", 2 },
+    { "Xopf", "\360\235\225\217", 4 },
+    { "iocy", "\321\221", 2 },
+    { "ohm", "\316\251", 2 },
+    { "npolint", "\342\250\224", 3 },
+    { "phmmat", "\342\204\263", 3 },
+    { "Exists", "\342\210\203", 3 },
+    { "plus", "\053", 1 },
+    { "shy", "\302\255", 2 },
+    { "bsolb", "\342\247\205", 3 },
+    { "imath", "\304\261", 2 },
+    { "nhpar", "\342\253\262", 3 },
+    { "bsim", "\342\210\275", 3 },
+    { "sopf", "\360\235\225\244", 4 },
+    { "curarrm", "\342\244\274", 3 },
+    { "nwarrow", "\342\206\226", 3 },
+    { "rAarr", "\342\207\233", 3 },
+    { "nvlt", "\074\342\203\222", 4 },
+    { "notnivc", "\342\213\275", 3 },
+    { "divideontimes", "\342\213\207", 3 },
+    { "vcy", "\320\262", 2 },
+    { "lesseqgtr", "\342\213\232", 3 },
+    { "trpezium", "\342\217\242", 3 },
+    { "geqq", "\342\211\247", 3 },
+    { "oror", "\342\251\226", 3 },
+    { "num", "\043", 1 },
+    { "uparrow", "\342\206\221", 3 },
+    { "Rrightarrow", "\342\207\233", 3 },
+    { "aring", "\303\245", 2 },
+    { "zeta", "\316\266", 2 },
+    { "LeftArrow", "\342\206\220", 3 },
+    { "nang", "\342\210\240\342\203\222", 6 },
+    { "LeftAngleBracket", "\342\237\250", 3 },
+    { "Barwed", "\342\214\206", 3 },
+    { "ensp", "\342\200\202", 3 },
+    { "ZHcy", "\320\226", 2 },
+    { "larrhk", "\342\206\251", 3 },
+    { "pfr", "\360\235\224\255", 4 },
+    { "Cup", "\342\213\223", 3 },
+    { "VerticalBar", "\342\210\243", 3 },
+    { "nprcue", "\342\213\240", 3 },
+    { "prcue", "\342\211\274", 3 },
+    { "LeftTeeVector", "\342\245\232", 3 },
+    { "sccue", "\342\211\275", 3 },
+    { "Kcedil", "\304\266", 2 },
+    { "mho", "\342\204\247", 3 },
+    { "Tstrok", "\305\246", 2 },
+    { "DownArrowUpArrow", "\342\207\265", 3 },
+    { "cedil", "\302\270", 2 },
+    { "ac", "\342\210\276", 3 },
+    { "PartialD", "\342\210\202", 3 },
+    { "ldsh", "\342\206\262", 3 },
+    { "NotGreaterLess", "\342\211\271", 3 },
+    { "nrArr", "\342\207\217", 3 },
+    { "oint", "\342\210\256", 3 },
+    { "Uscr", "\360\235\222\260", 4 },
+    { "cylcty", "\342\214\255", 3 },
+    { "fallingdotseq", "\342\211\222", 3 },
+    { "lg", "\342\211\266", 3 },
+    { "leftarrowtail", "\342\206\242", 3 },
+    { "OverBracket", "\342\216\264", 3 },
+    { "tint", "\342\210\255", 3 },
+    { "hellip", "\342\200\246", 3 },
+    { "Sopf", "\360\235\225\212", 4 },
+    { "male", "\342\231\202", 3 },
+    { "udhar", "\342\245\256", 3 },
+    { "searr", "\342\206\230", 3 },
+    { "notinE", "\342\213\271\314\270", 5 },
+    { "NotGreaterEqual", "\342\211\261", 3 },
+    { "eqcolon", "\342\211\225", 3 },
+    { "nparallel", "\342\210\246", 3 },
+    { "ell", "\342\204\223", 3 },
+    { "smeparsl", "\342\247\244", 3 },
+    { "Nopf", "\342\204\225", 3 },
+    { "xcap", "\342\213\202", 3 },
+    { "jopf", "\360\235\225\233", 4 },
+    { "uuml", "\303\274", 2 },
+    { "ast", "\052", 1 },
+    { "rceil", "\342\214\211", 3 },
+    { "CapitalDifferentialD", "\342\205\205", 3 },
+    { "tcy", "\321\202", 2 },
+    { "cong", "\342\211\205", 3 },
+    { "Lleftarrow", "\342\207\232", 3 },
+    { "Zscr", "\360\235\222\265", 4 },
+    { "lbarr", "\342\244\214", 3 },
+    { "nwarhk", "\342\244\243", 3 },
+    { "DoubleVerticalBar", "\342\210\245", 3 },
+    { "erDot", "\342\211\223", 3 },
+    { "hookrightarrow", "\342\206\252", 3 },
+    { "NotRightTriangle", "\342\213\253", 3 },
+    { "laemptyv", "\342\246\264", 3 },
+    { "efr", "\360\235\224\242", 4 },
+    { "supnE", "\342\253\214", 3 },
+    { "lcy", "\320\273", 2 },
+    { "wfr", "\360\235\224\264", 4 },
+    { "ordf", "\302\252", 2 },
+    { "boxVl", "\342\225\242", 3 },
+    { "profalar", "\342\214\256", 3 },
+    { "Bfr", "\360\235\224\205", 4 },
+    { "ssmile", "\342\214\243", 3 },
+    { "geqslant", "\342\251\276", 3 },
+    { "blk12", "\342\226\222", 3 },
+    { "Fscr", "\342\204\261", 3 },
+    { "Tscr", "\360\235\222\257", 4 },
+    { "dstrok", "\304\221", 2 },
+    { "ofcir", "\342\246\277", 3 },
+    { "frac13", "\342\205\223", 3 },
+    { "jfr", "\360\235\224\247", 4 },
+    { "jmath", "\310\267", 2 },
+    { "Abreve", "\304\202", 2 },
+    { "cupor", "\342\251\205", 3 },
+    { "tdot", "\342\203\233", 3 },
+    { "DiacriticalAcute", "\302\264", 2 },
+    { "Oslash", "\303\230", 2 },
+    { "raquo", "\302\273", 2 },
+    { "cuesc", "\342\213\237", 3 },
+    { "emptyset", "\342\210\205", 3 },
+    { "DotDot", "\342\203\234", 3 },
+    { "blk34", "\342\226\223", 3 },
+    { "exponentiale", "\342\205\207", 3 },
+    { "simrarr", "\342\245\262", 3 },
+    { "NotLeftTriangleEqual", "\342\213\254", 3 },
+    { "rarrpl", "\342\245\205", 3 },
+    { "nharr", "\342\206\256", 3 },
+    { "zhcy", "\320\266", 2 },
+    { "parsim", "\342\253\263", 3 },
+    { "beta", "\316\262", 2 },
+    { "Ucirc", "\303\233", 2 },
+    { "edot", "\304\227", 2 },
+    { "gesdoto", "\342\252\202", 3 },
+    { "ffilig", "\357\254\203", 3 },
+    { "nsubseteq", "\342\212\210", 3 },
+    { "opar", "\342\246\267", 3 },
+    { "xwedge", "\342\213\200", 3 },
+    { "Backslash", "\342\210\226", 3 },
+    { "orderof", "\342\204\264", 3 },
+    { "upsih", "\317\222", 2 },
+    { "drcorn", "\342\214\237", 3 },
+    { "empty", "\342\210\205", 3 },
+    { "blacktriangledown", "\342\226\276", 3 },
+    { "MediumSpace", "\342\201\237", 3 },
+    { "UnderBrace", "\342\217\237", 3 },
+    { "ngsim", "\342\211\265", 3 },
+    { "ucy", "\321\203", 2 },
+    { "Ropf", "\342\204\235", 3 },
+    { "ShortDownArrow", "\342\206\223", 3 },
+    { "Imacr", "\304\252", 2 },
+    { "subedot", "\342\253\203", 3 },
+    { "utrif", "\342\226\264", 3 },
+    { "mumap", "\342\212\270", 3 },
+    { "larrtl", "\342\206\242", 3 },
+    { "SuchThat", "\342\210\213", 3 },
+    { "circledast", "\342\212\233", 3 },
+    { "emsp13", "\342\200\204", 3 },
+    { "boxV", "\342\225\221", 3 },
+    { "Cfr", "\342\204\255", 3 },
+    { "rcaron", "\305\231", 2 },
+    { "ltrPar", "\342\246\226", 3 },
+    { "vfr", "\360\235\224\263", 4 },
+    { "frac34", "\302\276", 2 },
+    { "prop", "\342\210\235", 3 },
+    { "expectation", "\342\204\260", 3 },
+    { "prime", "\342\200\262", 3 },
+    { "Vbar", "\342\253\253", 3 },
+    { "ges", "\342\251\276", 3 },
+    { "rarrtl", "\342\206\243", 3 },
+    { "ldquo", "\342\200\234", 3 },
+    { "hardcy", "\321\212", 2 },
+    { "nrarrw", "\342\206\235\314\270", 5 },
+    { "xscr", "\360\235\223\215", 4 },
+    { "LeftDoubleBracket", "\342\237\246", 3 },
+    { "realpart", "\342\204\234", 3 },
+    { "breve", "\313\230", 2 },
+    { "nrarrc", "\342\244\263\314\270", 5 },
+    { "boxdR", "\342\225\222", 3 },
+    { "Hat", "\136", 1 },
+    { "uuarr", "\342\207\210", 3 },
+    { "CenterDot", "\302\267", 2 },
+    { "LeftUpDownVector", "\342\245\221", 3 },
+    { "lsaquo", "\342\200\271", 3 },
+    { "twoheadrightarrow", "\342\206\240", 3 },
+    { "ggg", "\342\213\231", 3 },
+    { "supseteqq", "\342\253\206", 3 },
+    { "nlArr", "\342\207\215", 3 },
+    { "rotimes", "\342\250\265", 3 },
+    { "Tcaron", "\305\244", 2 },
+    { "lsquor", "\342\200\232", 3 },
+    { "caron", "\313\207", 2 },
+    { "ndash", "\342\200\223", 3 },
+    { "eqslantless", "\342\252\225", 3 },
+    { "beth", "\342\204\266", 3 },
+    { "CircleTimes", "\342\212\227", 3 },
+    { "intercal", "\342\212\272", 3 },
+    { "GreaterEqualLess", "\342\213\233", 3 },
+    { "NotTildeEqual", "\342\211\204", 3 },
+    { "minusb", "\342\212\237", 3 },
+    { "cuepr", "\342\213\236", 3 },
+    { "Because", "\342\210\265", 3 },
+    { "ltdot", "\342\213\226", 3 },
+    { "cross", "\342\234\227", 3 },
+    { "swarrow", "\342\206\231", 3 },
+    { "twoheadleftarrow", "\342\206\236", 3 },
+    { "race", "\342\210\275\314\261", 5 },
+    { "OverBrace", "\342\217\236", 3 },
+    { "lcub", "\173", 1 },
+    { "urcrop", "\342\214\216", 3 },
+};
+
+static const unsigned short htmlEntitySeeds[HTML_ENTITY_COUNT] =
+{
+    7, 8, 0, 5, 3, 5, 1, 1, 0, 1, 0, 0,
+    1, 1, 0, 5, 0, 0, 1, 0, 0, 5, 0, 4,
+    4, 0, 1, 0, 3, 0, 4, 0, 3, 1, 50, 6,
+    1, 0, 0, 1, 3, 0, 10, 0, 1, 2, 1, 3,
+    0, 0, 0, 1, 1, 1, 1, 2, 0, 0, 1, 2,
+    7, 0, 0, 0, 4, 1, 2, 0, 8, 0, 1, 1,
+    0, 1, 7, 0, 3, 1, 0, 1, 4, 0, 4, 3,
+    0, 0, 0, 1, 0, 3, 1, 2, 1, 1, 0, 3,
+    0, 8, 4, 2, 1, 1, 3, 2, 2, 2, 2, 2,
+    1, 0, 2, 3, 1, 2, 0, 2, 1, 0, 0, 1,
+    2, 0, 0, 1, 8, 4, 9, 10, 0, 3, 1, 4,
+    1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 2, 1,
+    0, 3, 0, 0, 0, 1, 0, 10, 0, 2, 0, 4,
+    2, 0, 1, 1, 0, 1, 1, 4, 0, 1, 2, 0,
+    1, 0, 1, 0, 0, 6, 1, 0, 4, 0, 0, 1,
+    0, 0, 1, 0, 1, 3, 1, 2, 1, 2, 1, 1,
+    1, 8, 0, 3, 1, 4, 1, 0, 0, 0, 2, 5,
+    1, 0, 13, 0, 0, 1, 0, 2, 0, 1, 7, 4,
+    3, 1, 2, 1, 0, 3, 0, 0, 0, 1, 4, 1,
+    0, 0, 1, 2, 1, 1, 2, 0, 0, 1, 2, 4,
+    9, 0, 0, 0, 0, 1, 0, 5, 3, 3, 1, 9,
+    2, 1, 1, 0, 0, 3, 3, 2, 17, 1, 6, 0,
+    2, 4, 5, 2, 1, 3, 0, 0, 1, 1, 1, 13,
+    0, 0, 1, 0, 0, 1, 6, 1, 1, 0, 6, 0,
+    0, 2, 1, 2, 3, 0, 3, 0, 3, 0, 2, 0,
+    4, 0, 0, 1, 1, 2, 5, 67, 65, 11, 1, 1,
+    0, 0, 1, 4, 0, 1, 7, 5, 0, 4, 2, 0,
+    3, 1, 1, 2, 1, 2, 0, 0, 1, 1, 1, 1,
+    0, 1, 7, 10, 1, 4, 1, 3, 3, 1, 0, 13,
+    0, 6, 0, 0, 8, 0, 3, 2, 1, 4, 0, 0,
+    1, 26, 2, 3, 0, 2, 0, 6, 0, 10, 0, 0,
+    0, 2, 0, 1, 0, 3, 8, 0, 1, 1, 1, 66,
+    5, 1, 6, 2, 2, 0, 1, 1, 0, 3, 43, 0,
+    0, 15, 2, 1, 1, 0, 3, 2, 0, 1, 6, 1,
+    0, 0, 7, 2, 0, 1, 1, 1, 0, 3, 2, 1,
+    1, 1, 0, 0, 0, 1, 6, 19, 2, 0, 9, 68,
+    19, 1, 1, 0, 0, 0, 2, 69, 0, 2, 5, 1,
+    0, 3, 2, 3, 71, 4, 76, 0, 1, 1, 0, 7,
+    2, 0, 2, 3, 0, 0, 0, 3, 2, 0, 0, 1,
+    0, 0, 2, 1, 1, 1, 0, 0, 6, 3, 0, 0,
+    1, 2, 2, 11, 0, 1, 1, 3, 0, 1, 1, 0,
+    0, 2, 3, 0, 6, 0, 0, 0, 0, 0, 0, 3,
+    7, 2, 0, 0, 5, 1, 4, 1, 0, 0, 5, 0,
+    0, 8, 5, 1, 1, 0, 0, 0, 0, 2, 1, 6,
+    0, 1, 13, 8, 0, 0, 3, 2, 4, 1, 0, 2,
+    0, 0, 1, 0, 1, 4, 3, 64, 1, 0, 0, 6,
+    1, 1, 0, 0, 1, 0, 2, 2, 5, 2, 2, 2,
+    1, 0, 1, 0, 6, 2, 8, 1, 0, 3, 3, 0,
+    4, 68, 1, 4, 4, 2, 0, 0, 9, 3, 3, 8,
+    1, 0, 0, 3, 6, 3, 5, 1, 2, 0, 0, 6,
+    7, 0, 0, 0, 0, 7, 4, 0, 2, 1, 1, 0,
+    1, 3, 0, 0, 0, 0, 2, 3, 1, 0, 1, 0,
+    3, 57, 2, 1, 0, 0, 7, 6, 0, 0, 3, 0,
+    3, 0, 0, 2, 3, 0, 0, 1, 0, 1, 5, 0,
+    6, 3, 64, 0, 0, 0, 0, 3, 5, 3, 0, 1,
+    0, 6, 7, 64, 1, 1, 0, 3, 3, 2, 6, 3,
+    1, 1, 11, 0, 0, 0, 2, 3, 3, 1, 1, 0,
+    0, 5, 1, 0, 1, 1, 0, 1, 10, 0, 0, 0,
+    0, 42, 0, 0, 3, 2, 0, 1, 2, 1, 0, 8,
+    4, 8, 3, 1, 9, 3, 3, 0, 1, 0, 4, 5,
+    2, 1, 1, 0, 1, 0, 0, 4, 3, 1, 0, 65,
+    1, 1, 0, 1, 0, 1, 1, 1, 3, 0, 0, 69,
+    3, 1, 2, 1, 0, 2, 1, 1, 1, 6, 0, 2,
+    4, 0, 1, 0, 5, 0, 0, 0, 1, 0, 7, 4,
+    0, 0, 1, 6, 0, 4, 3, 2, 4, 0, 4, 0,
+    1, 1, 4, 4, 0, 8, 16, 5, 3, 0, 2, 5,
+    0, 0, 0, 2, 1, 5, 4, 0, 7, 2, 4, 0,
+    0, 0, 1, 2, 1, 1, 1, 0, 0, 66, 1, 6,
+    7, 1, 0, 2, 0, 1, 4, 5, 1, 4, 4, 0,
+    6, 4, 1, 4, 3, 1, 0, 0, 2, 0, 1, 0,
+    0, 2, 1, 0, 1, 1, 11, 1, 0, 6, 0, 5,
+    2, 7, 1, 26, 0, 18, 0, 1, 0, 0, 4, 2,
+    2, 7, 2, 15, 1, 0, 0, 0, 2, 1, 3, 0,
+    0, 2, 1, 2, 1, 68, 0, 0, 0, 0, 4, 0,
+    3, 4, 5, 0, 0, 0, 0, 0, 0, 0, 3, 7,
+    0, 0, 0, 0, 2, 2, 0, 11, 2, 2, 1, 3,
+    65, 3, 6, 3, 0, 0, 0, 12, 65, 2, 0, 4,
+    1, 70, 3, 1, 1, 3, 4, 2, 3, 5, 72, 0,
+    0, 0, 16, 1, 3, 6, 0, 2, 1, 6, 1, 0,
+    0, 1, 1, 1, 15, 0, 5, 0, 0, 1, 76, 0,
+    0, 1, 2, 1, 7, 0, 68, 1, 0, 0, 5, 5,
+    1, 1, 0, 9, 2, 0, 0, 0, 9, 0, 2, 0,
+    0, 0, 0, 72, 0, 1, 11, 4, 5, 0, 0, 2,
+    5, 1, 5, 0, 0, 1, 0, 0, 2, 0, 0, 2,
+    0, 5, 6, 0, 0, 71, 3, 2, 4, 0, 2, 3,
+    0, 2, 3, 8, 8, 2, 2, 3, 0, 2, 0, 0,
+    0, 0, 0, 8, 0, 1, 6, 0, 0, 3, 0, 3,
+    0, 74, 0, 85, 1, 1, 1, 1, 0, 1, 0, 1,
+    0, 0, 1, 2, 5, 8, 1, 5, 1, 1, 11, 4,
+    4, 94, 0, 1, 0, 0, 3, 0, 1, 1, 10, 11,
+    2, 3, 5, 6, 0, 7, 8, 1, 2, 0, 0, 8,
+    3, 13, 108, 1, 7, 0, 0, 0, 0, 3, 6, 1,
+    0, 0, 15, 1, 1, 0, 0, 0, 1, 0, 5, 12,
+    0, 1, 2, 2, 0, 7, 1, 3, 24, 4, 0, 0,
+    7, 2, 24, 16, 0, 1, 7, 1, 2, 5, 120, 1,
+    0, 0, 2, 0, 1, 68, 1, 1, 13, 0, 5, 0,
+    2, 1, 0, 0, 0, 7, 0, 0, 0, 0, 3, 3,
+    0, 18, 6, 2, 1, 1, 4, 106, 0, 11, 0, 7,
+    1, 12, 1, 12, 6, 0, 0, 0, 0, 4, 17, 0,
+    0, 0, 0, 1, 2, 2, 0, 67, 0, 0, 0, 1,
+    3, 14, 2, 0, 11, 1, 2, 0, 141, 1, 0, 1,
+    0, 0, 1, 2, 1, 0, 0, 2, 0, 0, 0, 0,
+    2, 17, 0, 4, 134, 0, 7, 1, 13, 0, 3, 3,
+    4, 0, 1, 0, 2, 0, 0, 0, 0, 3, 10, 7,
+    0, 7, 5, 0, 0, 18, 3, 3, 6, 0, 0, 7,
+    4, 0, 1, 8, 0, 1, 3, 1, 0, 81, 0, 0,
+    0, 9, 66, 6, 2, 4, 0, 1, 2, 4, 34, 0,
+    0, 3, 2, 4, 10, 48, 5, 6, 1, 22, 0, 0,
+    9, 10, 1, 1, 1, 0, 2, 1, 19, 0, 0, 9,
+    1, 8, 1, 1, 3, 15, 0, 6, 0, 7, 1, 0,
+    3, 21, 0, 6, 18, 2, 0, 8, 0, 1, 0, 5,
+    0, 0, 2, 16, 14, 2, 9, 0, 6, 0, 0, 1,
+    27, 6, 2, 4, 1, 0, 0, 0, 3, 2, 4, 4,
+    0, 3, 2, 36, 0, 0, 7, 2, 1, 8, 0, 129,
+    2, 0, 0, 4, 0, 1, 6, 0, 0, 8, 0, 0,
+    0, 12, 3, 5, 1, 0, 1, 1, 9, 129, 31, 14,
+    0, 3, 1, 0, 0, 2, 15, 0, 1, 3, 15, 0,
+    0, 0, 2, 84, 4, 0, 9, 18, 0, 12, 0, 1,
+    1, 12, 1, 11, 1, 0, 8, 1, 10, 0, 0, 0,
+    0, 1, 0, 0, 0, 8, 32, 1, 8, 3, 0, 1,
+    13, 0, 13, 0, 0, 4, 0, 0, 25, 0, 1, 0,
+    0, 18, 1, 1, 16, 17, 7, 0, 0, 0, 12, 67,
+    0, 0, 0, 0, 128, 3, 89, 29, 2, 167, 0, 2,
+    11, 31, 0, 6, 4, 128, 0, 6, 19, 1, 0, 2,
+    40, 91, 2, 1, 4, 12, 0, 65, 13, 0, 0, 0,
+    0, 4, 0, 6, 5, 3, 4, 0, 0, 0, 1, 2,
+    0, 0, 0, 0, 70, 42, 10, 23, 3, 0, 0, 0,
+    13, 20, 0, 17, 0, 2, 118, 69, 16, 4, 0, 22,
+    0, 0, 0, 20, 67, 4, 18, 0, 0, 4, 19, 1,
+    15, 0, 7, 15, 1, 0, 10, 0, 26, 5, 20, 14,
+    3, 0, 1, 1, 72, 0, 1, 1, 2, 13, 0, 0,
+    0, 18, 29, 0, 0, 0, 157, 170, 0, 6, 9, 17,
+    25, 3, 0, 47, 16, 29, 7, 0, 8, 0, 0, 4,
+    0, 102, 0, 0, 3, 0, 34, 10, 4, 0, 6, 32,
+    24, 0, 4, 0, 1, 25, 41, 2, 0, 128, 141, 2,
+    9, 3, 8, 0, 3, 2, 6, 0, 9, 9, 0, 0,
+    0, 0, 0, 0, 97, 1, 1, 10, 161, 0, 3, 4,
+    0, 0, 24, 0, 1, 2, 0, 2, 4, 22, 0, 0,
+    0, 5, 0, 11, 0, 0, 10, 24, 2, 0, 0, 0,
+    0, 3, 4, 7, 1, 25, 3, 0, 0, 1, 3, 0,
+    63, 6, 17, 5, 0, 11, 0, 0, 0, 12, 2, 2,
+    0, 162, 9, 31, 2, 4, 1, 2, 12, 3, 0, 3,
+    192, 0, 0, 18, 7, 4, 2, 8, 1, 5, 2, 0,
+    12, 2, 0, 0, 0, 0, 59, 0, 0, 0, 0, 2,
+    0, 3, 0, 4, 2, 1, 180, 0, 6, 24, 0, 0,
+    0, 2, 198, 0, 0, 1, 15, 0, 13, 23, 1, 19,
+    217, 12, 1, 0, 1, 0, 21, 2, 4, 0, 3, 0,
+    37, 11, 0, 0, 15, 38, 1, 0, 52, 0, 17, 2,
+    3, 16, 0, 2, 62, 15, 2, 22, 54, 1, 0, 0,
+    45, 12, 0, 5, 11, 0, 0, 0, 2, 0, 0, 5,
+    0, 0, 0, 14, 10, 3, 22, 0, 0, 0, 1, 14,
+    2, 68, 0, 0, 192, 7, 30, 1, 1, 4, 12, 0,
+    0, 16, 66, 0, 0, 0, 0, 9, 28, 0, 0, 20,
+    14, 0, 14, 0, 4, 28, 2, 135, 14, 0, 0, 0,
+    0, 1, 2, 17, 5, 25, 0, 0, 12, 0, 3, 2,
+    10, 66, 0, 3, 45, 0, 0, 0, 19, 0, 70, 0,
+    1, 0, 0, 1, 0, 10, 0, 13, 0, 71, 1, 2,
+    2, 29, 12, 0, 29, 0, 162, 31, 112, 0, 25, 0,
+    0, 0, 81, 9, 192, 1, 0, 9, 0, 0, 20, 0,
+    3, 3, 0, 102, 0, 0, 0, 0, 64, 0, 3, 0,
+    83, 25, 0, 0, 89, 12, 59, 0, 0, 4, 1, 3,
+    14, 0, 0, 8, 2, 0, 31, 39, 5, 0, 0, 0,
+    136, 4, 2, 0, 24, 0, 55, 3, 0, 4, 18, 0,
+    0, 12, 0, 5, 74, 5, 5, 0, 12, 12, 1, 0,
+    8, 7, 1, 33, 0, 1, 0, 0, 0, 9, 0, 0,
+    15, 0, 1, 16, 42, 0, 0, 0, 7, 2, 31, 391,
+    291, 37, 343, 0, 0, 0, 0, 6, 2, 272, 0, 37,
+    0, 0, 0, 0, 0, 0, 1, 0, 17, 237, 1, 1,
+    0, 17, 2, 0, 0, 0, 2, 0, 27, 15, 0, 39,
+    0, 0, 1, 23, 189, 51, 62, 28, 5, 0, 0, 0,
+    0, 12, 5, 0, 54, 141, 0, 162, 19, 56, 1, 1,
+    153, 57, 0, 0, 33, 0, 0, 93, 43, 65, 5, 5,
+    0, 0, 1, 0, 24, 0, 5, 0, 0, 50, 445, 4,
+    9, 2, 0, 0, 18, 0, 0, 0, 0, 0, 1, 0,
+    27, 0, 5, 61, 7, 0, 189, 489, 0, 3, 0, 1,
+    0, 123, 58, 88, 0, 191, 0, 385, 0, 0, 5, 182,
+    0, 0, 190, 0, 1, 75, 317, 318, 818, 1259, 0, 3117,
+    0,
+};
+
+// Filled from htmlEntityValues on the first lookup
+static xmlEntity htmlEntities[HTML_ENTITY_COUNT];
+static pthread_once_t htmlEntitiesOnce = PTHREAD_ONCE_INIT;
+
+static void initHtmlEntities()
+{
+    for (int i = 0; i < HTML_ENTITY_COUNT; i++)
+    {
+        xmlEntityPtr entity = &htmlEntities[i];
+        entity->type = XML_ENTITY_DECL;
+        entity->name = BAD_CAST htmlEntityValues[i].name;
+        entity->orig = BAD_CAST htmlEntityValues[i].value;
+        entity->content = BAD_CAST htmlEntityValues[i].value;
+        entity->length = htmlEntityValues[i].length;
+        entity->etype = XML_INTERNAL_PREDEFINED_ENTITY;
+    }
+}
+
+static unsigned int hashName(const xmlChar *name, unsigned int seed)
+{
+    unsigned int h = 0x811c9dc5U ^ seed;
+    while (*name)
+        h = (h ^ *name++) * 0x01000193U;
+    return h;
+}
+
+/**
+ * Look up a HTML named character reference
+ *
+ * @param name the name of the entity without '&' and ';'
+ * @return pointer to a predefined entity holding the UTF-8 characters
+ * @retval NULL if there is no entity with the name
+ */
+xmlEntityPtr getHtmlEntity(const xmlChar *name)
+{
+    unsigned int seed = htmlEntitySeeds[hashName(name, 0) % HTML_ENTITY_COUNT];
+    unsigned int slot = hashName(name, seed) % HTML_ENTITY_COUNT;
+    if (strcmp(htmlEntityValues[slot].name, (const char *) name) != 0)
+        return NULL;
+    pthread_once(&htmlEntitiesOnce, initHtmlEntities);
+    return &htmlEntities[slot];
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HTMLENTITIES_H
+#define HTMLENTITIES_H
+
+#include <libxml/entities.h>
+
+//
+// The HTML5 named character references, such as &nbsp; and &eacute;, for
+// documents that use them without declaring them. The table is generated
+// by gen_htmlentities.py.
+//
+
+xmlEntityPtr getHtmlEntity(const xmlChar *name);
+
+#endif
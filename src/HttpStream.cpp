@@ -39,16 +39,21 @@
 log4cxx::LoggerPtr xmlHttpStreamLog(
         log4cxx::Logger::getLogger("kolibre.xmlreader.httpstream"));
 
+// Number of times an interrupted transfer is resumed before giving up
+#define MAX_RESUME_ATTEMPTS 3
+
 using namespace std;
 
 HttpStream::HttpStream(const std::string url, CURL *curlHandle,
-        CURLM *curlMultiHandle, CacheObject *pCache) :
-        fMulti(curlMultiHandle), fEasy(curlHandle), fTotalBytesRead(0), fTotalBytesWrite(
+        CURLM *curlMultiHandle, CacheObject *pCache, bool ownMulti) :
+        fMulti(curlMultiHandle), fEasy(curlHandle), bOwnMulti(ownMulti), fTotalBytesRead(0), fTotalBytesWrite(
                 0), fWritePtr(0), fBytesRead(0), fBytesToRead(0), fDataAvailable(
-                false), fBuffer(0), fBufferSize(0), fBufferHead(0), fBufferTail(
-                0), hContent_length_response(0), bStoreCache(false), bTransferFinished(
+                false), fBufferSize(0), hContent_length_response(0), hResponseCode(
+                0), hAcceptRanges(true), hContentEncoded(false), hContentRange(false), fResumeOffset(
+                0), fSkipBytes(0), iResumeAttempts(0), bResumePending(false), bResumeRejected(
+                false), fHeaders(0), fResumeHeaders(0), bStoreCache(false), bTransferFinished(
                 false), bStreamFromCache(false), bDeleteCache(false), cacheObject(
-                0)
+                0), cacheReader(0), cacheWriter(0)
 {
     bUseCache = true;
     mErrorMsg = "unknown error";
@@ -59,6 +64,31 @@ HttpStream::HttpStream(const std::string url, CURL *curlHandle,
     setupConnection(pCache);
 }
 
+/**
+ * Create a stream that serves a cached entry without touching the network
+ *
+ * Used for entries that are still fresh or are being revalidated in the
+ * background.
+ */
+HttpStream::HttpStream(const std::string url, CacheObject *pCache) :
+        fMulti(0), fEasy(0), bOwnMulti(false), fTotalBytesRead(0), fTotalBytesWrite(0), fWritePtr(
+                0), fBytesRead(0), fBytesToRead(0), fDataAvailable(false), fBufferSize(
+                0), hContent_length_response(0), hResponseCode(0), hAcceptRanges(
+                true), hContentEncoded(false), hContentRange(false), fResumeOffset(0), fSkipBytes(0), iResumeAttempts(
+                0), bResumePending(false), bResumeRejected(false), fHeaders(0), fResumeHeaders(
+                0), bStoreCache(false), bTransferFinished(false), bStreamFromCache(
+                true), bDeleteCache(false), cacheObject(pCache), cacheReader(
+                0), cacheWriter(0), fLocation(0)
+{
+    bUseCache = true;
+    mErrorMsg = "unknown error";
+    mErrorCode = NONE;
+
+    sURL = url;
+    LOG4CXX_TRACE(xmlHttpStreamLog, "cache only constructor for '" << sURL << "'");
+    cacheObject->ref();
+}
+
 HttpStream::~HttpStream()
 {
     LOG4CXX_TRACE(xmlHttpStreamLog, "destructor for '" << sURL << "'");
@@ -66,35 +96,47 @@ HttpStream::~HttpStream()
             "read: " << fTotalBytesRead << " bufsize: " << fBufferSize);
     destroyConnection();
 
-    // Check if we should store the cacheobject
-    if (USE_CACHE && cacheObject != NULL)
+    // Wait for the background compression of what we received
+    bool bCacheComplete = true;
+    if (cacheWriter != NULL)
     {
-        if (bStoreCache && bTransferFinished && bUseCache)
-        {
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Finishing compression phase for " << sURL);
-            cacheObject->writeBytes(NULL, 0);
-            cacheObject->setContentLength(fTotalBytesRead);
-            cacheObject->resetState();
-            DataStreamHandler::Instance()->addCacheObject(sURL, cacheObject);
-        }
-        else if (bUseCache && bStreamFromCache)
-        {
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Resetting cacheObject " << sURL);
-            cacheObject->resetState();
-        }
-        else
-        {
-            //LOG4CXX(xmlHttpStreamLog, "Deleting cacheObject " << sURL);
-            if (bDeleteCache)
-                delete cacheObject;
-        }
+        bCacheComplete = cacheWriter->finish();
+        delete cacheWriter;
+        cacheWriter = NULL;
     }
-    else
+
+    // Check if we should store the cacheobject, only entries we filled
+    // ourselves are stored, the cache takes over our reference
+    if (USE_CACHE && cacheObject != NULL && bDeleteCache && bStoreCache
+            && bTransferFinished && bUseCache && bCacheComplete)
+    {
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Finishing compression phase for " << sURL);
+        cacheObject->writeBytes(NULL, 0);
+        cacheObject->setContentLength(fTotalBytesRead);
+        cacheObject->resetState();
+        DataStreamHandler::Instance()->addCacheObject(sURL, cacheObject);
+        cacheObject = NULL;
+    }
+    releaseCache();
+
+    if (fEasy != NULL)
     {
-        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Not storing cacheObject for " << sURL);
+        // Don't leak a resume range or our header lists, which are freed
+        // below, into the next transfer on this handle
+        curl_easy_setopt(fEasy, CURLOPT_RANGE, NULL);
+        curl_easy_setopt(fEasy, CURLOPT_HTTPHEADER, NULL);
+        if (bOwnMulti)
+            curl_multi_remove_handle(fMulti, fEasy);
+        DataStreamHandler::Instance()->releaseHandle(fEasy);
     }
 
-    DataStreamHandler::Instance()->releaseHandle(fEasy);
+    if (bOwnMulti)
+        curl_multi_cleanup(fMulti);
+
+    if (fHeaders != NULL)
+        curl_slist_free_all(fHeaders);
+    if (fResumeHeaders != NULL)
+        curl_slist_free_all(fResumeHeaders);
 }
 
 inline unsigned int HttpStream::curPos() const
@@ -102,6 +144,25 @@ inline unsigned int HttpStream::curPos() const
     return fTotalBytesRead;
 }
 
+/**
+ * Drop our reference to the cacheObject and its read cursor
+ */
+void HttpStream::releaseCache()
+{
+    if (cacheReader != NULL)
+    {
+        delete cacheReader;
+        cacheReader = NULL;
+    }
+
+    if (cacheObject != NULL)
+    {
+        cacheObject->unref();
+        cacheObject = NULL;
+    }
+    bDeleteCache = false;
+}
+
 bool HttpStream::setupConnection(CacheObject *pCache)
 {
     struct curl_slist *headers = NULL;
@@ -122,6 +183,7 @@ bool HttpStream::setupConnection(CacheObject *pCache)
         {
             string headerstr = "";
             cacheObject = pCache;
+            cacheObject->ref();
             //LOG4CXX_DEBUG(xmlHttpStreamLog, "Have cache object for url " << sURL << " of size " << cacheObject->getContentLength());
 
             // Append these if we have cached data and want to verify it's freshness
@@ -148,6 +210,9 @@ bool HttpStream::setupConnection(CacheObject *pCache)
     }
 
     curl_easy_setopt(fEasy, CURLOPT_HTTPHEADER, headers);
+    if (fHeaders != NULL)
+        curl_slist_free_all(fHeaders);
+    fHeaders = headers;
 
     curl_easy_setopt(fEasy, CURLOPT_WRITEHEADER, this);
     // Pass this pointer to header function
@@ -165,6 +230,74 @@ bool HttpStream::setupConnection(CacheObject *pCache)
     // Our static debug function
 
     curl_easy_setopt(fEasy, CURLOPT_URL, sURL.c_str());
+    curl_easy_setopt(fEasy, CURLOPT_RANGE, NULL);
+
+    return true;
+}
+
+/**
+ * Resume an interrupted transfer from the last byte received
+ *
+ * The request is reissued with a Range header guarded by If-Range on the
+ * validator of the first response, so that the bytes already handed to the
+ * parser and written to the cacheObject are kept.
+ *
+ * @return true if the transfer was restarted, false if it can not be resumed
+ */
+bool HttpStream::resumeTransfer()
+{
+    // Bytes received so far, including those still waiting in the overflow buffer
+    size_t received = fTotalBytesRead + fBufferSize + fSkipBytes;
+
+    if (received == 0 || !hAcceptRanges || hContentEncoded)
+        return false;
+
+    if (iResumeAttempts >= MAX_RESUME_ATTEMPTS)
+    {
+        LOG4CXX_WARN(xmlHttpStreamLog,
+                "Giving up on " << sURL << " after " << iResumeAttempts << " resume attempts");
+        return false;
+    }
+
+    // If-Range requires a strong validator
+    if (!hEtag.empty() && hEtag.compare(0, 2, "W/") != 0)
+        sResumeValidator = "\"" + hEtag + "\"";
+    else if (!hLast_modified.empty())
+        sResumeValidator = hLast_modified;
+    else
+        return false;
+
+    iResumeAttempts++;
+    fResumeOffset = received;
+    fSkipBytes = 0;
+    bResumePending = true;
+
+    LOG4CXX_WARN(xmlHttpStreamLog,
+            "Resuming " << sURL << " from byte " << fResumeOffset << " (attempt " << iResumeAttempts << ")");
+
+    curl_multi_remove_handle(fMulti, fEasy);
+
+    if (fResumeHeaders != NULL)
+        curl_slist_free_all(fResumeHeaders);
+    fResumeHeaders = NULL;
+    fResumeHeaders = curl_slist_append(fResumeHeaders, "Connection: keep-alive");
+    fResumeHeaders = curl_slist_append(fResumeHeaders, "Keep-Alive: 300");
+    string headerstr = "If-Range: " + sResumeValidator;
+    fResumeHeaders = curl_slist_append(fResumeHeaders, headerstr.c_str());
+    curl_easy_setopt(fEasy, CURLOPT_HTTPHEADER, fResumeHeaders);
+
+    char range[32];
+    snprintf(range, sizeof(range), "%lu-", (unsigned long) fResumeOffset);
+    curl_easy_setopt(fEasy, CURLOPT_RANGE, range);
+
+    // Only the validators of the new response may match sResumeValidator
+    hResponseCode = 0;
+    hContent_length_response = 0;
+    hEtag.clear();
+    hLast_modified.clear();
+    hContentRange = false;
+
+    curl_multi_add_handle(fMulti, fEasy);
 
     return true;
 }
@@ -176,29 +309,54 @@ void HttpStream::useCache(bool setting)
 
 bool HttpStream::destroyConnection()
 {
-    if (fBuffer != NULL)
-        free(fBuffer);
+    freeChunks();
     if (fLocation != NULL)
         free(fLocation);
+    fLocation = NULL;
 
     return true;
 }
 
+void HttpStream::freeChunks()
+{
+    while (!fChunks.empty())
+    {
+        fChunks.front().first->unref();
+        fChunks.pop_front();
+    }
+    fBufferSize = 0;
+}
+
 bool HttpStream::resetBuffer()
 {
     fTotalBytesRead = 0;
     fTotalBytesWrite = 0;
 
     fDataAvailable = false;
-    if (fBufferSize != 0)
-        free(fBuffer);
-    fBuffer = NULL;
-    fBufferSize = 0;
-    fBufferHead = 0;
-    fBufferTail = 0;
+    freeChunks();
+
+    // Nothing from the previous response belongs in the cache
+    if (cacheWriter != NULL)
+    {
+        cacheWriter->finish();
+        delete cacheWriter;
+        cacheWriter = NULL;
+    }
 
     bStoreCache = false;
     bStreamFromCache = false;
+
+    hResponseCode = 0;
+    hEtag.clear();
+    hLast_modified.clear();
+    hAcceptRanges = true;
+    hContentEncoded = false;
+    hContentRange = false;
+    fResumeOffset = 0;
+    fSkipBytes = 0;
+    iResumeAttempts = 0;
+    bResumePending = false;
+    bResumeRejected = false;
     return true;
 }
 
@@ -216,6 +374,13 @@ size_t HttpStream::headerCallback(char *buffer, size_t size, size_t nitems)
 
     if (memcmp(buffer, "HTTP", 4) == 0)
     {
+        const char *codePtr = (const char *) memchr(buffer, ' ', size * nitems);
+        if (codePtr != NULL)
+            hResponseCode = atoi(codePtr + 1);
+
+        // Headers of an earlier response, such as a redirect, don't count
+        sCacheControl.clear();
+
         bufPtr = buffer + 4;
         for (int c = 0; c < (size * nitems - 4); c++)
             if (memcmp(bufPtr + c, " ", 1) == 0)
@@ -227,9 +392,28 @@ size_t HttpStream::headerCallback(char *buffer, size_t size, size_t nitems)
 
                 if (memcmp(bufPtr2, " 200", 4) == 0)
                 {
+                    // The entity changed. Other readers may be using the
+                    // cached copy, so fill a new entry instead of this one
+                    if (USE_CACHE && bUseCache && cacheObject != NULL
+                            && !bDeleteCache)
+                    {
+                        releaseCache();
+                        cacheObject = new CacheObject(sURL.c_str());
+                        bDeleteCache = true;
+                    }
+
+                    // Freshness is decided by the Cache-Control of this
+                    // response only
+                    if (USE_CACHE && bUseCache && bDeleteCache)
+                        cacheObject->resetFreshness();
                     bStoreCache = true;
                     LOG4CXX_DEBUG(xmlHttpStreamLog, sURL << " 200 OK");
                 }
+                else if (memcmp(bufPtr2, " 206", 4) == 0)
+                {
+                    LOG4CXX_DEBUG(xmlHttpStreamLog,
+                            sURL << " 206 PARTIAL CONTENT");
+                }
                 else if (memcmp(bufPtr2, " 301", 4) == 0)
                 {
                     LOG4CXX_DEBUG(xmlHttpStreamLog, sURL << " 301 REDIRECT");
@@ -264,16 +448,10 @@ size_t HttpStream::headerCallback(char *buffer, size_t size, size_t nitems)
         else if (memcmp(buffer + size * nitems - 1, "\r\n", 2))
             dataSize -= 2;
 
-        char *hEtag = (char *) malloc((dataSize + 1));
-        if (hEtag != NULL)
-        {
-            memcpy(hEtag, bufPtr, dataSize);
-            memset(hEtag + dataSize, 0, 1);
-            if (USE_CACHE && bUseCache)
-                cacheObject->setEtag(hEtag);
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got etag len: " << dataSize << " '" << hEtag << "'");
-            free(hEtag);
-        }
+        hEtag.assign(bufPtr, dataSize);
+        if (USE_CACHE && bUseCache && bDeleteCache)
+            cacheObject->setEtag(hEtag.c_str());
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got etag len: " << dataSize << " '" << hEtag << "'");
 
     }
     else if (memcmp(buffer, "Last-Modified: ", 15) == 0)
@@ -285,16 +463,10 @@ size_t HttpStream::headerCallback(char *buffer, size_t size, size_t nitems)
         if (memcmp(buffer + size * nitems - 1, "\r\n", 2))
             dataSize -= 2;
 
-        char *hLast_modified = (char *) malloc((dataSize + 1));
-        if (hLast_modified != NULL)
-        {
-            memcpy(hLast_modified, bufPtr, dataSize);
-            memset(hLast_modified + dataSize, 0, 1);
-            if (USE_CACHE && bUseCache)
-                cacheObject->setLastModified(hLast_modified);
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got last_modified len: " << dataSize << " '" << hLast_modified << "'");
-            free(hLast_modified);
-        }
+        hLast_modified.assign(bufPtr, dataSize);
+        if (USE_CACHE && bUseCache && bDeleteCache)
+            cacheObject->setLastModified(hLast_modified.c_str());
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got last_modified len: " << dataSize << " '" << hLast_modified << "'");
 
     }
     else if (memcmp(buffer, "Location: ", 10) == 0)
@@ -306,39 +478,59 @@ size_t HttpStream::headerCallback(char *buffer, size_t size, size_t nitems)
         if (memcmp(buffer + size * nitems - 1, "\r\n", 2))
             dataSize -= 2;
 
-        char *hLocation = (char *) malloc((dataSize + 1));
-        if (hLocation != NULL)
-        {
-            memcpy(hLocation, bufPtr, dataSize);
-            memset(hLocation + dataSize, 0, 1);
-            if (USE_CACHE && bUseCache)
-                cacheObject->setLocation(hLocation);
-            if (fLocation != NULL)
-                free(fLocation);
-            fLocation = strdup(hLocation);
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got last_modified len: " << dataSize << " '" << hLocation << "'");
-            free(hLocation);
-        }
+        if (fLocation != NULL)
+            free(fLocation);
+        fLocation = strndup(bufPtr, dataSize);
+        if (fLocation != NULL && USE_CACHE && bUseCache && bDeleteCache)
+            cacheObject->setLocation(fLocation);
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got location len: " << dataSize << " '" << fLocation << "'");
 
     }
     else if (memcmp(buffer, "Content-Length: ", 16) == 0)
     {
+        // atol stops at the trailing \r\n, the line needs no copy
         bufPtr = buffer + 16;
-        dataSize = (size * nitems) - (bufPtr - buffer);
-        char *tmpBuf = NULL;
+        hContent_length_response = atol(bufPtr);
+        // A partial response only carries the length of the remainder
+        if (hResponseCode == 206)
+            hContent_length_response += fResumeOffset;
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got Content-Length " << hContent_length_response);
+    }
 
-        // Trim \r\n and possibly "
-        if (memcmp(buffer + size * nitems - 1, "\r\n", 2))
-            dataSize -= 2;
+    else if (strncasecmp(buffer, "Cache-Control: ", 15) == 0)
+    {
+        sCacheControl.assign(buffer + 15, size * nitems - 15);
+
+        // An entry shared with other readers is only refreshed under the
+        // cache lock, once a 304 arrives
+        if (USE_CACHE && bUseCache && bDeleteCache)
+            cacheObject->setCacheControl(sCacheControl.c_str());
 
-        tmpBuf = (char *) malloc((dataSize + 1));
-        if (tmpBuf != NULL)
+        // Never keep a copy of responses that forbid storing them
+        if (sCacheControl.find("no-store") != string::npos)
+            bStoreCache = false;
+    }
+    else if (strncasecmp(buffer, "Accept-Ranges: ", 15) == 0)
+    {
+        if (strncasecmp(buffer + 15, "none", 4) == 0)
+            hAcceptRanges = false;
+    }
+    else if (strncasecmp(buffer, "Content-Encoding: ", 18) == 0)
+    {
+        // Ranges refer to the encoded entity, not the bytes we get from curl
+        if (strncasecmp(buffer + 18, "identity", 8) != 0)
+            hContentEncoded = true;
+    }
+    else if (strncasecmp(buffer, "Content-Range: ", 15) == 0)
+    {
+        unsigned long rangeStart = 0;
+        hContentRange = true;
+        if (sscanf(buffer + 15, "bytes %lu-", &rangeStart) != 1
+                || rangeStart != fResumeOffset)
         {
-            memcpy(tmpBuf, bufPtr, dataSize);
-            memset(tmpBuf + dataSize, 0, 1);
-            hContent_length_response = atol(tmpBuf);
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Got Content-Length len: " << dataSize << " '" << tmpBuf << "' " << hContent_length_response);
-            free(tmpBuf);
+            LOG4CXX_ERROR(xmlHttpStreamLog,
+                    "Unexpected Content-Range for " << sURL << ", wanted offset " << fResumeOffset);
+            bResumeRejected = true;
         }
     }
 
@@ -423,6 +615,53 @@ size_t HttpStream::writeCallback(char *buffer, size_t size, size_t nitems)
     size_t cnt = size * nitems;
     size_t totalConsumed = 0;
 
+    // First block after resuming, check what the server made of our range
+    if (bResumePending)
+    {
+        bResumePending = false;
+        if (hResponseCode == 200 && !bResumeRejected)
+        {
+            // The range was ignored, but if the entity is unchanged we can
+            // still drop the bytes we already have
+            if ((!hEtag.empty() && "\"" + hEtag + "\"" == sResumeValidator)
+                    || (!hLast_modified.empty()
+                            && hLast_modified == sResumeValidator))
+            {
+                LOG4CXX_WARN(xmlHttpStreamLog,
+                        "Server ignored range for " << sURL << ", skipping " << fResumeOffset << " bytes");
+                fSkipBytes = fResumeOffset;
+            }
+            else
+                bResumeRejected = true;
+        }
+        else if (hResponseCode != 206 || !hContentRange)
+        {
+            // A partial response that does not say which part it holds
+            // can not be appended safely
+            LOG4CXX_ERROR(xmlHttpStreamLog,
+                    "Unusable response " << hResponseCode << " to resumed request for " << sURL);
+            bResumeRejected = true;
+        }
+    }
+
+    // Returning less than we got makes curl abort the transfer
+    if (bResumeRejected)
+    {
+        mErrorMsg = "Resource changed while resuming transfer";
+        return 0;
+    }
+
+    if (fSkipBytes > 0)
+    {
+        size_t skip = (cnt > fSkipBytes) ? fSkipBytes : cnt;
+        fSkipBytes -= skip;
+        buffer += skip;
+        cnt -= skip;
+        totalConsumed += skip;
+        if (cnt == 0)
+            return totalConsumed;
+    }
+
     // Consume as many bytes as possible immediately into the buffer
     size_t consume = (cnt > fBytesToRead) ? fBytesToRead : cnt;
     memcpy(fWritePtr, buffer, consume);
@@ -433,54 +672,51 @@ size_t HttpStream::writeCallback(char *buffer, size_t size, size_t nitems)
 
     //LOG4CXX_DEBUG(xmlHttpStreamLog, sURL << ": wrote " << size * nitems  << " (fTotalBytesRead: " << fTotalBytesRead << ")");
 
-    // If we got a 200 response code, compress the blocks recieved and
-    // store the the contents in zBuffer
+    // If we got a 200 response code, hand the block to the cache writer,
+    // which compresses it into zBuffer in the background
+    DataChunk *chunk = NULL;
     if (USE_CACHE && bUseCache && bStoreCache)
     {
-        cacheObject->writeBytes(buffer, size * nitems);
+        chunk = DataChunk::create(buffer, cnt);
+        if (cacheWriter == NULL)
+            cacheWriter = new CacheWriter(cacheObject);
+        if (chunk == NULL || !cacheWriter->write(chunk))
+        {
+            LOG4CXX_ERROR(xmlHttpStreamLog,
+                    "Failed to cache block, not storing " << sURL);
+            bStoreCache = false;
+        }
     }
 
-    // If bytes remain, rebuffer as many as possible into our holding buffer
+    // If bytes remain, keep them in our holding buffer. The copy made for
+    // the cache writer is shared rather than copied again.
     buffer += consume;
     totalConsumed += consume;
     cnt -= consume;
     if (cnt > 0)
     {
-        if (fBufferSize == 0)
+        size_t offset = consume;
+        if (chunk == NULL)
         {
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Allocating " << cnt << " bytes to buffer");
-            fBuffer = (char *) malloc(cnt * sizeof(char));
-            if (fBuffer != NULL)
-            {
-                fBufferSize += cnt;
-                fBufferHead = 0;
-                consume = cnt;
-            }
-            else
-                LOG4CXX_ERROR(xmlHttpStreamLog, "Failed to allocate memory");
+            chunk = DataChunk::create(buffer, cnt);
+            offset = 0;
         }
-        else
-        {
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "Reallocating buffer to " << (fBufferSize + cnt + 1) * sizeof(char) << " bytes");
-            fBuffer = (char *) realloc(fBuffer,
-                    (fBufferSize + cnt + 1) * sizeof(char));
-            if (fBuffer != NULL)
-            {
-                fBufferSize += cnt;
-                consume = cnt;
-            }
-            else
-                LOG4CXX_ERROR(xmlHttpStreamLog, "Failed to allocate memory");
 
+        if (chunk != NULL)
+        {
+            fChunks.push_back(make_pair(chunk, offset));
+            fBufferSize += cnt;
+            totalConsumed += cnt;
+            chunk = NULL;
         }
-
-        memcpy(fBuffer + fBufferHead, buffer, consume);
-        fBufferHead += consume;
-        buffer += consume;
-        totalConsumed += consume;
-        //LOG4CXX_DEBUG(xmlHttpStreamLog, "write callback rebuffering " << consume << " bytes (total size: " << fBufferSize << ")");
+        else
+            LOG4CXX_ERROR(xmlHttpStreamLog, "Failed to allocate memory");
+        //LOG4CXX_DEBUG(xmlHttpStreamLog, "write callback rebuffering " << cnt << " bytes (total size: " << fBufferSize << ")");
     }
 
+    if (chunk != NULL)
+        chunk->unref();
+
     // Return the total amount we've consumed. If we don't consume all the bytes
     // then an error will be generated. Since our buffer size is equal to the
     // maximum size that curl will write, this should never happen unless there
@@ -604,42 +840,33 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
                     && !bStreamFromCache;)
     {
         // First, any buffered data we have available
-        size_t bufCnt = fBufferSize;
-        bufCnt = (bufCnt > fBytesToRead) ? fBytesToRead : bufCnt;
-        if (bufCnt > 0)
+        if (fBufferSize > 0)
         {
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "consuming " << bufCnt << " buffered bytes");
-
-            memcpy(fWritePtr, fBuffer, bufCnt);
-            fWritePtr += bufCnt;
-            fBytesRead += bufCnt;
-            fTotalBytesRead += bufCnt;
-            fBytesToRead -= bufCnt;
-
-            if (fBufferSize - bufCnt > 0)
+            while (fBytesToRead > 0 && !fChunks.empty())
             {
-                memcpy(fBuffer, fBuffer + bufCnt, fBufferSize - bufCnt);
+                DataChunk *chunk = fChunks.front().first;
+                size_t offset = fChunks.front().second;
+                size_t bufCnt = chunk->size - offset;
+                bufCnt = (bufCnt > fBytesToRead) ? fBytesToRead : bufCnt;
+
+                //LOG4CXX_DEBUG(xmlHttpStreamLog, "consuming " << bufCnt << " buffered bytes");
+
+                memcpy(fWritePtr, chunk->data + offset, bufCnt);
+                fWritePtr += bufCnt;
+                fBytesRead += bufCnt;
+                fTotalBytesRead += bufCnt;
+                fBytesToRead -= bufCnt;
                 fTotalBytesWrite += bufCnt;
                 fBufferSize -= bufCnt;
-                fBufferHead -= bufCnt;
 
-                //LOG4CXX_DEBUG(xmlHttpStreamLog, "Reallocating buffer to " << fBufferSize * sizeof(char) << " bytes");
-                fBuffer = (char *) realloc(fBuffer, fBufferSize * sizeof(char));
-                if (fBuffer == NULL)
+                if (offset + bufCnt == chunk->size)
                 {
-                    LOG4CXX_ERROR(xmlHttpStreamLog,
-                            "Failed to allocate memory");
-                    fBufferSize = 0;
+                    chunk->unref();
+                    fChunks.pop_front();
                 }
+                else
+                    fChunks.front().second += bufCnt;
             }
-            else
-            {
-                free(fBuffer);
-                fBuffer = NULL;
-                fBufferSize = 0;
-                fBufferHead = 0;
-            }
-            //LOG4CXX_DEBUG(xmlHttpStreamLog, "consuming " << bufCnt << " buffered bytes");
 
             tryAgain = true;
             continue;
@@ -662,7 +889,8 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
             if (msg->msg != CURLMSG_DONE)
                 continue;
 
-            switch (msg->data.result)
+            CURLcode result = msg->data.result;
+            switch (result)
             {
             case CURLE_OK:
                 // We completed, now check the response code of the document
@@ -678,9 +906,16 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
                     tryAgain = false;
                     break;
 
+                case 206:
+                    // A resumed transfer completed, the cache holds the whole entity
+                    if (USE_CACHE && bUseCache)
+                        cacheObject->setHttpCode(200);
+                    tryAgain = false;
+                    break;
+
                 case 301:
                 case 302:
-                    if (USE_CACHE && bUseCache)
+                    if (USE_CACHE && bUseCache && bDeleteCache)
                         cacheObject->setHttpCode(httpcode);
                     if (fLocation != NULL)
                     {
@@ -693,6 +928,7 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
                         sURL = newlocation;
 
                         resetBuffer();
+                        releaseCache();
                         CacheObject *pCache = NULL;
                         if (USE_CACHE && bUseCache)
                             pCache =
@@ -742,6 +978,10 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
 
                 case 304:
                     LOG4CXX_DEBUG(xmlHttpStreamLog, "HTTP Code " << httpcode);
+                    if (USE_CACHE && bUseCache && cacheObject != NULL
+                            && !bDeleteCache)
+                        DataStreamHandler::Instance()->refreshCacheObject(
+                                cacheObject, sCacheControl);
                     bStreamFromCache = true;
                     tryAgain = false;
                     break;
@@ -809,9 +1049,29 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
                 throw(XmlError(XML_FROM_IO, XML_IO_EFAULT, mErrorMsg));
                 break;
 
+            case CURLE_PARTIAL_FILE:
+            case CURLE_OPERATION_TIMEDOUT:
             case CURLE_RECV_ERROR:
+                // Try to pick up where the interrupted transfer left off
+                if (resumeTransfer())
+                {
+                    runningHandles = 1;
+                    tryAgain = true;
+                    break;
+                }
                 tryAgain = false;
-                mErrorMsg = curl_easy_strerror(msg->data.result);
+                mErrorMsg = curl_easy_strerror(result);
+                mErrorCode = READ_FAILED;
+                LOG4CXX_ERROR(xmlHttpStreamLog, "CURL Error " << mErrorMsg);
+                if (result == CURLE_RECV_ERROR)
+                    throw(XmlError(XML_FROM_IO, XML_IO_EIO, mErrorMsg));
+                throw(XmlError(XML_FROM_HTTP, result, mErrorMsg));
+                break;
+
+            case CURLE_WRITE_ERROR:
+                tryAgain = false;
+                if (!bResumeRejected)
+                    mErrorMsg = curl_easy_strerror(result);
                 mErrorCode = READ_FAILED;
                 LOG4CXX_ERROR(xmlHttpStreamLog, "CURL Error " << mErrorMsg);
                 throw(XmlError(XML_FROM_IO, XML_IO_EIO, mErrorMsg));
@@ -862,18 +1122,14 @@ int HttpStream::readBytes(char* const toFill, const unsigned int maxToRead)
     }
 
     // If we are done with the CURL part, start streaming from cache in case we got a 304 response
-    if (USE_CACHE && bUseCache && bStreamFromCache)
+    if (USE_CACHE && bStreamFromCache && cacheObject != NULL)
     {
         //LOG4CXX_DEBUG(xmlHttpStreamLog, "Trying to read " << fBytesToRead << " bytes from cache for " << sURL);
 
-        fBytesRead = cacheObject->readBytes((char *) fWritePtr, fBytesToRead);
-        if (fBytesRead == 0)
-            cacheObject->resetState();
-        else if (fBytesRead < 0)
-        {
-            mErrorMsg = cacheObject->getErrorMsg();
-            mErrorCode = READ_FAILED;
-        }
+        if (cacheReader == NULL)
+            cacheReader = new CacheReader(cacheObject);
+
+        fBytesRead = cacheReader->readBytes((char *) fWritePtr, fBytesToRead);
 
         fTotalBytesRead += fBytesRead;
     }
@@ -25,9 +25,13 @@
 #include <curl/easy.h>
 #include <zlib.h>
 #include <string>
+#include <deque>
+#include <utility>
 
 #include "InputStream.h"
 #include "CacheObject.h"
+#include "CacheReader.h"
+#include "CacheWriter.h"
 
 // Helpers for splitting urls into parts.
 std::string url2hostname(const std::string& url);
@@ -43,7 +47,8 @@ class HttpStream: public InputStream
 {
 public:
     HttpStream(const std::string url, CURL *curlHandle, CURLM *curlMultiHandle,
-            CacheObject *pCache);
+            CacheObject *pCache, bool ownMulti = false);
+    HttpStream(const std::string url, CacheObject *pCache);
     ~HttpStream();
 
     unsigned int curPos() const;
@@ -78,10 +83,13 @@ private:
 
     CURLM* fMulti;
     CURL* fEasy;
+    bool bOwnMulti; // fMulti drives only this stream and is cleaned up with it
 
     bool setupConnection(CacheObject *pCache);
+    void releaseCache();
     bool destroyConnection();
     bool resetBuffer();
+    bool resumeTransfer();
 
     std::string sURL;
 
@@ -93,13 +101,30 @@ private:
     bool fDataAvailable;
 
     // Overflow buffer for when curl writes more data to us
-    // than we've asked for.
-    char* fBuffer;
+    // than we've asked for. Holds chunks and the offset of
+    // the first unread byte in each.
+    std::deque<std::pair<DataChunk *, size_t> > fChunks;
     size_t fBufferSize;
-    size_t fBufferHead;
-    size_t fBufferTail;
+    void freeChunks();
 
     size_t hContent_length_response;
+    int hResponseCode;
+    std::string hEtag;
+    std::string hLast_modified;
+    bool hAcceptRanges;
+    bool hContentEncoded;
+    bool hContentRange; // the response had a Content-Range header
+    std::string sCacheControl;
+
+    // Resume state for interrupted transfers
+    size_t fResumeOffset;
+    size_t fSkipBytes;
+    int iResumeAttempts;
+    bool bResumePending;
+    bool bResumeRejected;
+    std::string sResumeValidator;
+    struct curl_slist *fHeaders; // request headers of setupConnection
+    struct curl_slist *fResumeHeaders;
 
     bool bStoreCache;
     bool bTransferFinished;
@@ -107,6 +132,8 @@ private:
     bool bUseCache;
     bool bDeleteCache;
     CacheObject* cacheObject;
+    CacheReader* cacheReader;
+    CacheWriter* cacheWriter;
 
     char * fLocation;
 
@@ -70,6 +70,18 @@ public:
      */
     virtual int readBytes(char* const toFill, const unsigned int maxToRead) = 0;
 
+    /**
+     * Skip bytes in stream
+     *
+     * The default implementation reads and discards them.
+     *
+     * @param count number of bytes to skip
+     * @return boolean
+     * @retval true if the bytes were skipped
+     * @retval false if the stream ended first or an error occurred
+     */
+    virtual bool skipBytes(unsigned long count);
+
     /**
      * Specifiy whether to use caching or not
      *
@@ -128,5 +140,18 @@ inline InputStream::InputStream()
 {
 }
 ;
+inline bool InputStream::skipBytes(unsigned long count)
+{
+    char buffer[4096];
+    while (count > 0)
+    {
+        int bytes = readBytes(buffer,
+                count < sizeof(buffer) ? count : sizeof(buffer));
+        if (bytes <= 0)
+            return false;
+        count -= bytes;
+    }
+    return true;
+}
 
 #endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "ReadAheadStream.h"
+#include "XmlError.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlReadAheadStreamLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.readaheadstream"));
+
+/**
+ * Wrap a stream, the ReadAheadStream takes over ownership of it
+ */
+ReadAheadStream::ReadAheadStream(InputStream *stream) :
+        inStream(stream), buffers(0), queueMutex(), freeCond(), filledCond(), thread(), current(
+                0), currentOffset(0), pError(0), fTotalBytesRead(0), bStarted(
+                false), bStopping(false), bFailed(false)
+{
+    mErrorMsg = "unknown error";
+    mErrorCode = NONE;
+
+    pthread_mutex_init(&queueMutex, NULL);
+    pthread_cond_init(&freeCond, NULL);
+    pthread_cond_init(&filledCond, NULL);
+}
+
+ReadAheadStream::~ReadAheadStream()
+{
+    if (bStarted)
+    {
+        pthread_mutex_lock(&queueMutex);
+        bStopping = true;
+        pthread_cond_signal(&freeCond);
+        pthread_mutex_unlock(&queueMutex);
+
+        pthread_join(thread, NULL);
+    }
+
+    // The wrapped stream is released from the thread that created it
+    delete inStream;
+    delete[] buffers;
+    delete pError;
+
+    pthread_cond_destroy(&filledCond);
+    pthread_cond_destroy(&freeCond);
+    pthread_mutex_destroy(&queueMutex);
+}
+
+unsigned int ReadAheadStream::curPos() const
+{
+    return fTotalBytesRead;
+}
+
+/**
+ * Allocate the buffers and start the reading thread
+ *
+ * @return true if the thread was started
+ */
+bool ReadAheadStream::start()
+{
+    buffers = new Buffer[READ_AHEAD_BUFFERS];
+    for (int i = 0; i < READ_AHEAD_BUFFERS; i++)
+        freeBuffers.push(&buffers[i]);
+
+    if (pthread_create(&thread, NULL, staticRun, this) != 0)
+    {
+        LOG4CXX_ERROR(xmlReadAheadStreamLog,
+                "Failed to start read-ahead thread, reading directly");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read bytes that the worker thread has read ahead
+ *
+ * The thread is started on the first call. If it can not be started the
+ * wrapped stream is read directly.
+ *
+ * @param toFill pointer where to store data
+ * @param maxToRead number of bytes to read
+ * @return number of bytes read, 0 at the end of the stream and -1 on error
+ */
+int ReadAheadStream::readBytes(char* const toFill, const unsigned int maxToRead)
+{
+    if (!bStarted && !bFailed)
+    {
+        if (start())
+            bStarted = true;
+        else
+            bFailed = true;
+    }
+
+    if (bFailed)
+    {
+        int bytes = inStream->readBytes(toFill, maxToRead);
+        if (bytes > 0)
+            fTotalBytesRead += bytes;
+        else if (bytes < 0)
+        {
+            mErrorMsg = inStream->getErrorMsg();
+            mErrorCode = inStream->getErrorCode();
+        }
+        return bytes;
+    }
+
+    if (current == NULL)
+    {
+        pthread_mutex_lock(&queueMutex);
+        while (filledBuffers.empty())
+            pthread_cond_wait(&filledCond, &queueMutex);
+        current = filledBuffers.front();
+        filledBuffers.pop();
+        pthread_mutex_unlock(&queueMutex);
+        currentOffset = 0;
+    }
+
+    // The last buffer marks the end of the stream and is never handed back
+    if (current->size <= 0)
+    {
+        if (pError != NULL)
+            throw XmlError(*pError);
+        return current->size;
+    }
+
+    int bytes = current->size - currentOffset;
+    if ((unsigned int) bytes > maxToRead)
+        bytes = maxToRead;
+    memcpy(toFill, current->data + currentOffset, bytes);
+    currentOffset += bytes;
+    fTotalBytesRead += bytes;
+
+    if (currentOffset == current->size)
+    {
+        pthread_mutex_lock(&queueMutex);
+        freeBuffers.push(current);
+        pthread_cond_signal(&freeCond);
+        pthread_mutex_unlock(&queueMutex);
+        current = NULL;
+    }
+
+    return bytes;
+}
+
+/**
+ * Skip bytes in stream
+ *
+ * Before the first read the wrapped stream skips them itself, which lets a
+ * file seek instead of reading.
+ */
+bool ReadAheadStream::skipBytes(unsigned long count)
+{
+    if (!bStarted && !bFailed)
+    {
+        if (!inStream->skipBytes(count))
+            return false;
+        fTotalBytesRead += count;
+        return true;
+    }
+    return InputStream::skipBytes(count);
+}
+
+/**
+ * Specify whether the wrapped stream uses the cache
+ *
+ * Must be called before the first read.
+ */
+void ReadAheadStream::useCache(bool setting)
+{
+    inStream->useCache(setting);
+}
+
+void *ReadAheadStream::staticRun(void *stream)
+{
+    ((ReadAheadStream*) stream)->run();
+    return NULL;
+}
+
+void ReadAheadStream::run()
+{
+    for (;;)
+    {
+        pthread_mutex_lock(&queueMutex);
+        while (freeBuffers.empty() && !bStopping)
+            pthread_cond_wait(&freeCond, &queueMutex);
+
+        if (bStopping)
+        {
+            pthread_mutex_unlock(&queueMutex);
+            break;
+        }
+
+        Buffer *buffer = freeBuffers.front();
+        freeBuffers.pop();
+        pthread_mutex_unlock(&queueMutex);
+
+        XmlError *error = NULL;
+        try
+        {
+            buffer->size = inStream->readBytes(buffer->data,
+                    READ_AHEAD_BUFFER_SIZE);
+        } catch (XmlError &e)
+        {
+            error = new XmlError(e);
+            buffer->size = -1;
+        }
+
+        if (buffer->size < 0)
+        {
+            mErrorMsg = inStream->getErrorMsg();
+            mErrorCode = inStream->getErrorCode();
+        }
+
+        pthread_mutex_lock(&queueMutex);
+        pError = error;
+        filledBuffers.push(buffer);
+        pthread_cond_signal(&filledCond);
+        pthread_mutex_unlock(&queueMutex);
+
+        if (buffer->size <= 0)
+            break;
+    }
+}
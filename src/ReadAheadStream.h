@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef READAHEADSTREAM_H
+#define READAHEADSTREAM_H
+
+#include <pthread.h>
+#include <queue>
+
+#include "InputStream.h"
+
+class XmlError;
+
+// Number and size of the buffers filled ahead of the parser
+#define READ_AHEAD_BUFFERS 4
+#define READ_AHEAD_BUFFER_SIZE 16384
+
+//
+// This class reads another stream in a worker thread, a few buffers ahead of
+// the caller, so that file and network I/O overlaps with parsing. Buffers are
+// handed between the threads through a filled and a free queue and reused
+// for the lifetime of the stream.
+//
+
+class ReadAheadStream: public InputStream
+{
+public:
+    ReadAheadStream(InputStream *stream);
+    ~ReadAheadStream();
+
+    unsigned int curPos() const;
+    int readBytes(char* const toFill, const unsigned int maxToRead);
+    bool skipBytes(unsigned long count);
+
+    void useCache(bool);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    ReadAheadStream(const ReadAheadStream&);
+    ReadAheadStream& operator=(const ReadAheadStream&);
+
+    struct Buffer
+    {
+        char data[READ_AHEAD_BUFFER_SIZE];
+        int size; // bytes in data, 0 at the end of the stream, -1 on error
+    };
+
+    bool start();
+    static void *staticRun(void *stream);
+    void run();
+
+    InputStream *inStream;
+
+    Buffer *buffers;
+    std::queue<Buffer *> freeBuffers;
+    std::queue<Buffer *> filledBuffers;
+    pthread_mutex_t queueMutex;
+    pthread_cond_t freeCond;
+    pthread_cond_t filledCond;
+    pthread_t thread;
+
+    // Buffer being copied to the caller and the offset of its next byte
+    Buffer *current;
+    int currentOffset;
+
+    // Exception thrown by the wrapped stream, thrown again by readBytes
+    XmlError *pError;
+
+    size_t fTotalBytesRead;
+    bool bStarted;
+    bool bStopping;
+    bool bFailed;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #ifdef HAVE_LIBTIDY
 #include "DataStreamHandler.h"
 #include "CacheObject.h"
+#include "CacheReader.h"
 #include "TidyStream.h"
 
 #include "XmlError.h"
@@ -35,7 +36,7 @@ log4cxx::LoggerPtr xmlTidyStreamLog(
 using namespace std;
 
 TidyStream::TidyStream(const string url, InputStream *in) :
-        sURL(url), inStream(in), fTotalBytesRead(0), cacheObject(0),
+        sURL(url), inStream(in), fTotalBytesRead(0), cacheReader(0),
             bUseCache(true), bTidied(false)
 {
     mErrorMsg = "unknown error";
@@ -50,6 +51,26 @@ TidyStream::TidyStream(const string url, InputStream *in) :
         mode = TIDY;
 }
 
+/**
+ * Create a stream serving a tidied copy from the cache
+ *
+ * The resource itself is not opened.
+ *
+ * @param url the url of the resource
+ * @param cacheObject the cached tidied copy
+ */
+TidyStream::TidyStream(const string url, CacheObject *cacheObject) :
+        sURL(url), fTotalBytesRead(0), inStream(NULL), mode(CACHED),
+            cacheReader(new CacheReader(cacheObject)), bUseCache(true),
+            bTidied(true)
+{
+    mErrorMsg = "unknown error";
+    mErrorCode = NONE;
+
+    LOG4CXX_DEBUG(xmlTidyStreamLog,
+            "constructor for cached copy of '" << sURL << "'");
+}
+
 TidyStream::~TidyStream()
 {
     LOG4CXX_DEBUG(xmlTidyStreamLog, "destructor for '" << sURL << "'");
@@ -60,8 +81,8 @@ TidyStream::~TidyStream()
         tidyBufFree(&outbuf);
         break;
     case CACHED:
-        if (cacheObject != NULL)
-            cacheObject->resetState();
+        if (cacheReader != NULL)
+            delete cacheReader;
         break;
     case PASSTROUGH:
         delete inStream;
@@ -102,12 +123,12 @@ int TidyStream::readBytes(char* const toFill, const unsigned int maxToRead)
     }
 
     case CACHED:
-        fBytes = cacheObject->readBytes((char *) toFill, maxToRead);
-        // On error propagate
+        fBytes = cacheReader->readBytes((char *) toFill, maxToRead);
+        // On error propagate, the resource itself may not have been opened
         if (fBytes < 0)
         {
-            mErrorMsg = inStream->getErrorMsg();
-            mErrorCode = inStream->getErrorCode();
+            mErrorMsg = cacheReader->getObject()->getErrorMsg();
+            mErrorCode = READ_FAILED;
         }
         else
             fTotalBytesRead += fBytes;
@@ -209,25 +230,24 @@ bool TidyStream::Perform()
 
         LOG4CXX_DEBUG(xmlTidyStreamLog, "Done reading from inStream");
 
-        // Get the cacheObject if it exists
-        cacheObject = DataStreamHandler::Instance()->getCacheObject(sURL);
-        if (cacheObject != NULL)
-            cacheObject->resetState();
+        // A tidied copy that was not current before the resource was
+        // revalidated may be again, use it if it was made from the same
+        // contents
+        CacheObject *cacheObject = DataStreamHandler::Instance()->getCacheObject(
+                sURL, CACHE_TIDIED);
 
         if (cacheObject != NULL && cacheObject->getTidyFlag())
         {
             LOG4CXX_DEBUG(xmlTidyStreamLog,
                     "using already tidied copy in cache");
+            cacheReader = new CacheReader(cacheObject);
             mode = CACHED;
         }
         else
         {
-            // If the object did not exist in cache, create a new one
-            if (cacheObject == NULL)
-            {
-                LOG4CXX_DEBUG(xmlTidyStreamLog, "creating new cacheObject");
-                cacheObject = new CacheObject(sURL.c_str());
-            }
+            // The tidied document is cached next to the raw one
+            LOG4CXX_DEBUG(xmlTidyStreamLog, "creating new cacheObject");
+            cacheObject = new CacheObject(sURL.c_str());
 
             int err = 0;
 
@@ -260,14 +280,20 @@ bool TidyStream::Perform()
                 cacheObject->resetState();
                 cacheObject->setTidyFlag(true);
                 if (bUseCache)
+                {
                     DataStreamHandler::Instance()->addCacheObject(sURL,
-                            cacheObject);
+                            cacheObject, CACHE_TIDIED);
+                    cacheObject = NULL;
+                }
             }
             else
             {
                 LOG4CXX_ERROR(xmlTidyStreamLog,
                         "failed to store " << outbuf.size << " bytes in cacheObject");
             }
+
+            if (cacheObject != NULL)
+                cacheObject->unref();
         }
 
         tidyBufFree(&docbuf);
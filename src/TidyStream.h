@@ -26,6 +26,9 @@
 
 #include "InputStream.h"
 
+class CacheObject;
+class CacheReader;
+
 //
 // This class implements the InputStream interface specified by the XML
 // parser.
@@ -35,6 +38,7 @@ class TidyStream: public InputStream
 {
 public:
     TidyStream(const std::string, InputStream *);
+    TidyStream(const std::string, CacheObject *);
     ~TidyStream();
 
     unsigned int curPos() const;
@@ -61,7 +65,7 @@ private:
 
     ParseMode mode;
 
-    CacheObject *cacheObject;
+    CacheReader *cacheReader;
 
     // libtidy stuff
     TidyDoc tdoc;
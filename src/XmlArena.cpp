@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "XmlArena.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+// Allocations are aligned for any of the structs stored in the arena
+#define ARENA_ALIGN(n) (((n) + sizeof(double) - 1) & ~(sizeof(double) - 1))
+
+XmlArena::XmlArena(size_t blockSize) :
+        pHead(0), mBlockSize(blockSize)
+{
+}
+
+XmlArena::~XmlArena()
+{
+    while (pHead != NULL)
+    {
+        Block *next = pHead->next;
+        free(pHead);
+        pHead = next;
+    }
+}
+
+XmlArena::Block *XmlArena::newBlock(size_t size)
+{
+    Block *block = (Block *) malloc(ARENA_ALIGN(sizeof(Block)) + size);
+    if (block == NULL)
+        throw std::bad_alloc();
+
+    block->next = pHead;
+    block->size = size;
+    block->used = 0;
+    pHead = block;
+    return block;
+}
+
+/**
+ * Allocate memory that lives until the next reset
+ *
+ * @param bytes number of bytes
+ * @return pointer to the memory, aligned for any type
+ */
+void *XmlArena::alloc(size_t bytes)
+{
+    bytes = ARENA_ALIGN(bytes);
+
+    Block *block = pHead;
+    if (block == NULL || block->size - block->used < bytes)
+        block = newBlock(bytes > mBlockSize ? bytes : mBlockSize);
+
+    void *ptr = (char *) block + ARENA_ALIGN(sizeof(Block)) + block->used;
+    block->used += bytes;
+    return ptr;
+}
+
+/**
+ * Copy a string into the arena
+ *
+ * @param str the string, NULL is copied as an empty string
+ * @return pointer to the copy
+ */
+xmlChar *XmlArena::strdup(const xmlChar *str)
+{
+    size_t length = (str != NULL) ? strlen((const char *) str) : 0;
+    xmlChar *copy = (xmlChar *) alloc(length + 1);
+    if (length > 0)
+        memcpy(copy, str, length);
+    copy[length] = 0;
+    return copy;
+}
+
+/**
+ * Release all allocations
+ *
+ * If the last parse needed more than one block they are merged into one,
+ * so a reader parsing documents of similar size stops calling malloc.
+ */
+void XmlArena::reset()
+{
+    if (pHead == NULL)
+        return;
+
+    if (pHead->next != NULL)
+    {
+        size_t total = capacity();
+        while (pHead != NULL)
+        {
+            Block *next = pHead->next;
+            free(pHead);
+            pHead = next;
+        }
+        newBlock(total);
+    }
+
+    pHead->used = 0;
+}
+
+size_t XmlArena::capacity() const
+{
+    size_t total = 0;
+    for (Block *block = pHead; block != NULL; block = block->next)
+        total += block->size;
+    return total;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMLARENA_H
+#define XMLARENA_H
+
+#include <stddef.h>
+#include <libxml/xmlstring.h>
+
+#define ARENA_BLOCK_SIZE 8192
+
+//
+// Bump allocator for the short lived allocations of one parse. Memory is
+// never freed piece by piece, reset() releases everything at once and
+// keeps the first block for the next parse.
+//
+
+class XmlArena
+{
+public:
+    XmlArena(size_t blockSize = ARENA_BLOCK_SIZE);
+    ~XmlArena();
+
+    void *alloc(size_t bytes);
+    xmlChar *strdup(const xmlChar *str);
+
+    void reset();
+
+    // Bytes held in blocks, used or not
+    size_t capacity() const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    XmlArena(const XmlArena&);
+    XmlArena& operator=(const XmlArena&);
+
+    struct Block
+    {
+        Block *next;
+        size_t size;
+        size_t used;
+    };
+
+    Block *newBlock(size_t size);
+
+    Block *pHead;
+    size_t mBlockSize;
+};
+
+#endif
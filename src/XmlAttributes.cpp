@@ -100,7 +100,7 @@ const xmlChar *XmlAttributes::localName(int index) const
     const xmlChar *colonPtr = xmlStrstr(_names(index), (xmlChar *) ":");
     if (colonPtr != NULL)
         // Peel off the prefix to return the localName.
-        return _names(index) + (_names(index) - colonPtr);
+        return colonPtr + 1;
 
     return _names(index);
 }
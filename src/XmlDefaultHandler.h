@@ -59,6 +59,17 @@
 #include "XmlReader.h"
 #include <libxml/xmlstring.h>
 
+/**
+ * \class XmlDefaultHandler
+ *
+ * \brief Handler implementing every handler interface with no-ops
+ *
+ * Derive from it and override the events of interest. The defaults
+ * return true and so keep the parse going. An override of startElement,
+ * endElement, characters or processingInstruction that returns false ends
+ * the parse successfully: the parse call still returns true. Returning
+ * false from warning, error or fatalError stops the parse with a failure.
+ */
 class KOLIBRE_API XmlDefaultHandler: public XmlContentHandler,
         public XmlLexicalHandler,
         public XmlErrorHandler,
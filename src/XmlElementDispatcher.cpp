@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <libxml/xmlmemory.h>
+
+#include "XmlElementDispatcher.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlElementDispatcherLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.xmlelementdispatcher"));
+
+// Initial number of slots in the name table
+#define DISPATCH_TABLE_SIZE 64
+
+XmlElementDispatcher::XmlElementDispatcher() :
+        m_dict(0), m_slots(0), m_slotCount(0), m_nameCount(0)
+{
+}
+
+XmlElementDispatcher::~XmlElementDispatcher()
+{
+    clear();
+    free(m_slots);
+}
+
+/**
+ * Register a handler for an element
+ *
+ * A handler registered earlier for the same element is replaced.
+ *
+ * @param uri namespace URI of the element, NULL to match any namespace
+ * @param localName local name of the element
+ * @param handler pointer to the handler, not owned
+ */
+void XmlElementDispatcher::add(const xmlChar *uri, const xmlChar *localName,
+        XmlElementHandler *handler)
+{
+    int index = findEntry(uri, localName);
+    if (index >= 0)
+    {
+        entries[index].handler = handler;
+        return;
+    }
+
+    Entry entry;
+    entry.uri = uri ? xmlStrdup(uri) : NULL;
+    entry.localName = xmlStrdup(localName);
+    entry.handler = handler;
+    entry.next = -1;
+    entries.push_back(entry);
+
+    LOG4CXX_DEBUG(xmlElementDispatcherLog,
+            "Registered handler for " << localName);
+    link();
+}
+
+/**
+ * Remove the handler for an element
+ *
+ * @param uri namespace URI used when registering
+ * @param localName local name of the element
+ */
+void XmlElementDispatcher::remove(const xmlChar *uri, const xmlChar *localName)
+{
+    int index = findEntry(uri, localName);
+    if (index < 0)
+        return;
+
+    xmlFree(entries[index].uri);
+    xmlFree(entries[index].localName);
+    entries.erase(entries.begin() + index);
+    link();
+}
+
+/**
+ * Remove all handlers
+ */
+void XmlElementDispatcher::clear()
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        xmlFree(entries[i].uri);
+        xmlFree(entries[i].localName);
+    }
+    entries.clear();
+    forgetNames();
+}
+
+bool XmlElementDispatcher::empty() const
+{
+    return entries.empty();
+}
+
+/**
+ * Prepare for a parse with the given dictionary
+ *
+ * Resolved names are only kept while the same dictionary is in use. A new
+ * dictionary may have been allocated where a freed one used to be, so
+ * names are also forgotten when the context was not reused.
+ *
+ * @param dict dictionary of the parser context
+ * @param reused true if the context of the previous parse was reset
+ */
+void XmlElementDispatcher::attach(xmlDictPtr dict, bool reused)
+{
+    if (dict != m_dict || !reused)
+        forgetNames();
+    m_dict = dict;
+}
+
+/**
+ * Find the handler for an element
+ *
+ * @param qName qualified name as reported by the parser
+ * @param localName local part of qName
+ * @param uri namespace URI of the element
+ * @return pointer to the first registered handler that matches
+ * @retval NULL if nobody registered for the element
+ */
+XmlElementHandler *XmlElementDispatcher::find(const xmlChar *qName,
+        const xmlChar *localName, const xmlChar *uri)
+{
+    if (entries.empty())
+        return NULL;
+
+    int index;
+    Slot *s = slot(qName);
+    if (s != NULL && s->name == qName)
+    {
+        index = s->entry;
+    }
+    else
+    {
+        index = resolve(localName);
+
+        // Only names owned by the dictionary stay put, the HTML parser
+        // reports some implied elements with static strings
+        if (m_dict != NULL && xmlDictOwns(m_dict, qName) == 1)
+        {
+            if ((m_nameCount + 1) * 2 > m_slotCount && grow())
+                s = slot(qName);
+            if (s != NULL && (m_nameCount + 1) < m_slotCount)
+            {
+                s->name = qName;
+                s->entry = index;
+                m_nameCount++;
+            }
+        }
+    }
+
+    if (uri == NULL)
+        uri = (const xmlChar *) "";
+
+    for (; index >= 0; index = entries[index].next)
+    {
+        const Entry &entry = entries[index];
+        if (entry.uri == NULL || xmlStrEqual(entry.uri, uri))
+            return entry.handler;
+    }
+    return NULL;
+}
+
+int XmlElementDispatcher::findEntry(const xmlChar *uri,
+        const xmlChar *localName) const
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const Entry &entry = entries[i];
+        if (!xmlStrEqual(entry.localName, localName))
+            continue;
+        if ((entry.uri == NULL && uri == NULL)
+                || (entry.uri != NULL && uri != NULL
+                        && xmlStrEqual(entry.uri, uri)))
+            return i;
+    }
+    return -1;
+}
+
+// Return the first entry registered for localName, or -1
+int XmlElementDispatcher::resolve(const xmlChar *localName) const
+{
+    for (size_t i = 0; i < entries.size(); i++)
+        if (xmlStrEqual(entries[i].localName, localName))
+            return i;
+    return -1;
+}
+
+// Chain the entries sharing a local name and drop resolved names, which
+// may point at a removed entry or miss a new one
+void XmlElementDispatcher::link()
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        entries[i].next = -1;
+        for (size_t j = i + 1; j < entries.size(); j++)
+        {
+            if (xmlStrEqual(entries[i].localName, entries[j].localName))
+            {
+                entries[i].next = j;
+                break;
+            }
+        }
+    }
+    forgetNames();
+}
+
+void XmlElementDispatcher::forgetNames()
+{
+    for (size_t i = 0; i < m_slotCount; i++)
+        m_slots[i].name = NULL;
+    m_nameCount = 0;
+}
+
+// Return the slot holding name, or the empty slot where it belongs.
+// NULL when the table has not been allocated yet.
+XmlElementDispatcher::Slot *XmlElementDispatcher::slot(const xmlChar *name)
+{
+    if (m_slotCount == 0)
+        return NULL;
+
+    size_t mask = m_slotCount - 1;
+    size_t i = ((uintptr_t) name >> 3) * 2654435761u & mask;
+    while (m_slots[i].name != NULL && m_slots[i].name != name)
+        i = (i + 1) & mask;
+    return &m_slots[i];
+}
+
+// Double the name table, on failure the old one is kept and names are
+// resolved by comparing strings until memory is available
+bool XmlElementDispatcher::grow()
+{
+    Slot *old = m_slots;
+    size_t oldCount = m_slotCount;
+    size_t count = oldCount ? oldCount * 2 : DISPATCH_TABLE_SIZE;
+
+    Slot *slots = (Slot *) calloc(count, sizeof(Slot));
+    if (slots == NULL)
+    {
+        LOG4CXX_WARN(xmlElementDispatcherLog, "Failed to grow name table");
+        return false;
+    }
+    m_slots = slots;
+    m_slotCount = count;
+
+    for (size_t i = 0; i < oldCount; i++)
+    {
+        if (old[i].name != NULL)
+            *slot(old[i].name) = old[i];
+    }
+    free(old);
+    return true;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMLELEMENTDISPATCHER_H
+#define XMLELEMENTDISPATCHER_H
+
+#include <stddef.h>
+#include <libxml/xmlstring.h>
+#include <libxml/dict.h>
+#include <vector>
+
+class XmlElementHandler;
+
+//
+// Table of element handlers registered by namespace URI and local name.
+// Lookups are keyed by the element name pointer handed out by the parser,
+// which libxml2 interns in the context dictionary, so after the first
+// occurrence of a name it is resolved without comparing strings. Names
+// nobody registered for resolve to nothing and are not dispatched.
+//
+
+class XmlElementDispatcher
+{
+public:
+    XmlElementDispatcher();
+    ~XmlElementDispatcher();
+
+    void add(const xmlChar *uri, const xmlChar *localName,
+            XmlElementHandler *handler);
+    void remove(const xmlChar *uri, const xmlChar *localName);
+    void clear();
+
+    // True if no handlers are registered
+    bool empty() const;
+
+    // Start resolving names interned in dict, forgetting names of an
+    // earlier dictionary unless the same one is reused
+    void attach(xmlDictPtr dict, bool reused);
+
+    XmlElementHandler *find(const xmlChar *qName, const xmlChar *localName,
+            const xmlChar *uri);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    XmlElementDispatcher(const XmlElementDispatcher&);
+    XmlElementDispatcher& operator=(const XmlElementDispatcher&);
+
+    struct Entry
+    {
+        xmlChar *uri; // NULL matches any namespace
+        xmlChar *localName;
+        XmlElementHandler *handler;
+        int next; // next entry with the same local name, -1 at the end
+    };
+
+    struct Slot
+    {
+        const xmlChar *name;
+        int entry; // first entry for the name, -1 if there is none
+    };
+
+    int findEntry(const xmlChar *uri, const xmlChar *localName) const;
+    int resolve(const xmlChar *localName) const;
+    void link();
+    void forgetNames();
+    Slot *slot(const xmlChar *name);
+    bool grow();
+
+    std::vector<Entry> entries;
+
+    xmlDictPtr m_dict;
+    Slot *m_slots;
+    size_t m_slotCount; // power of two
+    size_t m_nameCount;
+};
+
+#endif
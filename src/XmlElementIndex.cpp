@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "XmlElementIndex.h"
+#include "XmlReader.h"
+
+// Estimated bytes of a std::map node besides the key and value
+#define MAP_NODE_OVERHEAD 48
+
+XmlElementIndex::XmlElementIndex() :
+        m_lastNamespace(0), m_lastContext(-1), m_stringBytes(0), m_fileSize(
+                0), m_fileMtime(0), m_fileInode(0)
+{
+}
+
+/**
+ * Record an element
+ *
+ * Only the first element with a given id is kept.
+ *
+ * @param id value of the id attribute
+ * @param offset byte offset of the start tag in the document
+ * @param depth depth of the element, 1 for the root
+ * @param ns namespaces in scope at the element
+ */
+void XmlElementIndex::add(const xmlChar *id, unsigned long offset, int depth,
+        const XmlNamespace *ns)
+{
+    std::string key((const char *) id);
+    if (entries.find(key) != entries.end())
+        return;
+
+    Entry entry;
+    entry.offset = offset;
+    entry.depth = depth;
+    entry.context = context(ns);
+    entries.insert(std::make_pair(key, entry));
+    m_stringBytes += key.size() + 1;
+}
+
+/**
+ * Look up an element
+ *
+ * @param id value of the id attribute
+ * @param offset set to the byte offset of the start tag
+ * @param depth set to the depth of the element
+ * @param namespaces set to the namespace declarations in scope, formatted
+ * as attributes of a start tag
+ * @return boolean
+ * @retval true if the element was found
+ * @retval false if no element has the id
+ */
+bool XmlElementIndex::find(const std::string &id, unsigned long &offset,
+        int &depth, std::string &namespaces) const
+{
+    std::map<std::string, Entry>::const_iterator it = entries.find(id);
+    if (it == entries.end())
+        return false;
+
+    offset = it->second.offset;
+    depth = it->second.depth;
+    namespaces = contexts[it->second.context];
+    return true;
+}
+
+size_t XmlElementIndex::size() const
+{
+    return entries.size();
+}
+
+unsigned long XmlElementIndex::getMemoryUsage() const
+{
+    unsigned long usage = sizeof(XmlElementIndex) + m_stringBytes
+            + entries.size() * (sizeof(std::string) + sizeof(Entry)
+                    + MAP_NODE_OVERHEAD);
+    for (size_t i = 0; i < contexts.size(); i++)
+        usage += sizeof(std::string) + contexts[i].capacity();
+    return usage;
+}
+
+void XmlElementIndex::setFileState(off_t size, time_t mtime, ino_t inode)
+{
+    m_fileSize = size;
+    m_fileMtime = mtime;
+    m_fileInode = inode;
+}
+
+bool XmlElementIndex::matchesFileState(off_t size, time_t mtime,
+        ino_t inode) const
+{
+    return m_fileSize == size && m_fileMtime == mtime && m_fileInode == inode;
+}
+
+// Append value to out as the value of an attribute in double quotes.
+// Values come from the parser with references to '&' kept as "&#38;",
+// so an ampersand is passed on as it is.
+static void appendEscaped(std::string &out, const xmlChar *value)
+{
+    for (const xmlChar *p = value; *p != '\0'; p++)
+    {
+        switch (*p)
+        {
+        case '<':
+            out += "&lt;";
+            break;
+        case '"':
+            out += "&quot;";
+            break;
+        default:
+            out += (char) *p;
+        }
+    }
+}
+
+/**
+ * Stop remembering a namespace
+ *
+ * @param ns namespace that is released
+ */
+void XmlElementIndex::forget(const XmlNamespace *ns)
+{
+    if (ns == m_lastNamespace)
+    {
+        m_lastNamespace = NULL;
+        m_lastContext = -1;
+    }
+}
+
+// Return the index of the declarations in scope at ns, adding them when
+// they differ from the previous element's. Documents rarely have more
+// than a few distinct sets.
+int XmlElementIndex::context(const XmlNamespace *ns)
+{
+    if (ns == m_lastNamespace && m_lastContext >= 0)
+        return m_lastContext;
+
+    // Innermost first, declared in the opposite order so that the wrapper
+    // builds the same chain of namespaces
+    std::vector<const XmlNamespace *> scope;
+    for (const XmlNamespace *n = ns; n != NULL; n = n->m_parent)
+    {
+        bool shadowed = false;
+        for (size_t i = 0; i < scope.size() && !shadowed; i++)
+            shadowed = xmlStrEqual(scope[i]->m_prefix, n->m_prefix);
+
+        // The empty root namespace needs no declaration
+        if (!shadowed && (n->m_parent != NULL || n->m_prefix[0] != '\0'
+                || n->m_uri[0] != '\0'))
+            scope.push_back(n);
+    }
+
+    std::string declarations;
+    for (size_t i = scope.size(); i > 0; i--)
+    {
+        const XmlNamespace *n = scope[i - 1];
+        declarations += " xmlns";
+        if (n->m_prefix[0] != '\0')
+        {
+            declarations += ':';
+            declarations += (const char *) n->m_prefix;
+        }
+        declarations += "=\"";
+        appendEscaped(declarations, n->m_uri);
+        declarations += '"';
+    }
+
+    m_lastNamespace = ns;
+    for (size_t i = contexts.size(); i > 0; i--)
+    {
+        if (contexts[i - 1] == declarations)
+        {
+            m_lastContext = i - 1;
+            return m_lastContext;
+        }
+    }
+    contexts.push_back(declarations);
+    m_lastContext = contexts.size() - 1;
+    return m_lastContext;
+}
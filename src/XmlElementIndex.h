@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMLELEMENTINDEX_H
+#define XMLELEMENTINDEX_H
+
+#include <sys/types.h>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+#include <libxml/xmlstring.h>
+
+struct XmlNamespace;
+
+//
+// Byte offsets of the elements with an id attribute in a document, built
+// while parsing it. Each element also has its depth and the namespace
+// declarations in scope, which is what it takes to parse the element on
+// its own starting from its offset.
+//
+
+class XmlElementIndex
+{
+public:
+    XmlElementIndex();
+
+    void add(const xmlChar *id, unsigned long offset, int depth,
+            const XmlNamespace *ns);
+    bool find(const std::string &id, unsigned long &offset, int &depth,
+            std::string &namespaces) const;
+
+    size_t size() const;
+
+    // The namespace is released, its address may be reused
+    void forget(const XmlNamespace *ns);
+
+    // Bytes used by the index
+    unsigned long getMemoryUsage() const;
+
+    // State of the local file the index was built from
+    void setFileState(off_t size, time_t mtime, ino_t inode);
+    bool matchesFileState(off_t size, time_t mtime, ino_t inode) const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    XmlElementIndex(const XmlElementIndex&);
+    XmlElementIndex& operator=(const XmlElementIndex&);
+
+    struct Entry
+    {
+        unsigned long offset; // byte offset of the '<' of the start tag
+        int depth; // 1 for the root element
+        int context; // index into contexts
+    };
+
+    int context(const XmlNamespace *ns);
+
+    std::map<std::string, Entry> entries;
+
+    // Namespace declarations, formatted as attributes
+    std::vector<std::string> contexts;
+    const XmlNamespace *m_lastNamespace;
+    int m_lastContext;
+    unsigned long m_stringBytes;
+
+    off_t m_fileSize;
+    time_t m_fileMtime;
+    ino_t m_fileInode;
+};
+
+#endif
@@ -0,0 +1,462 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+
+#include "XmlPullReader.h"
+#include "XmlError.h"
+#include "DataSource.h"
+#include "InputStream.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlPullReaderLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.xmlpullreader"));
+
+XmlPullReader::XmlPullReader() :
+        m_reader(NULL), m_source(NULL), m_stream(NULL), pLastError(NULL), m_nodeType(
+                NONE), m_pendingEnd(false), m_positioned(false), m_positionResult(
+                0), bUseCache(true)
+{
+}
+
+XmlPullReader::~XmlPullReader()
+{
+    close();
+    setLastError(NULL);
+}
+
+/**
+ * Open a XML resource
+ *
+ * Nothing is parsed until next() is called.
+ *
+ * @param uri location of the XML resource
+ * @return boolean of the result
+ * @retval false if the resource could not be opened
+ * @retval true if the cursor is ready
+ */
+bool XmlPullReader::open(const char *uri)
+{
+    close();
+    setLastError(NULL);
+
+    m_source = new DataSource(uri);
+    m_stream = m_source->makeStream();
+    if (m_stream == NULL)
+    {
+        LOG4CXX_ERROR(xmlPullReaderLog, "Failed to create InputStream");
+        setLastError(
+                new XmlError(XML_FROM_IO, -1, "Failed to create InputStream"));
+        close();
+        return false;
+    }
+    m_stream->useCache(bUseCache);
+
+    m_reader = xmlReaderForIO(staticReadCallback, NULL, this, uri, NULL, 0);
+    if (m_reader == NULL)
+    {
+        LOG4CXX_ERROR(xmlPullReaderLog, "Failed to create reader for '" << uri << "'");
+        if (pLastError == NULL)
+            setLastError(
+                    new XmlError(XML_FROM_PARSER, -1,
+                            "Failed to create xmlTextReader"));
+        close();
+        return false;
+    }
+    xmlTextReaderSetStructuredErrorHandler(m_reader, staticErrorCallback, this);
+
+    LOG4CXX_DEBUG(xmlPullReaderLog, "Opened '" << uri << "'");
+    return true;
+}
+
+/**
+ * Release the resource and the parser
+ */
+void XmlPullReader::close()
+{
+    if (m_reader != NULL)
+    {
+        xmlFreeTextReader(m_reader);
+        m_reader = NULL;
+    }
+
+    // The stream is owned by the data source
+    delete m_source;
+    m_source = NULL;
+    m_stream = NULL;
+
+    m_nodeType = NONE;
+    m_pendingEnd = false;
+    m_positioned = false;
+}
+
+/**
+ * Move the cursor to the next node
+ *
+ * Document type declarations, entity references and the like are passed
+ * over. Empty elements are reported as a START_ELEMENT followed by an
+ * END_ELEMENT.
+ *
+ * @return type of the new current node
+ * @retval END_DOCUMENT if the document has been read
+ * @retval NONE if an error occurred, see getLastError()
+ */
+XmlPullReader::NodeType XmlPullReader::next()
+{
+    if (m_reader == NULL || m_nodeType == END_DOCUMENT)
+        return m_nodeType;
+
+    if (m_pendingEnd)
+    {
+        m_pendingEnd = false;
+        m_nodeType = END_ELEMENT;
+        return m_nodeType;
+    }
+
+    for (;;)
+    {
+        int ret;
+        if (m_positioned)
+        {
+            m_positioned = false;
+            ret = m_positionResult;
+        }
+        else
+        {
+            ret = xmlTextReaderRead(m_reader);
+        }
+
+        if (ret < 0)
+            return fail();
+
+        if (ret == 0)
+        {
+            m_nodeType = END_DOCUMENT;
+            return m_nodeType;
+        }
+
+        switch (xmlTextReaderNodeType(m_reader))
+        {
+        case XML_READER_TYPE_ELEMENT:
+            m_nodeType = START_ELEMENT;
+            m_pendingEnd = xmlTextReaderIsEmptyElement(m_reader) == 1;
+            return m_nodeType;
+        case XML_READER_TYPE_END_ELEMENT:
+            m_nodeType = END_ELEMENT;
+            return m_nodeType;
+        case XML_READER_TYPE_TEXT:
+        case XML_READER_TYPE_WHITESPACE:
+        case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+            m_nodeType = CHARACTERS;
+            return m_nodeType;
+        case XML_READER_TYPE_CDATA:
+            m_nodeType = CDATA;
+            return m_nodeType;
+        case XML_READER_TYPE_COMMENT:
+            m_nodeType = COMMENT;
+            return m_nodeType;
+        case XML_READER_TYPE_PROCESSING_INSTRUCTION:
+            m_nodeType = PROCESSING_INSTRUCTION;
+            return m_nodeType;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * Skip the rest of the current element
+ *
+ * When the cursor is on a START_ELEMENT the element's content and end tag
+ * are passed over without being reported, and the next call to next()
+ * returns the node following the element. The skipped content is still
+ * read, but no nodes are built for it.
+ *
+ * @return boolean of the result
+ * @retval false if the cursor is not on a start tag or an error occurred
+ * @retval true if the element was skipped
+ */
+bool XmlPullReader::skipSubtree()
+{
+    if (m_reader == NULL || m_nodeType != START_ELEMENT || m_positioned)
+        return false;
+
+    if (m_pendingEnd)
+    {
+        m_pendingEnd = false;
+        return true;
+    }
+
+    int ret = xmlTextReaderNext(m_reader);
+    if (ret < 0)
+    {
+        fail();
+        return false;
+    }
+
+    m_positioned = true;
+    m_positionResult = ret;
+    return true;
+}
+
+/**
+ * Get the type of the current node
+ */
+XmlPullReader::NodeType XmlPullReader::nodeType() const
+{
+    return m_nodeType;
+}
+
+/**
+ * Get the local name of the current element, or the target of a
+ * processing instruction
+ *
+ * @return pointer to the name
+ * @retval NULL if the node has no name
+ */
+const xmlChar *XmlPullReader::localName() const
+{
+    if (m_nodeType == START_ELEMENT || m_nodeType == END_ELEMENT
+            || m_nodeType == PROCESSING_INSTRUCTION)
+        return xmlTextReaderConstLocalName(m_reader);
+    return NULL;
+}
+
+/**
+ * Get the qualified name of the current element
+ *
+ * @return pointer to the name
+ * @retval NULL if the node has no name
+ */
+const xmlChar *XmlPullReader::qName() const
+{
+    if (m_nodeType == START_ELEMENT || m_nodeType == END_ELEMENT
+            || m_nodeType == PROCESSING_INSTRUCTION)
+        return xmlTextReaderConstName(m_reader);
+    return NULL;
+}
+
+/**
+ * Get the namespace uri of the current element
+ *
+ * @return pointer to the uri
+ * @retval NULL if the element is not in a namespace
+ */
+const xmlChar *XmlPullReader::namespaceURI() const
+{
+    if (m_nodeType == START_ELEMENT || m_nodeType == END_ELEMENT)
+        return xmlTextReaderConstNamespaceUri(m_reader);
+    return NULL;
+}
+
+/**
+ * Get the text of a character, CDATA, comment or processing instruction node
+ *
+ * @return pointer to the text
+ * @retval NULL if the node has no text
+ */
+const xmlChar *XmlPullReader::value() const
+{
+    if (m_nodeType == CHARACTERS || m_nodeType == CDATA
+            || m_nodeType == COMMENT || m_nodeType == PROCESSING_INSTRUCTION)
+        return xmlTextReaderConstValue(m_reader);
+    return NULL;
+}
+
+/**
+ * Get the depth of the current node, the root element is at depth 0
+ *
+ * @retval -1 if there is no current node
+ */
+int XmlPullReader::depth() const
+{
+    if (m_reader == NULL || m_nodeType == NONE || m_nodeType == END_DOCUMENT)
+        return -1;
+    return xmlTextReaderDepth(m_reader);
+}
+
+/**
+ * Check if the current element was written as an empty tag
+ */
+bool XmlPullReader::isEmptyElement() const
+{
+    return m_nodeType == START_ELEMENT && m_pendingEnd;
+}
+
+/**
+ * Get the number of attributes on the current start tag
+ *
+ * Namespace declarations are counted as attributes, as in XmlAttributes.
+ */
+int XmlPullReader::attributeCount() const
+{
+    if (m_nodeType != START_ELEMENT)
+        return 0;
+    return xmlTextReaderAttributeCount(m_reader);
+}
+
+/**
+ * Get the qualified name of an attribute
+ *
+ * @param index position of the attribute
+ * @return pointer to the name
+ * @retval NULL if there is no such attribute
+ */
+const xmlChar *XmlPullReader::attributeQName(int index) const
+{
+    if (m_nodeType != START_ELEMENT
+            || xmlTextReaderMoveToAttributeNo(m_reader, index) != 1)
+        return NULL;
+    const xmlChar *name = xmlTextReaderConstName(m_reader);
+    xmlTextReaderMoveToElement(m_reader);
+    return name;
+}
+
+/**
+ * Get the value of an attribute
+ *
+ * The value is valid until the next attribute value is requested.
+ *
+ * @param index position of the attribute
+ * @return pointer to the value
+ * @retval NULL if there is no such attribute
+ */
+const xmlChar *XmlPullReader::attributeValue(int index) const
+{
+    if (m_nodeType != START_ELEMENT
+            || xmlTextReaderMoveToAttributeNo(m_reader, index) != 1)
+        return NULL;
+    const xmlChar *value = xmlTextReaderConstValue(m_reader);
+    xmlTextReaderMoveToElement(m_reader);
+    return value;
+}
+
+/**
+ * Get the value of an attribute by name
+ *
+ * The value is valid until the next attribute value is requested.
+ *
+ * @param qName qualified name of the attribute
+ * @return pointer to the value
+ * @retval NULL if there is no such attribute
+ */
+const xmlChar *XmlPullReader::attribute(const xmlChar *qName) const
+{
+    if (m_nodeType != START_ELEMENT
+            || xmlTextReaderMoveToAttribute(m_reader, qName) != 1)
+        return NULL;
+    const xmlChar *value = xmlTextReaderConstValue(m_reader);
+    xmlTextReaderMoveToElement(m_reader);
+    return value;
+}
+
+/**
+ * Enable or disable the cache for resources opened after this call
+ */
+void XmlPullReader::useCache(bool setting)
+{
+    bUseCache = setting;
+}
+
+/**
+ * Get last error
+ *
+ * @return pointer to a XmlError object
+ * @retval NULL if no error occurred
+ */
+const XmlError *XmlPullReader::getLastError() const
+{
+    return pLastError;
+}
+
+void XmlPullReader::setLastError(XmlError *e)
+{
+    if (pLastError != NULL)
+        delete pLastError;
+    pLastError = e;
+}
+
+// Stop reading after a failed read or parse
+XmlPullReader::NodeType XmlPullReader::fail()
+{
+    if (pLastError == NULL)
+        setLastError(new XmlError(XML_FROM_PARSER, -1, "Failed to read node"));
+    LOG4CXX_ERROR(xmlPullReaderLog, "Read failed: " << pLastError->getMessage());
+
+    // Keep the stream, the caller may still query the error
+    if (m_reader != NULL)
+    {
+        xmlFreeTextReader(m_reader);
+        m_reader = NULL;
+    }
+    m_nodeType = NONE;
+    m_pendingEnd = false;
+    m_positioned = false;
+    return m_nodeType;
+}
+
+int XmlPullReader::staticReadCallback(void *context, char *buffer, int len)
+{
+    XmlPullReader *reader = (XmlPullReader *) context;
+    int bytes_read;
+    try
+    {
+        bytes_read = reader->m_stream->readBytes(buffer, len);
+    } catch (XmlError e)
+    {
+        reader->setLastError(new XmlError(e));
+        return -1;
+    }
+
+    if (bytes_read < 0)
+    {
+        LOG4CXX_ERROR(xmlPullReaderLog,
+                "Read error " << reader->m_stream->getErrorMsg());
+        reader->setLastError(
+                new XmlError(XML_FROM_IO, (int) reader->m_stream->getErrorCode(),
+                        reader->m_stream->getErrorMsg()));
+        return -1;
+    }
+    return bytes_read;
+}
+
+#if LIBXML_VERSION >= 21200
+void XmlPullReader::staticErrorCallback(void *arg, const xmlError *error)
+#else
+void XmlPullReader::staticErrorCallback(void *arg, xmlErrorPtr error)
+#endif
+{
+    XmlPullReader *reader = (XmlPullReader *) arg;
+    if (error == NULL)
+        return;
+
+    if (error->level == XML_ERR_WARNING)
+    {
+        LOG4CXX_WARN(xmlPullReaderLog, "Warning: " << error->message);
+        return;
+    }
+
+    // Keep the first error, an I/O failure is reported again by the parser
+    if (reader->pLastError == NULL)
+        reader->setLastError(
+                new XmlError(error->domain, error->code,
+                        std::string(error->message ? error->message : ""),
+                        error->int2, error->line));
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMLPULLREADER_H
+#define XMLPULLREADER_H
+
+#ifdef WIN32
+#ifdef KOLIBRE_DLL
+#define KOLIBRE_API __declspec(dllexport)
+#else
+#define KOLIBRE_API __declspec(dllimport)
+#endif
+#else
+#define KOLIBRE_API
+#endif
+
+#include <libxml/xmlreader.h>
+#include <libxml/xmlstring.h>
+
+class DataSource;
+class InputStream;
+class XmlError;
+
+/**
+ * \class XmlPullReader
+ *
+ * \brief Cursor style reader for XML resources
+ *
+ * Instead of receiving callbacks the caller moves through the document with
+ * next() and inspects the current node. Data is read through the same
+ * InputStream pipeline and cache as XmlReader, and only as far as the cursor
+ * has advanced. Strings returned by the accessors are valid until the next
+ * call to next() or skipSubtree().
+ */
+class KOLIBRE_API XmlPullReader
+{
+public:
+    /**
+     * Type of the node under the cursor
+     */
+    enum NodeType
+    {
+        NONE, /**< before the first call to next() or after an error */
+        START_ELEMENT, /**< start tag, attributes are available */
+        END_ELEMENT, /**< end tag, also reported for empty elements */
+        CHARACTERS, /**< text or whitespace */
+        CDATA, /**< CDATA section */
+        COMMENT, /**< comment */
+        PROCESSING_INSTRUCTION, /**< processing instruction */
+        END_DOCUMENT /**< no more nodes */
+    };
+
+    XmlPullReader();
+    ~XmlPullReader();
+
+    bool open(const char *uri);
+    void close();
+
+    NodeType next();
+    bool skipSubtree();
+
+    NodeType nodeType() const;
+    const xmlChar *localName() const;
+    const xmlChar *qName() const;
+    const xmlChar *namespaceURI() const;
+    const xmlChar *value() const;
+    int depth() const;
+    bool isEmptyElement() const;
+
+    int attributeCount() const;
+    const xmlChar *attributeQName(int index) const;
+    const xmlChar *attributeValue(int index) const;
+    const xmlChar *attribute(const xmlChar *qName) const;
+
+    void useCache(bool setting);
+
+    const XmlError *getLastError() const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    XmlPullReader(const XmlPullReader&);
+    XmlPullReader& operator=(const XmlPullReader&);
+
+    void setLastError(XmlError *);
+    NodeType fail();
+
+    static int staticReadCallback(void *context, char *buffer, int len);
+#if LIBXML_VERSION >= 21200
+    static void staticErrorCallback(void *arg, const xmlError *error);
+#else
+    static void staticErrorCallback(void *arg, xmlErrorPtr error);
+#endif
+
+    xmlTextReaderPtr m_reader;
+    DataSource *m_source;
+    InputStream *m_stream;
+    XmlError *pLastError;
+
+    NodeType m_nodeType;
+    bool m_pendingEnd; // report END_ELEMENT for the current empty element
+    bool m_positioned; // skipSubtree already moved the reader to the next node
+    int m_positionResult; // return value of that move
+    bool bUseCache;
+};
+
+#endif
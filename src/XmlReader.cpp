@@ -55,11 +55,20 @@
 #include "XmlDefaultHandler.h"
 
 #include "DataSource.h"
+#include "DataStreamHandler.h"
+#include "HtmlEntities.h"
+#include "DtdCache.h"
+#include "XmlArena.h"
+#include "XmlElementDispatcher.h"
+#include "XmlElementIndex.h"
 
 #include <malloc.h>
 #include <libxml/encoding.h>
+#include <libxml/HTMLparser.h>
+#include <libxml/parserInternals.h>
 
 #include <cstring>
+#include <new>
 #include <sstream>
 
 #include <log4cxx/logger.h>
@@ -68,17 +77,110 @@
 log4cxx::LoggerPtr xmlXmlReaderLog(
         log4cxx::Logger::getLogger("kolibre.xmlreader.xmlreader"));
 
+// Names a kept parser context may collect before it is recreated
+#define MAX_CONTEXT_DICT_SIZE 16384
+
+// Largest block passed to the parser at once by feed()
+#define MAX_FEED_CHUNK 1048576
+
+// Element that holds the namespace declarations in scope at a fragment
+#define FRAGMENT_WRAPPER "kolibre-fragment"
+
+// Initial size of the buffer for coalesced text, and the size it may keep
+// between parses
+#define TEXT_BUFFER_SIZE 1024
+#define MAX_TEXT_BUFFER_SIZE 65536
+
+/**
+ * Gives the SAX callbacks access to the parse state of the reader
+ */
+class XmlReaderAccess
+{
+public:
+    static bool skipping(const XmlReader *reader)
+    {
+        return reader->skippingSubtree();
+    }
+
+    static bool startElement(XmlReader *reader)
+    {
+        return reader->skipStartElement();
+    }
+
+    static bool endElement(XmlReader *reader)
+    {
+        return reader->skipEndElement();
+    }
+
+    static bool enterElement(XmlReader *reader, const XmlAttributes &attributes)
+    {
+        return reader->enterElement(attributes);
+    }
+
+    static void leaveElement(XmlReader *reader)
+    {
+        reader->leaveElement();
+    }
+
+    static bool inFragment(const XmlReader *reader)
+    {
+        return reader->inFragment();
+    }
+
+    static bool documentEvents(const XmlReader *reader)
+    {
+        return reader->documentEvents();
+    }
+
+    static XmlElementHandler *elementHandler(XmlReader *reader,
+            const xmlChar *qName, const xmlChar *localName,
+            const xmlChar *namespaceURI)
+    {
+        return reader->elementHandler(qName, localName, namespaceURI);
+    }
+
+    static void releaseNamespace(XmlReader *reader, XmlNamespace *ns)
+    {
+        reader->releaseNamespace(ns);
+    }
+
+    static bool bufferCharacters(XmlReader *reader, const xmlChar *s, int len)
+    {
+        return reader->bufferCharacters(s, len);
+    }
+
+    static bool flushCharacters(XmlReader *reader)
+    {
+        return reader->flushCharacters();
+    }
+
+    static void useDtd(XmlReader *reader, const xmlChar *publicId,
+            const xmlChar *systemId)
+    {
+        reader->useDtd(publicId, systemId);
+    }
+
+    static xmlEntityPtr dtdEntity(const XmlReader *reader, const xmlChar *name)
+    {
+        return reader->dtdEntity(name);
+    }
+};
+
 static void startDocumentHandler(void *userData)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
     LOG4CXX_DEBUG(xmlXmlReaderLog, "startDocumentHandler()");
-    reader->contentHandler()->startDocument();
+    if (XmlReaderAccess::documentEvents(reader))
+        reader->contentHandler()->startDocument();
 }
 
 static void endDocumentHandler(void *userData)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
     LOG4CXX_DEBUG(xmlXmlReaderLog, "endDocumentHandler()");
+    if (!XmlReaderAccess::documentEvents(reader))
+        return;
+    XmlReaderAccess::flushCharacters(reader);
     reader->endDocumentHandlerCalled();
     reader->contentHandler()->endDocument();
 }
@@ -90,7 +192,8 @@ static void startElementHandler(void *userData, const xmlChar *name,
 
     LOG4CXX_TRACE(xmlXmlReaderLog, "startElementHandler() for " << name);
 
-    if (reader->parserStopped())
+    if (reader->parserStopped() || XmlReaderAccess::startElement(reader)
+            || !XmlReaderAccess::flushCharacters(reader))
     {
         return;
     }
@@ -101,35 +204,42 @@ static void startElementHandler(void *userData, const xmlChar *name,
     attributes.split(ns);
 
     const xmlChar *qName = name;
-    xmlChar *localName = NULL;
+    const xmlChar *localName = qName;
     const xmlChar *uri = NULL;
-    const xmlChar *colonPtr = xmlStrstr(qName, (xmlChar *) ":");
+    const xmlChar *colonPtr = xmlStrchr(qName, ':');
 
+    // The local name is the tail of the qualified name, no copy needed
     if (colonPtr != NULL)
+        localName = colonPtr + 1;
+
+    uri = reader->xmlNamespace()->uriForPrefix(qName);
+
+    if (!XmlReaderAccess::enterElement(reader, attributes))
+        return;
+
+    XmlElementHandler *handler = XmlReaderAccess::elementHandler(reader,
+            qName, localName, uri);
+    if (handler != NULL && !handler->startElement(uri, localName, attributes))
     {
-        localName = xmlStrdup(qName + (colonPtr - qName) + 1);
+        reader->finishParsing();
+        return;
     }
 
-    uri = reader->xmlNamespace()->uriForPrefix(qName);
+    if (reader->contentHandler() == NULL)
+        return;
 
     // We pass in the namespace of the element, and then the name both with and without
     // the namespace prefix.
-    if (localName != NULL)
-    {
-        reader->contentHandler()->startElement(uri, localName, qName,
-                attributes);
-        free(localName);
-    }
-    else
-    {
-        reader->contentHandler()->startElement(uri, qName, qName, attributes);
-    }
+    if (!reader->contentHandler()->startElement(uri, localName, qName,
+            attributes))
+        reader->finishParsing();
 }
 
 static void endElementHandler(void *userData, const xmlChar *name)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
-    if (reader->parserStopped())
+    if (reader->parserStopped() || XmlReaderAccess::endElement(reader)
+            || !XmlReaderAccess::flushCharacters(reader))
     {
         return;
     }
@@ -137,67 +247,86 @@ static void endElementHandler(void *userData, const xmlChar *name)
     LOG4CXX_TRACE(xmlXmlReaderLog, "endElementHandler() for " << name);
 
     const xmlChar *qName = name;
-    xmlChar *localName = NULL;
+    const xmlChar *localName = qName;
     const xmlChar *uri = NULL;
-    const xmlChar *colonPtr = xmlStrstr(qName, (xmlChar *) ":");
+    const xmlChar *colonPtr = xmlStrchr(qName, ':');
 
     if (colonPtr != NULL)
-    {
-        localName = xmlStrdup(qName + (colonPtr - qName) + 1);
-    }
+        localName = colonPtr + 1;
 
     uri = reader->xmlNamespace()->uriForPrefix(qName);
 
-    if (localName != NULL)
+    bool ret = true;
+    if (XmlReaderAccess::inFragment(reader))
     {
-        reader->contentHandler()->endElement(uri, localName, qName);
-        free(localName);
+        XmlElementHandler *handler = XmlReaderAccess::elementHandler(reader,
+                qName, localName, uri);
+        if (handler != NULL)
+            ret = handler->endElement(uri, localName);
+        if (ret && reader->contentHandler() != NULL)
+            ret = reader->contentHandler()->endElement(uri, localName, qName);
     }
-    else
-        reader->contentHandler()->endElement(uri, qName, qName);
 
-    XmlNamespace* ns = reader->popNamespaces();
-    if (ns)
-        ns->deref();
+    XmlReaderAccess::releaseNamespace(reader, reader->popNamespaces());
+
+    XmlReaderAccess::leaveElement(reader);
+
+    if (!ret)
+        reader->finishParsing();
 }
 
 static void charactersHandler(void *userData, const xmlChar *s, int len)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
-    if (reader->parserStopped())
+    if (reader->parserStopped() || XmlReaderAccess::skipping(reader)
+            || XmlReaderAccess::bufferCharacters(reader, s, len))
     {
         return;
     }
 
-    reader->contentHandler()->characters(s, len);
+    if (!reader->contentHandler()->characters(s, len))
+        reader->finishParsing();
 }
 
 static void processingInstructionHandler(void *userData, const xmlChar *target,
         const xmlChar *data)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
-    if (reader->parserStopped())
+    if (reader->parserStopped() || XmlReaderAccess::skipping(reader)
+            || !XmlReaderAccess::flushCharacters(reader))
     {
         return;
     }
-    reader->contentHandler()->processingInstruction(target, data);
+    if (!reader->contentHandler()->processingInstruction(target, data))
+        reader->finishParsing();
 }
 
 static void cdataBlockHandler(void *userData, const xmlChar *s, int len)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
-    if (reader->parserStopped())
+    if (reader->parserStopped() || XmlReaderAccess::skipping(reader)
+            || !XmlReaderAccess::flushCharacters(reader))
     {
         return;
     }
+    // Element handlers alone may be set along with the lexical handler
+    bool ret = true;
     reader->lexicalHandler()->startCDATA();
-    reader->contentHandler()->characters(s, len);
+    if (reader->contentHandler() != NULL)
+        ret = reader->contentHandler()->characters(s, len);
     reader->lexicalHandler()->endCDATA();
+    if (!ret)
+        reader->finishParsing();
 }
 
 static void commentHandler(void *userData, const xmlChar *comment)
 {
     XmlReader *reader = static_cast<XmlReader *>(userData);
+    if (reader->parserStopped() || XmlReaderAccess::skipping(reader)
+            || !XmlReaderAccess::flushCharacters(reader))
+    {
+        return;
+    }
     reader->lexicalHandler()->comment(comment);
 }
 
@@ -306,6 +435,13 @@ static void normalErrorHandler(void *userData, const char *message, ...)
     }
 }
 
+static void externalSubsetHandler(void *userData, const xmlChar *name,
+        const xmlChar *ExternalID, const xmlChar *SystemID)
+{
+    XmlReader *reader = static_cast<XmlReader *>(userData);
+    XmlReaderAccess::useDtd(reader, ExternalID, SystemID);
+}
+
 static xmlEntity xmlEntityUnknown =
 { NULL, XML_ENTITY_DECL, BAD_CAST "?", NULL, NULL, NULL, NULL, NULL, NULL,
         BAD_CAST "_", BAD_CAST "_", 1, XML_INTERNAL_PREDEFINED_ENTITY, NULL,
@@ -315,6 +451,14 @@ static xmlEntityPtr entityHandler(void *user_data, const xmlChar *name)
 {
     xmlEntityPtr entity = xmlGetPredefinedEntity(name);
 
+    if (entity == NULL)
+        entity = XmlReaderAccess::dtdEntity(
+                static_cast<XmlReader *>(user_data), name);
+
+    // Documents in XHTML often use the HTML entities without a DTD
+    if (entity == NULL)
+        entity = getHtmlEntity(name);
+
     if (entity == NULL)
     {
         warningHandler(user_data, "Unknown entity '%s'", BAD_CAST name);
@@ -323,13 +467,40 @@ static xmlEntityPtr entityHandler(void *user_data, const xmlChar *name)
     return entity;
 }
 
+/**
+ * Constructor for a namespace whose strings are owned by the caller
+ *
+ * @param parent pointer to parent namespace
+ * @param p pointer to namespace prefix, not copied
+ * @param u pointer to namespace uri, not copied
+ */
+XmlNamespace::XmlNamespace(XmlNamespace* parent, xmlChar * p, xmlChar * u) :
+        m_prefix(p), m_uri(u), m_parent(parent), m_ref(0)
+{
+    if (m_parent)
+        m_parent->ref();
+}
+
+/*
+ * A namespace of the reader and its strings share one arena allocation,
+ * laid out as this header, the XmlNamespace, the prefix and the uri.
+ * Released namespaces are kept on a free list for the next declarations.
+ */
+struct nsBlock
+{
+    nsBlock *next; // next released block
+    size_t size; // bytes for the strings
+};
+
 /**
  * Constructor
  */
 XmlReader::XmlReader() :
         _contentHandler(0), _declarationHandler(0), _DTDHandler(0), _errorHandler(
-                0), _lexicalHandler(0), stackcount(0), m_doctype(DOCTYPE_XML), pLastError(
-                0)
+                0), _lexicalHandler(0), pElementDispatcher(0), nsStackFree(0), nsFree(0), stackcount(0), pArena(
+                0), m_context(0), m_xmlContext(0), m_htmlContext(0), m_doctype(
+                DOCTYPE_XML), m_skipDepth(0), m_feeding(false), m_textBuffer(0), m_textLength(
+                0), m_textCapacity(0), m_dtd(0), pLastError(0)
 
 {
     static bool didInit = false;
@@ -343,7 +514,19 @@ XmlReader::XmlReader() :
     nsStackCur->ns = NULL;
     nsStackCur->prev = NULL;
 
+    pArena = new XmlArena();
+    pElementDispatcher = new XmlElementDispatcher();
+
     bUseCache = true;
+    bCoalesceCharacters = false;
+
+    m_depth = 0;
+    pElementIndex = NULL;
+    bBuildElementIndex = false;
+    m_fragmentMode = FRAGMENT_OFF;
+    m_fragmentDepth = 0;
+    m_fragmentFound = false;
+    m_inputStart = 0;
 }
 
 /**
@@ -351,10 +534,17 @@ XmlReader::XmlReader() :
  */
 XmlReader::~XmlReader()
 {
-    XmlNamespace *ns = popNamespaces();
-    while (ns != NULL)
-        ns = popNamespaces();
+    if (m_xmlContext != NULL)
+        freeContext(m_xmlContext, false);
+    if (m_htmlContext != NULL)
+        freeContext(m_htmlContext, true);
+
+    resetNamespaces();
     free(nsStackCur);
+    delete pArena;
+    delete pElementDispatcher;
+    delete pElementIndex;
+    free(m_textBuffer);
     if (pLastError)
         delete pLastError;
 }
@@ -371,6 +561,99 @@ void XmlReader::useCache(bool setting)
     bUseCache = setting;
 }
 
+/**
+ * Specify whether character data is delivered in one piece
+ *
+ * libxml2 reports text in fragments that follow chunk and entity
+ * boundaries. When coalescing, the fragments are collected in a buffer
+ * kept by the reader and the text between two other events is delivered
+ * with a single, NUL terminated, characters() call. The default is false.
+ *
+ * @param setting true to coalesce and false to pass fragments through
+ */
+void XmlReader::coalesceCharacters(bool setting)
+{
+    bCoalesceCharacters = setting;
+}
+
+/**
+ * Specify whether parsed documents are indexed
+ *
+ * When on, parseXml() records the byte offset, depth and namespaces in
+ * scope of every element with an id or xml:id attribute in a UTF-8
+ * document. The index is kept with the cached resource, or for a local
+ * file until the file changes, and lets parseFragment() start parsing at
+ * the element. Only documents parsed to the end are indexed. The default
+ * is false.
+ *
+ * @param setting true to index and false not to
+ */
+void XmlReader::buildElementIndex(bool setting)
+{
+    bBuildElementIndex = setting;
+}
+
+/**
+ * Collect character data when coalescing
+ *
+ * @param chars pointer to the characters
+ * @param length number of bytes
+ * @return boolean
+ * @retval true if the characters were buffered
+ * @retval false if they should be delivered as they are
+ */
+bool XmlReader::bufferCharacters(const xmlChar *chars, int length)
+{
+    if (!bCoalesceCharacters)
+        return false;
+
+    if (m_textLength + length + 1 > m_textCapacity)
+    {
+        size_t capacity = m_textCapacity ? m_textCapacity : TEXT_BUFFER_SIZE;
+        while (m_textLength + length + 1 > capacity)
+            capacity *= 2;
+
+        xmlChar *buffer = (xmlChar *) realloc(m_textBuffer, capacity);
+        if (buffer == NULL)
+        {
+            LOG4CXX_WARN(xmlXmlReaderLog,
+                    "Failed to grow text buffer to " << capacity << " bytes");
+            flushCharacters();
+            return false;
+        }
+        m_textBuffer = buffer;
+        m_textCapacity = capacity;
+    }
+
+    std::memcpy(m_textBuffer + m_textLength, chars, length);
+    m_textLength += length;
+    return true;
+}
+
+/**
+ * Deliver the collected character data
+ *
+ * @return boolean
+ * @retval false if the content handler asked to stop
+ * @retval true if parsing may continue
+ */
+bool XmlReader::flushCharacters()
+{
+    if (m_textLength == 0)
+        return true;
+
+    unsigned int length = m_textLength;
+    m_textBuffer[length] = '\0';
+    m_textLength = 0;
+
+    if (!contentHandler()->characters(m_textBuffer, length))
+    {
+        finishParsing();
+        return false;
+    }
+    return true;
+}
+
 /**
  * Inform that endDocumentHandler has been called
  */
@@ -413,7 +696,7 @@ XmlNamespace* XmlReader::pushNamespaces(XmlAttributes& attrs)
     if (nsStackCur->ns != NULL)
         ns = nsStackCur->ns;
     else
-        ns = new XmlNamespace();
+        ns = newNamespace(NULL, NULL, NULL);
 
     // Search for any xmlns attributes.
     for (int i = 0; i < attrs.length(); i++)
@@ -423,15 +706,19 @@ XmlNamespace* XmlReader::pushNamespaces(XmlAttributes& attrs)
 
         if (xmlStrcmp(qName, (xmlChar *) "xmlns") == 0)
         {
-            ns = new XmlNamespace(NULL, attrs.value(i), ns);
+            ns = newNamespace(NULL, attrs.value(i), ns);
         }
         else if (xmlStrncmp(qName, (xmlChar *) "xmlns:", 6) == 0)
         {
-            ns = new XmlNamespace(qName + 6, attrs.value(i), ns);
+            ns = newNamespace(qName + 6, attrs.value(i), ns);
         }
     }
 
-    nsStackItem *ptr = (nsStackItem *) malloc(sizeof(struct nsStackItem));
+    nsStackItem *ptr = nsStackFree;
+    if (ptr != NULL)
+        nsStackFree = ptr->prev;
+    else
+        ptr = (nsStackItem *) pArena->alloc(sizeof(struct nsStackItem));
     ptr->prev = nsStackCur;
     ptr->ns = ns;
     nsStackCur = ptr;
@@ -453,7 +740,8 @@ XmlNamespace* XmlReader::popNamespaces()
     if (nsStackCur->prev != NULL)
     {
         nsStackItem *ptr = nsStackCur->prev;
-        free(nsStackCur);
+        nsStackCur->prev = nsStackFree;
+        nsStackFree = nsStackCur;
         nsStackCur = ptr;
         //LOG4CXX_DEBUG(xmlXmlReaderLog, "nsstack now of size " << --stackcount << "@" << ns->m_uri);
     }
@@ -465,6 +753,87 @@ XmlNamespace* XmlReader::popNamespaces()
     return ns;
 }
 
+/**
+ * Drop the reference of a popped stack item
+ *
+ * Namespaces which are no longer referred to go on the free list, they
+ * are in scope of no element left open.
+ *
+ * @param ns namespace returned by popNamespaces, may be NULL
+ */
+void XmlReader::releaseNamespace(XmlNamespace *ns)
+{
+    while (ns != NULL && --ns->m_ref <= 0)
+    {
+        // The index remembers the last namespace it saw by its address
+        if (pElementIndex != NULL)
+            pElementIndex->forget(ns);
+
+        nsBlock *block = (nsBlock *) ns - 1;
+        block->next = nsFree;
+        nsFree = block;
+        ns = ns->m_parent;
+    }
+}
+
+/**
+ * Allocate a namespace from the free list or the arena
+ *
+ * @param p pointer to namespace prefix, NULL for the default namespace
+ * @param u pointer to namespace uri
+ * @param parent pointer to parent namespace
+ * @return pointer to the new namespace
+ */
+XmlNamespace *XmlReader::newNamespace(const xmlChar *p, const xmlChar *u,
+        XmlNamespace *parent)
+{
+    size_t prefixLength = (p != NULL) ? strlen((const char *) p) : 0;
+    size_t uriLength = (u != NULL) ? strlen((const char *) u) : 0;
+    size_t size = prefixLength + uriLength + 2;
+
+    // Take the first released block the strings fit in
+    nsBlock **link = &nsFree;
+    while (*link != NULL && (*link)->size < size)
+        link = &(*link)->next;
+
+    nsBlock *block = *link;
+    if (block != NULL)
+    {
+        *link = block->next;
+    }
+    else
+    {
+        block = (nsBlock *) pArena->alloc(
+                sizeof(nsBlock) + sizeof(XmlNamespace) + size);
+        block->size = size;
+    }
+
+    void *storage = block + 1;
+    xmlChar *prefix = (xmlChar *) ((XmlNamespace *) storage + 1);
+    xmlChar *uri = prefix + prefixLength + 1;
+    memcpy(prefix, p != NULL ? p : (const xmlChar *) "", prefixLength + 1);
+    memcpy(uri, u != NULL ? u : (const xmlChar *) "", uriLength + 1);
+
+    return new (storage) XmlNamespace(parent, prefix, uri);
+}
+
+/**
+ * Empty the namespace stack and release the arena
+ *
+ * Elements left open by a stopped or failed parse are popped here, after
+ * which nothing points into the arena.
+ */
+void XmlReader::resetNamespaces()
+{
+    while (nsStackCur->prev != NULL)
+        releaseNamespace(popNamespaces());
+    nsStackCur->ns = NULL;
+    nsStackFree = NULL;
+    nsFree = NULL;
+
+    pArena->reset();
+}
+
 /**
  * Get namespace on the top of stack
  * @return pointer to the namespace on the top of the stack
@@ -500,9 +869,13 @@ bool XmlReader::setupSAXHandler(xmlSAXHandler &handler)
         handler.startDocument = startDocumentHandler;
         handler.endDocument = endDocumentHandler;
         handler.characters = charactersHandler;
-        handler.endElement = endElementHandler;
         handler.processingInstruction = processingInstructionHandler;
+    }
+    // Building an index needs the start tags, even with no handler to tell
+    if (_contentHandler || !pElementDispatcher->empty() || bBuildElementIndex)
+    {
         handler.startElement = startElementHandler;
+        handler.endElement = endElementHandler;
     }
     if (_lexicalHandler)
     {
@@ -515,10 +888,171 @@ bool XmlReader::setupSAXHandler(xmlSAXHandler &handler)
     }
 
     handler.getEntity = entityHandler;
+    handler.externalSubset = externalSubsetHandler;
+
+    return true;
+}
+
+/**
+ * Get a push parser context for the current doctype
+ *
+ * The context of the previous parse is reset and reused, keeping its
+ * dictionary and buffers. It is recreated when its dictionary has grown
+ * past MAX_CONTEXT_DICT_SIZE names.
+ *
+ * @param handler SAX handler for the new parse
+ * @return pointer to the context
+ */
+xmlParserCtxtPtr XmlReader::setupContext(xmlSAXHandler &handler)
+{
+    bool html = (m_doctype == DOCTYPE_HTML);
+    xmlParserCtxtPtr &ctxt = html ? m_htmlContext : m_xmlContext;
+
+    if (ctxt != NULL && ctxt->dict != NULL
+            && xmlDictSize(ctxt->dict) > MAX_CONTEXT_DICT_SIZE)
+    {
+        LOG4CXX_DEBUG(xmlXmlReaderLog, "Recreating parser context");
+        freeContext(ctxt, html);
+    }
+
+    if (ctxt != NULL)
+    {
+        if (resetContext(ctxt, html, NULL, 0))
+        {
+            // The reset keeps the old callbacks, install the new ones
+            std::memcpy(ctxt->sax, &handler, sizeof(xmlSAXHandler));
+            ctxt->userData = this;
+            m_contextReused = true;
+            return ctxt;
+        }
+
+        LOG4CXX_WARN(xmlXmlReaderLog, "Failed to reset parser context");
+        freeContext(ctxt, html);
+    }
+
+    m_contextReused = false;
+    if (html)
+        ctxt = htmlCreatePushParserCtxt(&handler, this, NULL, 0, NULL,
+                (xmlCharEncoding) 0);
+    else
+        ctxt = xmlCreatePushParserCtxt(&handler, this, NULL, 0, NULL);
+
+    return ctxt;
+}
+
+/**
+ * Reset a kept parser context for a new push parse
+ *
+ * HTML contexts are reset with htmlCtxtReset, which restores the HTML
+ * parser defaults, and get a new push input. Like xmlCtxtResetPush for
+ * XML contexts, the encoding is detected from the given first bytes.
+ *
+ * @param ctxt the context to reset
+ * @param html true if ctxt is an HTML parser context
+ * @param first the first bytes of the document, or NULL
+ * @param length number of bytes in first
+ * @return boolean of the result
+ * @retval false if the context could not be reset
+ */
+bool XmlReader::resetContext(xmlParserCtxtPtr ctxt, bool html,
+        const char *first, int length)
+{
+    if (!html)
+        return xmlCtxtResetPush(ctxt, first, length, NULL, NULL) == 0;
+
+    htmlCtxtReset(ctxt);
+
+    xmlParserInputBufferPtr buffer = xmlAllocParserInputBuffer(
+            XML_CHAR_ENCODING_NONE);
+    if (buffer == NULL)
+        return false;
+    if (first != NULL && length > 0
+            && xmlParserInputBufferPush(buffer, length, first) < 0)
+    {
+        xmlFreeParserInputBuffer(buffer);
+        return false;
+    }
+
+    // The stream takes over the buffer, also when it fails
+    xmlParserInputPtr input = xmlNewIOInputStream(ctxt, buffer,
+            XML_CHAR_ENCODING_NONE);
+    if (input == NULL)
+        return false;
+    if (inputPush(ctxt, input) < 0)
+        return false;
+
+    if (first != NULL && length >= 4)
+    {
+        xmlCharEncoding encoding = xmlDetectCharEncoding(
+                (const xmlChar *) first, length);
+        if (encoding != XML_CHAR_ENCODING_NONE)
+            xmlSwitchEncoding(ctxt, encoding);
+    }
 
     return true;
 }
 
+/**
+ * Free a kept parser context
+ */
+void XmlReader::freeContext(xmlParserCtxtPtr &ctxt, bool html)
+{
+    if (html)
+        htmlFreeParserCtxt(ctxt);
+    else
+        xmlFreeParserCtxt(ctxt);
+    ctxt = NULL;
+}
+
+/**
+ * Set handler for an element
+ *
+ * The handler is called for start and end tags of the element, before the
+ * content handler, and elements without a handler are not dispatched.
+ * Names are resolved once per parser context, after which finding the
+ * handler for an element does not compare strings. Handlers should be set
+ * between parses.
+ *
+ * @param namespaceURI namespace of the element, "" for no namespace and
+ * NULL for any namespace
+ * @param localName local name of the element
+ * @param handler pointer to a handler, NULL removes the handler
+ */
+void XmlReader::setElementHandler(const xmlChar *namespaceURI,
+        const xmlChar *localName, XmlElementHandler *handler)
+{
+    if (localName == NULL)
+        return;
+
+    if (handler != NULL)
+        pElementDispatcher->add(namespaceURI, localName, handler);
+    else
+        pElementDispatcher->remove(namespaceURI, localName);
+}
+
+/**
+ * Remove all element handlers
+ */
+void XmlReader::clearElementHandlers()
+{
+    pElementDispatcher->clear();
+}
+
+/**
+ * Get handler for an element
+ *
+ * @param qName name of the element as reported by the parser
+ * @param localName local part of qName
+ * @param namespaceURI namespace of the element
+ * @return pointer to handler
+ * @retval NULL if no handler is set for the element
+ */
+XmlElementHandler *XmlReader::elementHandler(const xmlChar *qName,
+        const xmlChar *localName, const xmlChar *namespaceURI)
+{
+    return pElementDispatcher->find(qName, localName, namespaceURI);
+}
+
 /**
  * Parse a XML resource
  *
@@ -543,12 +1077,20 @@ bool XmlReader::parseXml(const char* uri)
         return false;
     }
 
-    m_context = xmlCreatePushParserCtxt(&handler, this, NULL, 0, NULL);
+    m_context = setupContext(handler);
 
-    DataSource ds(uri);
+    if (bBuildElementIndex)
+        pElementIndex = new XmlElementIndex();
 
-    LOG4CXX_DEBUG(xmlXmlReaderLog, "Parsing '" << uri << "'");
-    ret = parse(ds);
+    {
+        DataSource ds(uri);
+
+        LOG4CXX_DEBUG(xmlXmlReaderLog, "Parsing '" << uri << "'");
+        ret = parse(ds);
+    }
+
+    // The stream has been closed, a downloaded document is in the cache
+    storeElementIndex(uri, ret);
 
     if (ret == false)
     {
@@ -567,69 +1109,164 @@ bool XmlReader::parseXml(const char* uri)
 
     if (handler.endDocument != NULL && m_endDocumentHandlerCalled == false)
     {
+        flushCharacters();
         contentHandler()->endDocument();
     }
 
-    xmlFreeParserCtxt(m_context);
     m_context = NULL;
 
     return ret;
 }
 
 /**
- * Parse a HTML resource
+ * Parse the element with a given id in a XML resource
  *
- * @param uri location of the HTML resource
+ * Only the element and its content are reported, as if they were the
+ * whole document. If the document has been indexed, see
+ * buildElementIndex(), parsing starts at the element and stops after it.
+ * Otherwise the document is parsed from the top, and indexed on the way
+ * when indexing is on.
+ *
+ * @param uri location of the XML resource
+ * @param id value of the id or xml:id attribute of the element
  * @return boolean of the result
- * @retval false if parsing failed
+ * @retval false if parsing failed or there is no such element
  * @retval true if parsing succeeded
  */
-bool XmlReader::parseHtml(const char *uri)
+bool XmlReader::parseFragment(const char *uri, const char *id)
 {
-    m_doctype = DOCTYPE_HTML;
+    m_doctype = DOCTYPE_XML;
     bool ret = false;
-    DataSource *ds = NULL;
 
-    ds = new DataSource(uri);
+    xmlSAXHandler handler;
+    ret = setupSAXHandler(handler);
 
-    const XmlError *e = NULL;
+    if (!ret)
+    {
+        setLastError(
+                new XmlError(XML_FROM_PARSER, -1,
+                        "Failed to initialize SAX callbacks"));
+        return false;
+    }
 
-    // Setup a null handler
-    xmlSAXHandler nullhandler;
-    std::memset(&nullhandler, 0, sizeof(nullhandler));
+    m_fragmentId = id;
+    m_fragmentFound = false;
 
-    // First check if the HTML document is valid
-    m_context = htmlCreatePushParserCtxt(&nullhandler, this, NULL, 0, NULL,
-            (xmlCharEncoding) 0);
+    unsigned long offset = 0;
+    int depth = 0;
+    std::string namespaces;
+    if (DataStreamHandler::Instance()->findIndexedElement(uri, m_fragmentId,
+            offset, depth, namespaces))
+    {
+        LOG4CXX_DEBUG(xmlXmlReaderLog,
+                "Parsing '" << uri << "#" << id << "' from offset " << offset << " at depth " << depth);
 
-    LOG4CXX_DEBUG(xmlXmlReaderLog, "Preparsing '" << uri << "'");
-    ret = parse(*ds);
+        // The wrapper declares the namespaces in scope at the element
+        std::string prologue = "<" FRAGMENT_WRAPPER + namespaces + ">";
 
-    if (ret == false)
+        m_fragmentMode = FRAGMENT_SEEK;
+        m_context = setupContext(handler);
+        {
+            DataSource ds(uri);
+            ret = parse(ds, offset, prologue.c_str());
+        }
+
+        if (!m_fragmentFound)
+        {
+            // The document changed since it was indexed
+            DataStreamHandler::Instance()->setElementIndex(uri, NULL);
+            setLastError(NULL);
+        }
+    }
+
+    if (!m_fragmentFound)
     {
-        e = getLastError();
+        LOG4CXX_DEBUG(xmlXmlReaderLog,
+                "Searching '" << uri << "' for '" << id << "'");
+
+        m_fragmentMode = FRAGMENT_SEARCH;
+        m_context = setupContext(handler);
+
+        if (bBuildElementIndex)
+            pElementIndex = new XmlElementIndex();
 
-        if (e)
         {
-            LOG4CXX_WARN(xmlXmlReaderLog,
-                    "Document '" << uri << "' contains errors: " << e->getMessage());
+            DataSource ds(uri);
+            ret = parse(ds);
         }
-        else
+
+        storeElementIndex(uri, ret);
+
+        if (ret && !m_fragmentFound)
         {
-            LOG4CXX_WARN(xmlXmlReaderLog,
-                    "Document '" << uri << "' contains errors: unknown");
+            ret = false;
+            setLastError(
+                    new XmlError(XML_FROM_PARSER, -1,
+                            "No element with id '" + m_fragmentId + "' in "
+                                    + uri));
         }
+    }
 
-        delete ds;
-        ds = new DataSource(uri, true);
+    if (ret == false)
+    {
+        const XmlError *e = getLastError();
+        LOG4CXX_ERROR(xmlXmlReaderLog,
+                "Fragment '" << uri << "#" << id << "' contains errors: " << (e ? e->getMessage() : "unknown"));
+    }
 
-        // Recreate parser
-        htmlFreeParserCtxt(m_context);
-        m_context = htmlCreatePushParserCtxt(&nullhandler, this, NULL, 0, NULL,
-                (xmlCharEncoding) 0);
+    if (handler.endDocument != NULL && m_endDocumentHandlerCalled == false)
+    {
+        flushCharacters();
+        contentHandler()->endDocument();
+    }
+
+    m_fragmentMode = FRAGMENT_OFF;
+    m_fragmentId.clear();
+    m_context = NULL;
+
+    return ret;
+}
 
-        // Try parsing again
-        LOG4CXX_DEBUG(xmlXmlReaderLog, "Preparsing tidied '" << uri << "'");
+/**
+ * Parse a HTML resource
+ *
+ * @param uri location of the HTML resource
+ * @return boolean of the result
+ * @retval false if parsing failed
+ * @retval true if parsing succeeded
+ */
+bool XmlReader::parseHtml(const char *uri)
+{
+    m_doctype = DOCTYPE_HTML;
+    bool ret = false;
+    bool tidy = false;
+    DataSource *ds = NULL;
+
+    const XmlError *e = NULL;
+
+    // A document that was preparsed before and has not changed since does
+    // not need to be checked again
+    DataStreamHandler *handlerInstance = DataStreamHandler::Instance();
+    HtmlVerdict verdict = handlerInstance->getHtmlVerdict(uri);
+
+    if (verdict != HTML_UNKNOWN)
+    {
+        tidy = (verdict == HTML_NEEDS_TIDY);
+        LOG4CXX_DEBUG(xmlXmlReaderLog,
+                "Skipping preparse of '" << uri << "', tidy " << tidy);
+    }
+    else
+    {
+        ds = new DataSource(uri);
+
+        // Setup a null handler
+        xmlSAXHandler nullhandler;
+        std::memset(&nullhandler, 0, sizeof(nullhandler));
+
+        // First check if the HTML document is valid
+        m_context = setupContext(nullhandler);
+
+        LOG4CXX_DEBUG(xmlXmlReaderLog, "Preparsing '" << uri << "'");
         ret = parse(*ds);
 
         if (ret == false)
@@ -638,23 +1275,52 @@ bool XmlReader::parseHtml(const char *uri)
 
             if (e)
             {
-                LOG4CXX_ERROR(xmlXmlReaderLog,
-                        "Error parsing '" << uri <<"': " << e->getMessage());
+                LOG4CXX_WARN(xmlXmlReaderLog,
+                        "Document '" << uri << "' contains errors: " << e->getMessage());
             }
             else
             {
-                LOG4CXX_ERROR(xmlXmlReaderLog,
-                        "Error parsing '" << uri << "': unknown");
+                LOG4CXX_WARN(xmlXmlReaderLog,
+                        "Document '" << uri << "' contains errors: unknown");
             }
 
-            htmlFreeParserCtxt(m_context);
-            m_context = NULL;
             delete ds;
-            return ret;
+            tidy = true;
+            ds = new DataSource(uri, tidy);
+
+            // Reset parser
+            m_context = setupContext(nullhandler);
+
+            // Try parsing again
+            LOG4CXX_DEBUG(xmlXmlReaderLog, "Preparsing tidied '" << uri << "'");
+            ret = parse(*ds);
+
+            if (ret == false)
+            {
+                e = getLastError();
+
+                if (e)
+                {
+                    LOG4CXX_ERROR(xmlXmlReaderLog,
+                            "Error parsing '" << uri <<"': " << e->getMessage());
+                }
+                else
+                {
+                    LOG4CXX_ERROR(xmlXmlReaderLog,
+                            "Error parsing '" << uri << "': unknown");
+                }
+
+                m_context = NULL;
+                delete ds;
+                return ret;
+            }
         }
-    }
 
-    delete ds;
+        // The raw resource is in the cache now, remember the verdict with it
+        delete ds;
+        handlerInstance->setHtmlVerdict(uri,
+                tidy ? HTML_NEEDS_TIDY : HTML_WELL_FORMED);
+    }
 
     // If we have a valid document, setup sax handler to recieve events
     xmlSAXHandler handler;
@@ -668,13 +1334,11 @@ bool XmlReader::parseHtml(const char *uri)
         return false;
     }
 
-    // reCreate the datasource
-    ds = new DataSource(uri);
+    // reCreate the datasource, tidied if the preparse needed it
+    ds = new DataSource(uri, tidy);
 
-    // Create a new context
-    htmlFreeParserCtxt(m_context);
-    m_context = htmlCreatePushParserCtxt(&handler, this, NULL, 0, NULL,
-            (xmlCharEncoding) 0);
+    // Reset the context for the real parse
+    m_context = setupContext(handler);
 
     LOG4CXX_DEBUG(xmlXmlReaderLog, "Parsing '" << uri << "'");
     ret = parse(*ds);
@@ -693,15 +1357,18 @@ bool XmlReader::parseHtml(const char *uri)
             LOG4CXX_ERROR(xmlXmlReaderLog,
                     "Document '" << uri << "' contains errors: unknown");
         }
+
+        // Do not trust the verdict the next time
+        handlerInstance->setHtmlVerdict(uri, HTML_UNKNOWN);
     }
 
     if (handler.endDocument != NULL && m_endDocumentHandlerCalled == false)
     {
+        flushCharacters();
         contentHandler()->endDocument();
     }
 
     delete ds;
-    htmlFreeParserCtxt(m_context);
     m_context = NULL;
 
     return ret;
@@ -729,16 +1396,230 @@ int XmlReader::parseChunk(xmlParserCtxtPtr ctxt, const char *chunk, int size,
     return -1;
 }
 
+/**
+ * Prepare the reader state for a new document
+ */
+void XmlReader::startParse()
+{
+    m_parserStopped = false;
+    m_parsingFinished = false;
+    m_sawError = false;
+    m_endDocumentHandlerCalled = false;
+    m_skipDepth = 0;
+    m_sniffEncoding = true;
+    m_firstBytesLength = 0;
+    m_bytesParsed = 0;
+    m_inputStart = 0;
+    m_utf8Input = UTF8_INPUT_NO;
+    m_depth = 0;
+    m_fragmentDepth = 0;
+    m_fragmentFound = false;
+    m_dtd = NULL;
+
+    // Keep the text buffer unless an unusually long text grew it
+    m_textLength = 0;
+    if (m_textCapacity > MAX_TEXT_BUFFER_SIZE)
+    {
+        free(m_textBuffer);
+        m_textBuffer = NULL;
+        m_textCapacity = 0;
+    }
+
+    // Start with an empty arena, the previous document is done with it
+    resetNamespaces();
+
+    if (m_context != NULL)
+        pElementDispatcher->attach(m_context->dict, m_contextReused);
+}
+
+/**
+ * Pass the first bytes of the document to the parser
+ *
+ * libxml2 detects the encoding from them, an optional UTF-8 byte order
+ * mark is skipped.
+ *
+ * @return boolean of the result
+ * @retval false if a parse error occurred, see getLastError()
+ * @retval true if parsing may continue, or a handler finished it
+ */
+bool XmlReader::parseFirstBytes()
+{
+    m_sniffEncoding = false;
+
+    // Only XML documents are indexed by byte offset
+    if (m_doctype == DOCTYPE_XML)
+        m_utf8Input = UTF8_INPUT_PENDING;
+    else
+        m_utf8Input = UTF8_INPUT_NO;
+
+    // Other marks tell libxml2 the encoding
+    size_t bomLength = 0;
+    if (m_firstBytesLength >= 3
+            && std::memcmp(m_firstBytes, "\xEF\xBB\xBF", 3) == 0) // UTF-8 bom is optional
+    {
+        LOG4CXX_WARN(xmlXmlReaderLog, "Removing optional UTF-8 BOM: ef bb bf ");
+        bomLength = 3;
+        m_bytesParsed += bomLength;
+        m_inputStart = bomLength;
+    }
+
+    const char *first = m_firstBytes + bomLength;
+    int length = m_firstBytesLength - (int) bomLength;
+    if (length == 0)
+        return true;
+
+    // A reset context only detects the encoding of bytes handed to the
+    // reset itself
+    if (m_contextReused)
+    {
+        m_contextReused = false;
+        if (!resetContext(m_context, m_doctype == DOCTYPE_HTML, first,
+                length))
+        {
+            stopParsing();
+            m_sawError = true;
+            setLastError(
+                    new XmlError(XML_FROM_PARSER, -1,
+                            "Failed to reset parser context"));
+            return false;
+        }
+        m_context->userData = this;
+        m_bytesParsed += length;
+        return pushChunk(NULL, 0, 0);
+    }
+
+    return pushChunk(first, length, 0);
+}
+
+/**
+ * Find out whether libxml2 reads the document as UTF-8
+ *
+ * libxml2 reads the document as UTF-8 unless it switched to a converter
+ * for the declared or detected encoding, which it has done once it has
+ * moved past the start of the document.
+ */
+void XmlReader::checkEncoding()
+{
+    if (m_context->instate == XML_PARSER_START)
+        return;
+
+    if (m_context->input != NULL && m_context->input->buf != NULL
+            && m_context->input->buf->encoder == NULL)
+    {
+        m_utf8Input = UTF8_INPUT_YES;
+    }
+    else
+    {
+        m_utf8Input = UTF8_INPUT_NO;
+    }
+}
+
+/**
+ * Pass bytes of the current document to the parser
+ *
+ * The first four bytes are held back until the encoding can be detected
+ * from them, the push parser does not handle a byte order mark split over
+ * several chunks.
+ *
+ * @param buffer pointer to the bytes
+ * @param size number of bytes
+ * @param terminate nonzero if these are the last bytes of the document
+ * @return boolean of the result
+ * @retval false if a parse error occurred, see getLastError()
+ * @retval true if parsing may continue, or a handler finished it
+ */
+bool XmlReader::parseBytes(const char *buffer, int size, int terminate)
+{
+    if (m_sniffEncoding)
+    {
+        while (m_firstBytesLength < 4 && size > 0)
+        {
+            m_firstBytes[m_firstBytesLength++] = *buffer++;
+            size--;
+        }
+
+        if (m_firstBytesLength < 4 && !terminate)
+            return true;
+
+        if (!parseFirstBytes())
+            return false;
+        if (m_parsingFinished)
+            return true;
+    }
+
+    if (size == 0 && !terminate)
+        return true;
+
+    return pushChunk(buffer, size, terminate);
+}
+
+/**
+ * Hand bytes to the parser and check the result
+ *
+ * @param buffer pointer to the bytes
+ * @param size number of bytes
+ * @param terminate nonzero if these are the last bytes of the document
+ * @return boolean of the result
+ * @retval false if a parse error occurred, see getLastError()
+ * @retval true if parsing may continue, or a handler finished it
+ */
+bool XmlReader::pushChunk(const char *buffer, int size, int terminate)
+{
+    int ret = parseChunk(m_context, buffer, size, terminate);
+
+    m_bytesParsed += size;
+
+    // A handler asked to stop, this is not an error
+    if (m_parsingFinished)
+        return true;
+
+    if (ret)
+    {
+        xmlError *error = xmlCtxtGetLastError(m_context);
+        stopParsing();
+        m_sawError = true;
+        if (error != NULL)
+        {
+            LOG4CXX_ERROR(xmlXmlReaderLog, "Parse error " << error->message);
+            setLastError(
+                    new XmlError(error->domain, error->code,
+                            std::string(error->message),
+                            m_context->input->col, m_context->input->line));
+        }
+        else
+        {
+            LOG4CXX_ERROR(xmlXmlReaderLog,
+                    "Parse error # " << ret << " with no error message");
+            LOG4CXX_INFO(xmlXmlReaderLog,
+                    "For a complete list of errors please visit: http://xmlsoft.org/html/libxml-xmlerror.html#xmlParserErrors");
+            std::ostringstream oss;
+            oss << "Error id: " << ret;
+            setLastError(
+                    new XmlError(XML_FROM_PARSER, ret, oss.str(),
+                            m_context->input->col, m_context->input->line));
+        }
+        return false;
+    }
+
+    if (m_utf8Input == UTF8_INPUT_PENDING)
+        checkEncoding();
+
+    return true;
+}
+
 /**
  * Parse a resource
  *
  * @param input pointer to a input source
+ * @param offset number of bytes to skip at the start of the resource
+ * @param prologue bytes passed to the parser before the resource, or NULL
  *
  * @return boolean of the result
  * @retval false if parsing failed
  * @retval true if parsing succeeded
  */
-bool XmlReader::parse(const XmlInputSource &input)
+bool XmlReader::parse(const XmlInputSource &input, unsigned long offset,
+        const char *prologue)
 {
     const size_t bufsize = 4096;
 
@@ -757,17 +1638,27 @@ bool XmlReader::parse(const XmlInputSource &input)
         return false;
     }
 
-    m_parserStopped = false;
-    m_sawError = false;
-    m_endDocumentHandlerCalled = false;
+    startParse();
 
     is->useCache(bUseCache);
 
+    if (offset > 0 && !is->skipBytes(offset))
+    {
+        m_sawError = true;
+        setLastError(
+                new XmlError(XML_FROM_IO, (int) is->getErrorCode(),
+                        is->getErrorMsg()));
+        LOG4CXX_ERROR(xmlXmlReaderLog,
+                "Failed to skip " << offset << " bytes: " << is->getErrorMsg());
+        return false;
+    }
+
+    if (prologue != NULL && !parseBytes(prologue, strlen(prologue), 0))
+        return false;
+
     LOG4CXX_TRACE(xmlXmlReaderLog, "Starting parse");
 
-    int ret = 0;
     int bytes_read;
-    bool parseByteOrderMark = true;
     do
     {
         LOG4CXX_TRACE(xmlXmlReaderLog,
@@ -794,66 +1685,151 @@ bool XmlReader::parse(const XmlInputSource &input)
         if (bytes_read)
             LOG4CXX_TRACE(xmlXmlReaderLog, "Read " << bytes_read << " bytes");
 
-        if (parseByteOrderMark && bytes_read >= 3)
-        {
-            parseByteOrderMark = false;
-
-            char efbbbf[] =
-            { 0xEF, 0xBB, 0xBF }; // UTF-8 bom is optional
-
-            if (std::equal(&buffer[0], (&buffer[0]) + 3, efbbbf))
-            {
-                LOG4CXX_WARN(xmlXmlReaderLog,
-                        "Removing optional UTF-8 BOM: ef bb bf ");
-                std::copy(buffer + 3, buffer + bytes_read, buffer);
-                bytes_read -= 3;
-            }
-        }
-
         if (bytes_read > 0)
         {
-            ret = parseChunk(m_context, buffer, bytes_read, 0);
+            if (!parseBytes(buffer, bytes_read, 0))
+                return false;
 
-            if (ret)
+            if (m_parsingFinished)
             {
-                xmlError *error = xmlCtxtGetLastError(m_context);
-                xmlStopParser(m_context);
-                m_sawError = true;
-                if (error != NULL)
-                {
-                    LOG4CXX_ERROR(xmlXmlReaderLog,
-                            "Parse error " << error->message);
-                    setLastError(
-                            new XmlError(error->domain, error->code,
-                            		std::string(error->message),
-                                    m_context->input->col,
-                                    m_context->input->line));
-                }
-                else
-                {
-                    LOG4CXX_ERROR(xmlXmlReaderLog,
-                            "Parse error # " << ret << " with no error message");
-                    LOG4CXX_INFO(xmlXmlReaderLog,
-                            "For a complete list of errors please visit: http://xmlsoft.org/html/libxml-xmlerror.html#xmlParserErrors");
-                    std::ostringstream oss;
-                    oss << "Error id: " << ret;
-                    setLastError(
-                            new XmlError(XML_FROM_PARSER, ret, oss.str(),
-                                    m_context->input->col,
-                                    m_context->input->line));
-                }
-                return false;
+                LOG4CXX_DEBUG(xmlXmlReaderLog,
+                        "Parsing finished by handler after " << is->curPos() << " bytes");
+                break;
             }
         }
 
     } while (bytes_read > 0);
 
+    // A document shorter than the held back bytes is still held back
+    if (m_sniffEncoding && !parseFirstBytes())
+        return false;
+
     if (m_sawError)
         LOG4CXX_ERROR(xmlXmlReaderLog, "Should not reach here");
 
     return (!m_sawError);
 }
 
+/**
+ * Start parsing a XML document which is passed in with feed()
+ *
+ * The caller owns the transport and pushes bytes as they arrive, parsing
+ * never blocks on I/O. The document is complete when finish() is called.
+ * Another document can not be parsed with this reader in between.
+ *
+ * @param handler content handler to receive the events, NULL to keep the
+ * current one
+ * @return boolean of the result
+ * @retval false if the parser could not be set up
+ * @retval true if the reader is ready for feed()
+ */
+bool XmlReader::begin(XmlContentHandler *handler)
+{
+    if (handler != NULL)
+        setContentHandler(handler);
+
+    m_doctype = DOCTYPE_XML;
+    m_feeding = false;
+
+    xmlSAXHandler saxHandler;
+    if (!setupSAXHandler(saxHandler))
+    {
+        setLastError(
+                new XmlError(XML_FROM_PARSER, -1,
+                        "Failed to initialize SAX callbacks"));
+        return false;
+    }
+
+    m_context = setupContext(saxHandler);
+    if (m_context == NULL)
+    {
+        setLastError(
+                new XmlError(XML_FROM_PARSER, -1,
+                        "Failed to create parser context"));
+        return false;
+    }
+
+    startParse();
+    m_feeding = true;
+
+    LOG4CXX_DEBUG(xmlXmlReaderLog, "Started incremental parse");
+    return true;
+}
+
+/**
+ * Parse the next bytes of a document started with begin()
+ *
+ * The bytes may end anywhere, also in the middle of a tag or a UTF-8
+ * sequence. Bytes fed after a handler finished the parse are ignored.
+ *
+ * @param data pointer to the bytes
+ * @param size number of bytes
+ * @return boolean of the result
+ * @retval false if begin() was not called or the document has errors
+ * @retval true if parsing may continue
+ */
+bool XmlReader::feed(const char *data, size_t size)
+{
+    if (!m_feeding)
+    {
+        setLastError(
+                new XmlError(XML_FROM_PARSER, -1,
+                        "feed() called without begin()"));
+        return false;
+    }
+
+    if (m_parserStopped)
+        return !m_sawError;
+
+    while (size > 0)
+    {
+        int chunk = size > MAX_FEED_CHUNK ? MAX_FEED_CHUNK : (int) size;
+        if (!parseBytes(data, chunk, 0))
+            return false;
+        if (m_parsingFinished)
+            break;
+        data += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+/**
+ * End a document started with begin()
+ *
+ * The parser is told that no more bytes will come, which reports a
+ * truncated document as an error, and endDocument is delivered.
+ *
+ * @return boolean of the result
+ * @retval false if parsing failed
+ * @retval true if parsing succeeded
+ */
+bool XmlReader::finish()
+{
+    if (!m_feeding)
+    {
+        setLastError(
+                new XmlError(XML_FROM_PARSER, -1,
+                        "finish() called without begin()"));
+        return false;
+    }
+
+    if (!m_parserStopped)
+        parseBytes(NULL, 0, 1);
+
+    if (_contentHandler != NULL && m_endDocumentHandlerCalled == false)
+    {
+        flushCharacters();
+        contentHandler()->endDocument();
+    }
+
+    m_feeding = false;
+    m_context = NULL;
+
+    return !m_sawError;
+}
+
 /**
  * Check if parsing is in progress
  *
@@ -877,6 +1853,227 @@ void XmlReader::stopParsing()
     m_parserStopped = true;
 }
 
+/**
+ * Stop parsing successfully
+ *
+ * Called by a handler that has seen what it needs. No further events are
+ * delivered except endDocument, no more data is read, and the parse
+ * returns true. Returning false from a content handler callback has the
+ * same effect.
+ */
+void XmlReader::finishParsing()
+{
+    if (m_context != NULL)
+        xmlStopParser(m_context);
+
+    m_parserStopped = true;
+    m_parsingFinished = true;
+}
+
+/**
+ * Account for a start tag
+ *
+ * Records the element in the index being built and decides whether its
+ * events are delivered when parsing a fragment.
+ *
+ * @param attributes attributes of the element
+ * @return boolean
+ * @retval true if the element should be delivered
+ * @retval false if it is outside the requested fragment
+ */
+bool XmlReader::enterElement(const XmlAttributes &attributes)
+{
+    m_depth++;
+
+    if (pElementIndex == NULL && m_fragmentMode == FRAGMENT_OFF)
+        return true;
+
+    const xmlChar *id = attributes.value((const xmlChar *) "id");
+    if (id == NULL)
+        id = attributes.value((const xmlChar *) "xml:id");
+
+    if (pElementIndex != NULL && id != NULL)
+    {
+        long offset = elementOffset();
+        if (offset >= 0)
+            pElementIndex->add(id, offset, m_depth, xmlNamespace());
+    }
+
+    if (inFragment())
+        return true;
+
+    // After the fragment the document is only parsed to complete the index
+    if (m_fragmentFound)
+        return false;
+
+    if (id != NULL && m_fragmentId == (const char *) id)
+    {
+        m_fragmentDepth = m_depth;
+        m_fragmentFound = true;
+
+        // The start of the document was held back while seeking
+        if (m_fragmentMode == FRAGMENT_SEEK && _contentHandler != NULL)
+            _contentHandler->startDocument();
+        return true;
+    }
+
+    // When seeking, the element after the wrapper has to be the fragment
+    if (m_fragmentMode == FRAGMENT_SEEK && m_depth > 1)
+    {
+        LOG4CXX_WARN(xmlXmlReaderLog,
+                "Element index does not match the document, no '" << m_fragmentId << "' at offset");
+        finishParsing();
+    }
+    return false;
+}
+
+/**
+ * Check whether the document events of the current parse are delivered
+ *
+ * A parse that seeks to an indexed fragment holds them back until the
+ * fragment is found. If it is not, the document is searched from the top
+ * and that parse delivers them.
+ *
+ * @return boolean
+ */
+bool XmlReader::documentEvents() const
+{
+    return m_fragmentMode != FRAGMENT_SEEK || m_fragmentFound;
+}
+
+/**
+ * Account for an end tag
+ *
+ * Parsing of a fragment finishes with the end of its element.
+ */
+void XmlReader::leaveElement()
+{
+    if (m_fragmentDepth > 0 && m_depth == m_fragmentDepth)
+    {
+        m_fragmentDepth = 0;
+        if (pElementIndex == NULL)
+            finishParsing();
+    }
+    m_depth--;
+}
+
+/**
+ * Check if events are inside the requested fragment
+ *
+ * @return boolean
+ * @retval true if inside the fragment, or not parsing a fragment
+ * @retval false if outside the fragment
+ */
+bool XmlReader::inFragment() const
+{
+    return m_fragmentMode == FRAGMENT_OFF || m_fragmentDepth > 0;
+}
+
+/**
+ * Get the byte offset of the start tag being reported
+ *
+ * The parser has read the tag up to its closing bracket, the tag starts
+ * at the last '<' before it since attribute values can not contain one.
+ * The offset counts bytes as given to the parser, so it is only an offset
+ * into the document for UTF-8 input.
+ *
+ * @return offset of the '<' in the document
+ * @retval -1 if the start tag is not in the parser's buffer
+ */
+long XmlReader::elementOffset() const
+{
+    if (m_context == NULL || m_context->inputNr != 1)
+        return -1;
+
+    xmlParserInputPtr input = m_context->input;
+    if (input == NULL || input->base == NULL || input->cur == NULL)
+        return -1;
+
+    const xmlChar *cur = input->cur;
+    while (cur > input->base && *cur != '<')
+        cur--;
+    if (*cur != '<')
+        return -1;
+
+    return m_inputStart + input->consumed + (cur - input->base);
+}
+
+/**
+ * Hand the index built while parsing a document to the cache
+ *
+ * @param uri location of the document
+ * @param complete true if the document was parsed to the end
+ */
+void XmlReader::storeElementIndex(const char *uri, bool complete)
+{
+    if (pElementIndex == NULL)
+        return;
+
+    // Offsets are only known to be byte offsets for UTF-8 input
+    if (complete && !m_parsingFinished && m_utf8Input == UTF8_INPUT_YES)
+        DataStreamHandler::Instance()->setElementIndex(uri, pElementIndex);
+    else
+        delete pElementIndex;
+    pElementIndex = NULL;
+}
+
+/**
+ * Skip the rest of the current element
+ *
+ * Called from startElement, the element's children are not reported and
+ * their namespaces are not tracked. The endElement of the element itself
+ * is still delivered. Called from another callback, the rest of the
+ * innermost open element is skipped in the same way.
+ */
+void XmlReader::skipSubtree()
+{
+    if (m_skipDepth == 0)
+        m_skipDepth = 1;
+}
+
+/**
+ * Check if events are being skipped
+ *
+ * @return boolean
+ * @retval true if inside a skipped element, or outside the requested
+ * fragment
+ * @retval false if events are delivered
+ */
+bool XmlReader::skippingSubtree() const
+{
+    return m_skipDepth > 0 || !inFragment();
+}
+
+/**
+ * Account for a start tag inside a skipped element
+ *
+ * @return boolean
+ * @retval true if the start tag is skipped
+ * @retval false if it should be delivered
+ */
+bool XmlReader::skipStartElement()
+{
+    if (m_skipDepth == 0)
+        return false;
+    m_skipDepth++;
+    return true;
+}
+
+/**
+ * Account for an end tag inside a skipped element
+ *
+ * @return boolean
+ * @retval true if the end tag is skipped
+ * @retval false if it should be delivered, which includes the end tag of
+ * the element that started the skip
+ */
+bool XmlReader::skipEndElement()
+{
+    if (m_skipDepth == 0)
+        return false;
+    return --m_skipDepth > 0;
+}
+
 /**
  * Check if error has occurred
  *
@@ -897,6 +2094,35 @@ void XmlReader::recordError()
     m_sawError = true;
 }
 
+/**
+ * Use the DTD named by the DOCTYPE of the document
+ *
+ * The DTD is looked up in the process wide cache of DataStreamHandler, it
+ * is only used if a local copy is known.
+ *
+ * @param publicId the public identifier of the DOCTYPE, may be NULL
+ * @param systemId the system identifier of the DOCTYPE, may be NULL
+ */
+void XmlReader::useDtd(const xmlChar *publicId, const xmlChar *systemId)
+{
+    m_dtd = DataStreamHandler::Instance()->getDtd((const char *) publicId,
+            (const char *) systemId);
+}
+
+/**
+ * Get an entity declared in the DTD of the document
+ *
+ * @param name the name of the entity
+ * @return pointer to the entity
+ * @retval NULL if there is no DTD or it does not declare the entity as text
+ */
+xmlEntityPtr XmlReader::dtdEntity(const xmlChar *name) const
+{
+    if (m_dtd == NULL)
+        return NULL;
+    return m_dtd->getEntity(name);
+}
+
 /**
  * Get current line number
  *
@@ -945,9 +2171,11 @@ void XmlReader::release(const xmlChar *xmlstr)
 }
 
 /**
- * Return copy of the input string
+ * Return copy of the first bytes of the input string
  *
- * Historically this was used to convert UTF-8 to ISO-8859-1
+ * The bytes are copied as they are, independent of the locale. Handlers that
+ * only need to look at a string should wrap it in an XmlStringView instead,
+ * which does not allocate.
  *
  * @param chars pointer to XML string
  * @param size number of bytes to include in new string
@@ -958,18 +2186,7 @@ const char *XmlReader::transcode(const xmlChar *chars, size_t size)
 {
     if (chars == NULL)
         return NULL;
-    wchar_t wchars[size + 1];
-    char buff[size * 2];
-    // Cut the string using wchar array
-    int wcslen = mbstowcs(wchars, (char*) chars, size);
-    // Insert null at end
-    wchars[wcslen] = '\0';
-    // Transform it back to a char array
-    int mbslen = wcstombs(buff, wchars, size * 2);
-    buff[mbslen] = '\0';
-
-    // Return a duplicate of resulting buffer
-    return strdup((char*) buff);
+    return strndup((const char *) chars, size);
 }
 
 /**
@@ -61,6 +61,12 @@
 #include <stack>
 #include <string>
 
+class XmlArena;
+struct nsBlock;
+class XmlElementDispatcher;
+class XmlElementIndex;
+class CachedDtd;
+
 /**
  * Struct for storing a namespace
  */
@@ -102,6 +108,8 @@ struct XmlNamespace
             m_parent->ref();
     }
 
+    XmlNamespace(XmlNamespace* parent, xmlChar * p, xmlChar * u);
+
     /**
      * Get uri for prefix
      *
@@ -132,6 +140,7 @@ struct XmlNamespace
      * Mark that this namespace is not referred to
      *
      * The namespace is removed along with other namespaces which are no longer referred to.
+     * Namespaces of a reader are released through XmlReader::releaseNamespace.
      */
     void deref()
     {
@@ -162,6 +171,13 @@ class XmlError;
  * \class XmlContentHandler
  *
  * \brief Interface for XML content handler
+ *
+ * Returning false from startElement, endElement, characters or
+ * processingInstruction ends the parse successfully: no further events
+ * are delivered except endDocument, no more data is read, and the parse
+ * call returns true, as after XmlReader::finishParsing(). CDATA sections
+ * are reported through characters and end the parse the same way. A
+ * handler that must fail the parse calls XmlReader::stopParsing().
  */
 class KOLIBRE_API XmlContentHandler
 {
@@ -189,6 +205,29 @@ public:
     virtual std::string errorString() = 0;
 };
 
+/**
+ * \class XmlElementHandler
+ *
+ * \brief Interface for a handler of one kind of element
+ *
+ * Registered with XmlReader::setElementHandler() and only called for the
+ * elements it was registered for, before the content handler. Returning
+ * false stops parsing like in XmlContentHandler.
+ */
+class KOLIBRE_API XmlElementHandler
+{
+public:
+    virtual ~XmlElementHandler()
+    {
+    }
+    ;
+    virtual bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName,
+            const XmlAttributes &attributes) = 0;
+    virtual bool endElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName) = 0;
+};
+
 /**
  * \class XmlLexicalHandler
  *
@@ -362,10 +401,23 @@ public:
         return _lexicalHandler;
     }
 
+    // Handlers for selected elements
+    void setElementHandler(const xmlChar *namespaceURI,
+            const xmlChar *localName, XmlElementHandler *handler);
+    void clearElementHandlers();
+
     bool parseXml(const char *);
     bool parseHtml(const char *);
+    bool parseFragment(const char *, const char *);
+
+    // Incremental parsing of bytes pushed by the caller
+    bool begin(XmlContentHandler *handler = NULL);
+    bool feed(const char *, size_t);
+    bool finish();
 
     void useCache(bool setting);
+    void coalesceCharacters(bool setting);
+    void buildElementIndex(bool setting);
 
     void endDocumentHandlerCalled();
 
@@ -375,6 +427,9 @@ public:
 
     bool parserStopped() const;
     void stopParsing();
+    void finishParsing();
+
+    void skipSubtree();
 
     bool sawError() const;
     void recordError();
@@ -394,33 +449,127 @@ public:
     const XmlError *getLastError();
 
 private:
+    // The SAX callbacks reach the parse state through XmlReaderAccess
+    friend class XmlReaderAccess;
+    bool skippingSubtree() const;
+    bool skipStartElement();
+    bool skipEndElement();
+
+    bool enterElement(const XmlAttributes &);
+    void leaveElement();
+    bool inFragment() const;
+    bool documentEvents() const;
+    XmlElementHandler *elementHandler(const xmlChar *qName,
+            const xmlChar *localName, const xmlChar *namespaceURI);
+    void releaseNamespace(XmlNamespace *);
+
+    bool bufferCharacters(const xmlChar *, int);
+    bool flushCharacters();
+
+    // Entities of the DTD named by the DOCTYPE
+    void useDtd(const xmlChar *publicId, const xmlChar *systemId);
+    xmlEntityPtr dtdEntity(const xmlChar *name) const;
+
     bool setupSAXHandler(xmlSAXHandler &);
     int parseChunk(xmlParserCtxtPtr, const char *, int, int);
-    bool parse(const XmlInputSource &input);
+    bool parse(const XmlInputSource &input, unsigned long offset = 0,
+            const char *prologue = NULL);
+    void startParse();
+    bool parseBytes(const char *, int, int);
+    bool parseFirstBytes();
+    bool pushChunk(const char *, int, int);
+    void checkEncoding();
+    long elementOffset() const;
+    void storeElementIndex(const char *, bool);
+    void resetNamespaces();
+    XmlNamespace *newNamespace(const xmlChar *, const xmlChar *,
+            XmlNamespace *);
+    struct _xmlParserCtxt *setupContext(xmlSAXHandler &);
+    static void freeContext(struct _xmlParserCtxt *&, bool);
+    static bool resetContext(struct _xmlParserCtxt *, bool, const char *,
+            int);
 
     XmlContentHandler *_contentHandler;
     XmlDeclHandler *_declarationHandler;
     XmlDTDHandler *_DTDHandler;
     XmlErrorHandler *_errorHandler;
     XmlLexicalHandler *_lexicalHandler;
+    XmlElementDispatcher *pElementDispatcher;
 
     nsStackItem *nsStackCur;
+    nsStackItem *nsStackFree; // popped items, reused before the arena
+    nsBlock *nsFree; // released namespaces, reused before the arena
     int stackcount;
 
+    // Transient allocations of the current parse
+    XmlArena *pArena;
+
     struct _xmlParserCtxt *m_context;
     static const xmlChar *currentEncoding;
 
+    // Push parser contexts kept between parses
+    struct _xmlParserCtxt *m_xmlContext;
+    struct _xmlParserCtxt *m_htmlContext;
+
     enum
     {
         DOCTYPE_XML, DOCTYPE_HTML
     } m_doctype;
 
     bool m_parserStopped :1;
+    bool m_parsingFinished :1;
     bool m_sawError :1;
     bool m_endDocumentHandlerCalled :1;
+    bool m_sniffEncoding :1;
+    bool m_contextReused :1;
+
+    // Open elements left in the skipped subtree, 0 when not skipping
+    int m_skipDepth;
+
+    // Between begin() and finish()
+    bool m_feeding;
+
+    // Depth of the current element, 0 outside the root
+    int m_depth;
+
+    // Index of the document being parsed, NULL when not building one
+    XmlElementIndex *pElementIndex;
+    bool bBuildElementIndex;
+
+    // Fragment requested with parseFragment(), found by searching the
+    // document from the top or by seeking to its offset in the index
+    enum
+    {
+        FRAGMENT_OFF, FRAGMENT_SEARCH, FRAGMENT_SEEK
+    } m_fragmentMode;
+    std::string m_fragmentId;
+    int m_fragmentDepth; // depth of the fragment element, 0 when outside
+    bool m_fragmentFound;
+
+    // First bytes of the document, held until the encoding can be detected
+    char m_firstBytes[4];
+    int m_firstBytesLength;
+    size_t m_bytesParsed;
+    size_t m_inputStart; // bytes before the parser's input, a BOM
+
+    // Whether libxml2 reads the input as UTF-8, pending until it has
+    // picked the encoding
+    enum
+    {
+        UTF8_INPUT_NO, UTF8_INPUT_PENDING, UTF8_INPUT_YES
+    } m_utf8Input;
 
     bool bUseCache;
 
+    // Text collected for a single characters() call
+    bool bCoalesceCharacters;
+    xmlChar *m_textBuffer;
+    size_t m_textLength;
+    size_t m_textCapacity;
+
+    // Shared DTD of the document, NULL if there is none
+    const CachedDtd *m_dtd;
+
     XmlError *pLastError;
 };
 
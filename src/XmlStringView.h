@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMLSTRINGVIEW_H
+#define XMLSTRINGVIEW_H
+
+#ifdef WIN32
+#ifdef KOLIBRE_DLL
+#define KOLIBRE_API __declspec(dllexport)
+#else
+#define KOLIBRE_API __declspec(dllimport)
+#endif
+#else
+#define KOLIBRE_API
+#endif
+
+#include <libxml/xmlstring.h>
+#include <string.h>
+#include <string>
+
+/**
+ * \class XmlStringView
+ *
+ * \brief Read only view of a UTF-8 string owned by someone else
+ *
+ * A view is a pointer and a length, nothing is copied or allocated. Views
+ * over names, values and characters passed to a handler are valid for the
+ * duration of the callback. The UTF-8 helpers do not depend on the locale.
+ */
+class KOLIBRE_API XmlStringView
+{
+public:
+    static const size_t npos = (size_t) -1;
+
+    /**
+     * Constructor for an empty view
+     */
+    XmlStringView() :
+            m_data(0), m_length(0)
+    {
+    }
+
+    /**
+     * Constructor
+     *
+     * @param str pointer to a NUL terminated string, may be NULL
+     */
+    XmlStringView(const xmlChar *str) :
+            m_data(str), m_length(str ? strlen((const char *) str) : 0)
+    {
+    }
+
+    /**
+     * Constructor
+     *
+     * @param str pointer to the first byte
+     * @param length number of bytes in the view
+     */
+    XmlStringView(const xmlChar *str, size_t length) :
+            m_data(str), m_length(length)
+    {
+    }
+
+    /**
+     * Get pointer to the first byte, the view is not NUL terminated
+     */
+    const xmlChar *data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Get number of bytes in the view
+     */
+    size_t length() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Check if the view has no bytes
+     */
+    bool empty() const
+    {
+        return m_length == 0;
+    }
+
+    /**
+     * Get the byte at a position
+     */
+    xmlChar operator[](size_t pos) const
+    {
+        return m_data[pos];
+    }
+
+    /**
+     * Compare with another view
+     *
+     * @return true if both have the same bytes
+     */
+    bool operator==(const XmlStringView &other) const
+    {
+        return m_length == other.m_length
+                && (m_length == 0 || memcmp(m_data, other.m_data, m_length) == 0);
+    }
+
+    bool operator!=(const XmlStringView &other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Compare with a NUL terminated string
+     *
+     * @return true if the string has the same bytes as the view
+     */
+    bool operator==(const char *str) const
+    {
+        return str != NULL && strncmp((const char *) m_data, str, m_length) == 0
+                && str[m_length] == '\0';
+    }
+
+    bool operator!=(const char *str) const
+    {
+        return !(*this == str);
+    }
+
+    /**
+     * Check if the view starts with a NUL terminated string
+     */
+    bool startsWith(const char *str) const
+    {
+        size_t length = strlen(str);
+        return length <= m_length && memcmp(m_data, str, length) == 0;
+    }
+
+    /**
+     * Find a byte
+     *
+     * @param c byte to look for
+     * @param pos position to start at
+     * @return position of the byte
+     * @retval npos if not found
+     */
+    size_t find(xmlChar c, size_t pos = 0) const
+    {
+        if (pos >= m_length)
+            return npos;
+        const void *found = memchr(m_data + pos, c, m_length - pos);
+        return found ? (const xmlChar *) found - m_data : npos;
+    }
+
+    /**
+     * Get a part of the view
+     *
+     * @param pos position of the first byte, clamped to the length
+     * @param count number of bytes, clamped to what is left
+     */
+    XmlStringView substr(size_t pos, size_t count = npos) const
+    {
+        if (pos > m_length)
+            pos = m_length;
+        if (count > m_length - pos)
+            count = m_length - pos;
+        return XmlStringView(m_data + pos, count);
+    }
+
+    /**
+     * Get the prefix of a qualified name
+     *
+     * @return the part before the colon, empty if there is none
+     */
+    XmlStringView prefix() const
+    {
+        size_t colon = find(':');
+        return colon == npos ? XmlStringView(m_data, 0) : substr(0, colon);
+    }
+
+    /**
+     * Get the local part of a qualified name
+     *
+     * @return the part after the colon, the whole view if there is none
+     */
+    XmlStringView localName() const
+    {
+        size_t colon = find(':');
+        return colon == npos ? *this : substr(colon + 1);
+    }
+
+    /**
+     * Count the UTF-8 encoded characters
+     *
+     * @return number of code points, continuation bytes are not counted
+     */
+    size_t characterCount() const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < m_length; i++)
+            if ((m_data[i] & 0xC0) != 0x80)
+                count++;
+        return count;
+    }
+
+    /**
+     * Cut the view without splitting a UTF-8 sequence
+     *
+     * @param maxBytes largest number of bytes to keep
+     * @return the longest prefix of whole characters that fits
+     */
+    XmlStringView truncate(size_t maxBytes) const
+    {
+        if (maxBytes >= m_length)
+            return *this;
+        size_t length = maxBytes;
+        while (length > 0 && (m_data[length] & 0xC0) == 0x80)
+            length--;
+        return XmlStringView(m_data, length);
+    }
+
+    /**
+     * Copy the view into a string, this allocates
+     */
+    std::string str() const
+    {
+        return std::string((const char *) m_data, m_length);
+    }
+
+private:
+    const xmlChar *m_data;
+    size_t m_length;
+};
+
+#endif
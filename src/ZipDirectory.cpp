@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include "ZipDirectory.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlZipDirectoryLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.zipdirectory"));
+
+// Record signatures and sizes
+#define ZIP_END_SIGNATURE 0x06054b50
+#define ZIP_END_SIZE 22
+#define ZIP_ENTRY_SIGNATURE 0x02014b50
+#define ZIP_ENTRY_SIZE 46
+
+// The end record may be followed by a comment of up to 64k
+#define ZIP_MAX_COMMENT 65535
+
+static unsigned int get16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long) p[3] << 24);
+}
+
+// Read exactly length bytes at offset
+static bool readAt(int fd, unsigned char *buffer, size_t length, off_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t bytes = pread(fd, buffer, length, offset);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            return false;
+        buffer += bytes;
+        length -= bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+ZipDirectory::ZipDirectory() :
+        mFileSize(0), mFileMtime(0), mFileInode(0)
+{
+}
+
+ZipDirectory::~ZipDirectory()
+{
+}
+
+/**
+ * Read the central directory of an archive
+ *
+ * Archives in the zip64 format are not supported.
+ *
+ * @param archive path of the archive
+ * @return true if the directory was read
+ */
+bool ZipDirectory::load(const std::string &archive)
+{
+    entries.clear();
+
+    int fd = open(archive.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        mErrorMsg = strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        mErrorMsg = strerror(errno);
+        close(fd);
+        return false;
+    }
+    mFileSize = st.st_size;
+    mFileMtime = st.st_mtime;
+    mFileInode = st.st_ino;
+
+    // Look for the end record from the end of the file
+    size_t tailSize = ZIP_END_SIZE + ZIP_MAX_COMMENT;
+    if ((off_t) tailSize > mFileSize)
+        tailSize = mFileSize;
+    std::vector<unsigned char> tail(tailSize + 1);
+    if (tailSize < ZIP_END_SIZE
+            || !readAt(fd, &tail[0], tailSize, mFileSize - tailSize))
+    {
+        mErrorMsg = "Not a zip archive";
+        close(fd);
+        return false;
+    }
+
+    const unsigned char *end = NULL;
+    for (size_t i = tailSize - ZIP_END_SIZE + 1; i-- > 0;)
+    {
+        if (get32(&tail[i]) == ZIP_END_SIGNATURE)
+        {
+            end = &tail[i];
+            break;
+        }
+    }
+    if (end == NULL)
+    {
+        mErrorMsg = "Not a zip archive";
+        close(fd);
+        return false;
+    }
+
+    unsigned long count = get16(end + 10);
+    unsigned long length = get32(end + 12);
+    unsigned long offset = get32(end + 16);
+    if (count == 0xffff || length == 0xffffffff || offset == 0xffffffff)
+    {
+        mErrorMsg = "zip64 archives are not supported";
+        close(fd);
+        return false;
+    }
+    if ((off_t) (offset + length) > mFileSize)
+    {
+        mErrorMsg = "Corrupt zip directory";
+        close(fd);
+        return false;
+    }
+
+    std::vector<unsigned char> directory(length + 1);
+    bool ok = readAt(fd, &directory[0], length, offset);
+    close(fd);
+    if (!ok)
+    {
+        mErrorMsg = strerror(errno);
+        return false;
+    }
+
+    if (!parse(&directory[0], length, count))
+        return false;
+
+    LOG4CXX_DEBUG(xmlZipDirectoryLog,
+            "Read " << entries.size() << " entries of " << archive);
+    return true;
+}
+
+/**
+ * Parse the central directory records
+ */
+bool ZipDirectory::parse(const unsigned char *directory, size_t length,
+        unsigned long count)
+{
+    const unsigned char *p = directory;
+    const unsigned char *end = directory + length;
+
+    for (unsigned long i = 0; i < count; i++)
+    {
+        if (end - p < ZIP_ENTRY_SIZE || get32(p) != ZIP_ENTRY_SIGNATURE)
+        {
+            mErrorMsg = "Corrupt zip directory";
+            entries.clear();
+            return false;
+        }
+
+        unsigned int nameLength = get16(p + 28);
+        unsigned int extraLength = get16(p + 30);
+        unsigned int commentLength = get16(p + 32);
+        size_t recordSize = ZIP_ENTRY_SIZE + nameLength + extraLength
+                + commentLength;
+        if ((size_t) (end - p) < recordSize)
+        {
+            mErrorMsg = "Corrupt zip directory";
+            entries.clear();
+            return false;
+        }
+
+        ZipEntry entry;
+        entry.encrypted = (get16(p + 8) & 1) != 0;
+        entry.method = get16(p + 10);
+        entry.crc = get32(p + 16);
+        entry.compressedSize = get32(p + 20);
+        entry.size = get32(p + 24);
+        entry.offset = get32(p + 42);
+
+        std::string name((const char *) p + ZIP_ENTRY_SIZE, nameLength);
+        entries[name] = entry;
+
+        p += recordSize;
+    }
+
+    return true;
+}
+
+/**
+ * Find an entry by its path in the archive
+ *
+ * @param name path of the entry, without a leading slash
+ * @return pointer to the entry, valid as long as the directory
+ * @retval NULL if there is no such entry
+ */
+const ZipEntry *ZipDirectory::find(const std::string &name) const
+{
+    std::map<std::string, ZipEntry>::const_iterator it = entries.find(name);
+    if (it == entries.end())
+        return NULL;
+    return &(*it).second;
+}
+
+/**
+ * Get the number of entries
+ */
+size_t ZipDirectory::size() const
+{
+    return entries.size();
+}
+
+/**
+ * Check that the archive is the one the directory was read from
+ */
+bool ZipDirectory::matchesFileState(off_t size, time_t mtime,
+        ino_t inode) const
+{
+    return mFileSize == size && mFileMtime == mtime && mFileInode == inode;
+}
+
+const std::string &ZipDirectory::getErrorMsg() const
+{
+    return mErrorMsg;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZIPDIRECTORY_H
+#define ZIPDIRECTORY_H
+
+#include <sys/types.h>
+#include <ctime>
+#include <string>
+#include <map>
+
+/**
+ * Location and format of a file in a zip archive
+ */
+struct ZipEntry
+{
+    unsigned long offset; /**< offset of the local file header */
+    unsigned long compressedSize; /**< bytes stored in the archive */
+    unsigned long size; /**< bytes after inflating */
+    unsigned long crc; /**< CRC-32 of the inflated bytes */
+    unsigned int method; /**< 0 for stored, 8 for deflated */
+    bool encrypted; /**< the entry is encrypted */
+};
+
+//
+// The central directory of a zip archive, read once and kept by the
+// DataStreamHandler along with the size, modification time and inode of
+// the archive it was read from.
+//
+
+class ZipDirectory
+{
+public:
+    ZipDirectory();
+    ~ZipDirectory();
+
+    bool load(const std::string &archive);
+    const ZipEntry *find(const std::string &name) const;
+
+    size_t size() const;
+    bool matchesFileState(off_t size, time_t mtime, ino_t inode) const;
+
+    const std::string &getErrorMsg() const;
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    ZipDirectory(const ZipDirectory&);
+    ZipDirectory& operator=(const ZipDirectory&);
+
+    bool parse(const unsigned char *directory, size_t length,
+            unsigned long entries);
+
+    std::map<std::string, ZipEntry> entries;
+
+    off_t mFileSize;
+    time_t mFileMtime;
+    ino_t mFileInode;
+
+    std::string mErrorMsg;
+};
+
+#endif
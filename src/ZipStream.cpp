@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ZipStream.h"
+#include "CacheObject.h"
+#include <log4cxx/logger.h>
+
+// create logger which will become a child to logger kolibre.xmlreader
+log4cxx::LoggerPtr xmlZipStreamLog(
+        log4cxx::Logger::getLogger("kolibre.xmlreader.zipstream"));
+
+#define ZIP_LOCAL_SIGNATURE 0x04034b50
+#define ZIP_LOCAL_SIZE 30
+#define ZIP_STORED 0
+#define ZIP_DEFLATED 8
+
+/**
+ * Create a stream for an entry of an archive
+ *
+ * The entry is copied from the directory, which is only used during the
+ * call. Errors are reported by the first read.
+ *
+ * @param archive path of the archive
+ * @param name path of the entry in the archive
+ * @param directory central directory of the archive, or NULL if it could not
+ * be read
+ */
+ZipStream::ZipStream(const std::string archive, const std::string name,
+        const ZipDirectory *directory) :
+        sArchive(archive), sName(name), entry(), bHasDirectory(
+                directory != NULL), bFound(false), fd(-1), fMapped(
+                0), fMappedSize(0), fDataOffset(0), fRawBytesRead(0), zStream(
+                0), zInput(0), bInflateEnded(false), fTotalBytesRead(0), fCrc(
+                0), bCheckCrc(true), bIsOpen(false), bFailed(
+                false)
+{
+    LOG4CXX_DEBUG(xmlZipStreamLog,
+            "constructor for " << sName << " in " << sArchive);
+
+    mErrorMsg = "unknown error";
+    mErrorCode = NONE;
+
+    if (directory == NULL)
+        return;
+
+    const ZipEntry *e = directory->find(sName);
+    if (e != NULL)
+    {
+        entry = *e;
+        bFound = true;
+    }
+}
+
+ZipStream::~ZipStream()
+{
+    LOG4CXX_DEBUG(xmlZipStreamLog,
+            "destructor for " << sName << ", read " << fTotalBytesRead << "/" << entry.size);
+
+    if (zStream != NULL)
+    {
+        inflateEnd(zStream);
+        delete zStream;
+    }
+    delete[] zInput;
+
+    if (fMapped != NULL)
+        munmap(fMapped, fMappedSize);
+    if (fd >= 0)
+        close(fd);
+}
+
+/**
+ * Split an url of an entry in a zip archive
+ *
+ * Accepts zip:archive#name for any archive and archive.epub#name.
+ *
+ * @param url the url
+ * @param archive set to the path of the archive
+ * @param name set to the path of the entry in the archive
+ * @return true if the url names an entry in an archive
+ */
+bool ZipStream::splitUrl(const std::string &url, std::string &archive,
+        std::string &name)
+{
+    size_t hash = url.find('#');
+    if (hash == std::string::npos)
+        return false;
+
+    if (url.compare(0, 4, "zip:") == 0)
+        archive = url.substr(4, hash - 4);
+    else if (hash >= 5 && strncasecmp(url.c_str() + hash - 5, ".epub", 5) == 0)
+        archive = url.substr(0, hash);
+    else
+        return false;
+
+    // Names in the archive have no leading slash
+    size_t start = url.find_first_not_of('/', hash + 1);
+    if (start == std::string::npos)
+        return false;
+    name = url.substr(start);
+    return true;
+}
+
+unsigned int ZipStream::curPos() const
+{
+    return fTotalBytesRead;
+}
+
+/**
+ * Entries are never cached, inflating them from the archive costs about
+ * as much as reading a cached copy, so the setting is ignored. A
+ * TidyStream reading the entry still caches its tidied output.
+ */
+void ZipStream::useCache(bool setting)
+{
+}
+
+/**
+ * Set the error and mark the stream as failed
+ *
+ * @return false
+ */
+bool ZipStream::fail(const std::string &msg, ErrorCode code)
+{
+    mErrorMsg = msg;
+    mErrorCode = code;
+    bFailed = true;
+    LOG4CXX_ERROR(xmlZipStreamLog,
+            "failed to read " << sName << " in " << sArchive << ": " << mErrorMsg);
+    return false;
+}
+
+/**
+ * Open the archive and find the data of the entry
+ */
+bool ZipStream::openStream()
+{
+    if (!bHasDirectory)
+        return fail("Can not read zip archive " + sArchive, ACCESS_DENIED);
+    if (!bFound)
+        return fail("No such file in archive", NOT_FOUND);
+    if (entry.encrypted)
+        return fail("Encrypted zip entries are not supported", READ_FAILED);
+    if (entry.method != ZIP_STORED && entry.method != ZIP_DEFLATED)
+        return fail("Unsupported zip compression method", READ_FAILED);
+
+    fd = open(sArchive.c_str(), O_RDONLY);
+    if (fd < 0)
+        return fail(strerror(errno), ACCESS_DENIED);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        return fail(strerror(errno), READ_FAILED);
+
+    // Map the whole archive, pages are only read as the entry is inflated
+    if (st.st_size > 0)
+    {
+        void *mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            fMapped = (char *) mapped;
+            fMappedSize = st.st_size;
+        }
+    }
+
+    // The local header repeats the name and may have its own extra field
+    unsigned char header[ZIP_LOCAL_SIZE];
+    fDataOffset = entry.offset;
+    if (readRaw((char *) header, ZIP_LOCAL_SIZE) != ZIP_LOCAL_SIZE
+            || (header[0] | (header[1] << 8) | (header[2] << 16)
+                    | ((unsigned long) header[3] << 24)) != ZIP_LOCAL_SIGNATURE)
+        return fail("Corrupt zip entry", READ_FAILED);
+
+    fDataOffset = entry.offset + ZIP_LOCAL_SIZE + (header[26] | (header[27] << 8))
+            + (header[28] | (header[29] << 8));
+    fRawBytesRead = 0;
+    if ((off_t) (fDataOffset + entry.compressedSize) > st.st_size)
+        return fail("Corrupt zip entry", READ_FAILED);
+
+    if (entry.method == ZIP_DEFLATED)
+    {
+        zStream = new z_stream;
+        memset(zStream, 0, sizeof(z_stream));
+
+        // Entries are raw deflate data without a zlib header
+        if (inflateInit2(zStream, -MAX_WBITS) != Z_OK)
+        {
+            delete zStream;
+            zStream = NULL;
+            return fail("Failed to initialize zlib", UNKNOWN_ERROR);
+        }
+
+        if (fMapped != NULL)
+        {
+            zStream->next_in = (Bytef *) fMapped + fDataOffset;
+            zStream->avail_in = entry.compressedSize;
+            fRawBytesRead = entry.compressedSize;
+        }
+        else
+            zInput = new char[Z_CHUNK_SIZE];
+    }
+
+    bIsOpen = true;
+    return true;
+}
+
+/**
+ * Read stored bytes of the entry from the mapping or the file
+ *
+ * @return number of bytes read, fewer than asked for if the archive ends
+ * first, or -1 on a read error with errno set
+ */
+int ZipStream::readRaw(char *buffer, size_t bytes)
+{
+    if (fMapped != NULL)
+    {
+        size_t offset = fDataOffset + fRawBytesRead;
+        if (offset >= fMappedSize)
+            return 0;
+        if (bytes > fMappedSize - offset)
+            bytes = fMappedSize - offset;
+        memcpy(buffer, fMapped + offset, bytes);
+        fRawBytesRead += bytes;
+        return bytes;
+    }
+
+    size_t done = 0;
+    while (done < bytes)
+    {
+        ssize_t n = pread(fd, buffer + done, bytes - done,
+                fDataOffset + fRawBytesRead);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return -1;
+        if (n == 0)
+            break;
+        done += n;
+        fRawBytesRead += n;
+    }
+    return done;
+}
+
+/**
+ * Read exactly the given number of stored bytes, failing the stream if the
+ * archive ends first or cannot be read
+ *
+ * @return boolean of the result
+ */
+bool ZipStream::readRawFully(char *buffer, size_t bytes)
+{
+    int n = readRaw(buffer, bytes);
+    if (n < 0)
+        return fail(strerror(errno), READ_FAILED);
+    if ((size_t) n < bytes)
+        return fail("Truncated zip entry", READ_FAILED);
+    return true;
+}
+
+/**
+ * Read inflated bytes of the entry
+ *
+ * The CRC-32 of the entry is checked when its end is reached.
+ *
+ * @return number of bytes read, 0 at the end of the entry and -1 on error
+ */
+int ZipStream::readBytes(char* const toFill, const unsigned int maxToRead)
+{
+    if (bFailed)
+        return -1;
+    if (!bIsOpen && !openStream())
+        return -1;
+
+    unsigned long bytes = 0;
+    if (zStream == NULL)
+    {
+        bytes = entry.size - fTotalBytesRead;
+        if (bytes > maxToRead)
+            bytes = maxToRead;
+        if (bytes > 0 && !readRawFully(toFill, bytes))
+            return -1;
+    }
+    else
+    {
+        zStream->next_out = (Bytef *) toFill;
+        zStream->avail_out = maxToRead;
+
+        while (zStream->avail_out == maxToRead && !bInflateEnded)
+        {
+            if (zStream->avail_in == 0)
+            {
+                unsigned long left = entry.compressedSize - fRawBytesRead;
+                if (left == 0)
+                {
+                    fail("Unexpected end of zip entry", READ_FAILED);
+                    return -1;
+                }
+                if (left > Z_CHUNK_SIZE)
+                    left = Z_CHUNK_SIZE;
+                if (!readRawFully(zInput, left))
+                    return -1;
+                zStream->next_in = (Bytef *) zInput;
+                zStream->avail_in = left;
+            }
+
+            int err = inflate(zStream, Z_NO_FLUSH);
+            if (err == Z_STREAM_END)
+                bInflateEnded = true;
+            else if (err != Z_OK)
+            {
+                fail("Corrupt zip entry", READ_FAILED);
+                return -1;
+            }
+        }
+        bytes = maxToRead - zStream->avail_out;
+    }
+
+    fCrc = crc32(fCrc, (const Bytef *) toFill, bytes);
+    fTotalBytesRead += bytes;
+
+    if (bytes == 0 && bCheckCrc
+            && (fTotalBytesRead != entry.size || fCrc != entry.crc))
+    {
+        fail("zip entry failed its CRC check", READ_FAILED);
+        return -1;
+    }
+
+    return bytes;
+}
+
+/**
+ * Skip bytes of the entry
+ *
+ * Stored entries are skipped without reading, which also skips the CRC
+ * check. Deflated ones are inflated and discarded.
+ */
+bool ZipStream::skipBytes(unsigned long count)
+{
+    if (bFailed)
+        return false;
+    if (!bIsOpen && !openStream())
+        return false;
+
+    if (zStream != NULL)
+        return InputStream::skipBytes(count);
+
+    if (fTotalBytesRead + count > entry.size)
+    {
+        mErrorMsg = "Can not skip past the end of the file";
+        mErrorCode = READ_FAILED;
+        return false;
+    }
+
+    fRawBytesRead += count;
+    fTotalBytesRead += count;
+    bCheckCrc = false;
+    return true;
+}
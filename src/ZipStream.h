@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZIPSTREAM_H
+#define ZIPSTREAM_H
+
+#include <zlib.h>
+#include <string>
+
+#include "InputStream.h"
+#include "ZipDirectory.h"
+
+//
+// This class reads a single entry of a zip archive, such as an EPUB or a
+// zipped DAISY book, inflating it straight into the parser. The archive is
+// mapped into memory when possible and read with pread otherwise. Entries
+// are not cached, useCache() has no effect.
+//
+
+class ZipStream: public InputStream
+{
+public:
+    ZipStream(const std::string archive, const std::string name,
+            const ZipDirectory *directory);
+    ~ZipStream();
+
+    static bool splitUrl(const std::string &url, std::string &archive,
+            std::string &name);
+
+    unsigned int curPos() const;
+    int readBytes(char* const toFill, const unsigned int maxToRead);
+    bool skipBytes(unsigned long count);
+
+    void useCache(bool);
+
+private:
+    // -----------------------------------------------------------------------
+    //  Unimplemented constructors and operators
+    // -----------------------------------------------------------------------
+    ZipStream(const ZipStream&);
+    ZipStream& operator=(const ZipStream&);
+
+    bool openStream();
+    int readRaw(char *buffer, size_t bytes);
+    bool readRawFully(char *buffer, size_t bytes);
+    bool fail(const std::string &msg, ErrorCode code);
+
+    std::string sArchive;
+    std::string sName;
+
+    ZipEntry entry;
+    bool bHasDirectory;
+    bool bFound;
+
+    int fd;
+    char *fMapped;
+    size_t fMappedSize;
+
+    // Position of the entry's data in the archive and bytes of it consumed
+    unsigned long fDataOffset;
+    unsigned long fRawBytesRead;
+
+    z_stream *zStream;
+    char *zInput;
+    bool bInflateEnded;
+
+    unsigned long fTotalBytesRead;
+    unsigned long fCrc;
+    bool bCheckCrc;
+
+    bool bIsOpen;
+    bool bFailed;
+};
+
+#endif
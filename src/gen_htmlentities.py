@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2012 Kolibre
+#
+# This file is part of kolibre-xmlreader.
+#
+# Kolibre-xmlreader is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# Kolibre-xmlreader is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+
+#
+# Generate HtmlEntities.cpp, a perfect hash table of the HTML5 named
+# character references, from the list shipped with Python.
+#
+#   ./gen_htmlentities.py > HtmlEntities.cpp
+#
+# Every name hashes to a bucket which holds a seed. The seed is chosen so
+# that hashing the names of the bucket with it gives each its own slot in
+# the entity table, which makes a lookup two hashes and one compare.
+#
+
+import sys
+from html.entities import html5
+
+HASH_SEED = 0x811c9dc5
+HASH_PRIME = 0x01000193
+
+
+def fnv(name, seed):
+    h = (HASH_SEED ^ seed) & 0xffffffff
+    for c in name.encode('ascii'):
+        h = ((h ^ c) * HASH_PRIME) & 0xffffffff
+    return h
+
+
+def escape(value):
+    return ''.join(chr(b) if chr(b).isascii() and chr(b).isalnum()
+                   else '\\%03o' % b for b in value)
+
+
+def build(names):
+    size = len(names)
+    buckets = [[] for _ in range(size)]
+    for name in names:
+        buckets[fnv(name, 0) % size].append(name)
+
+    seeds = [0] * size
+    slots = [None] * size
+    order = sorted(range(size), key=lambda b: -len(buckets[b]))
+    for b in order:
+        if not buckets[b]:
+            break
+        seed = 1
+        while True:
+            taken = [fnv(name, seed) % size for name in buckets[b]]
+            if len(set(taken)) == len(taken) and \
+                    all(slots[t] is None for t in taken):
+                break
+            seed += 1
+        seeds[b] = seed
+        for name, t in zip(buckets[b], taken):
+            slots[t] = name
+    return seeds, slots
+
+
+def main():
+    # The parser strips the ';', names without it are legacy duplicates
+    entities = dict((name[:-1], value) for name, value in html5.items()
+                    if name.endswith(';'))
+    names = sorted(entities)
+    seeds, slots = build(names)
+
+    out = sys.stdout
+    out.write('''/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generated by gen_htmlentities.py, do not edit
+
+#include <pthread.h>
+#include <string.h>
+
+#include "HtmlEntities.h"
+
+#define HTML_ENTITY_COUNT %d
+
+struct HtmlEntityValue
+{
+    const char *name;
+    const char *value;
+    int length;
+};
+
+static const HtmlEntityValue htmlEntityValues[HTML_ENTITY_COUNT] =
+{
+''' % len(names))
+    for name in slots:
+        value = entities[name].encode('utf-8')
+        out.write('    { "%s", "%s", %d },\n'
+                  % (name, escape(value), len(value)))
+    out.write('};\n\nstatic const unsigned short htmlEntitySeeds[HTML_ENTITY_COUNT] =\n{')
+    for i, seed in enumerate(seeds):
+        out.write(('\n    ' if i % 12 == 0 else ' ') + '%d,' % seed)
+    out.write('''
+};
+
+// Filled from htmlEntityValues on the first lookup
+static xmlEntity htmlEntities[HTML_ENTITY_COUNT];
+static pthread_once_t htmlEntitiesOnce = PTHREAD_ONCE_INIT;
+
+static void initHtmlEntities()
+{
+    for (int i = 0; i < HTML_ENTITY_COUNT; i++)
+    {
+        xmlEntityPtr entity = &htmlEntities[i];
+        entity->type = XML_ENTITY_DECL;
+        entity->name = BAD_CAST htmlEntityValues[i].name;
+        entity->orig = BAD_CAST htmlEntityValues[i].value;
+        entity->content = BAD_CAST htmlEntityValues[i].value;
+        entity->length = htmlEntityValues[i].length;
+        entity->etype = XML_INTERNAL_PREDEFINED_ENTITY;
+    }
+}
+
+static unsigned int hashName(const xmlChar *name, unsigned int seed)
+{
+    unsigned int h = 0x%08xU ^ seed;
+    while (*name)
+        h = (h ^ *name++) * 0x%08xU;
+    return h;
+}
+
+/**
+ * Look up a HTML named character reference
+ *
+ * @param name the name of the entity without '&' and ';'
+ * @return pointer to a predefined entity holding the UTF-8 characters
+ * @retval NULL if there is no entity with the name
+ */
+xmlEntityPtr getHtmlEntity(const xmlChar *name)
+{
+    unsigned int seed = htmlEntitySeeds[hashName(name, 0) %% HTML_ENTITY_COUNT];
+    unsigned int slot = hashName(name, seed) %% HTML_ENTITY_COUNT;
+    if (strcmp(htmlEntityValues[slot].name, (const char *) name) != 0)
+        return NULL;
+    pthread_once(&htmlEntitiesOnce, initHtmlEntities);
+    return &htmlEntities[slot];
+}
+''' % (HASH_SEED, HASH_PRIME))
+
+
+if __name__ == '__main__':
+    main()
@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "CacheObject.h"
+#include "CacheReader.h"
 #include "setup_logging.h"
 
 const size_t BUF_SIZE = 1024; // Z_CHUNK_SIZE;
@@ -72,11 +73,13 @@ int main(int argc, char* argv[])
     cout << "cacheObject state:" << cache.getState() << endl;
 
     // Read the file from the cache object
+    CacheReader *reader = new CacheReader(&cache);
     do
     {
-        res = cache.readBytes(buffer, BUF_SIZE - 1);
+        res = reader->readBytes(buffer, BUF_SIZE - 1);
         copy(buffer, buffer + res, back_inserter(bufcont));
     } while (res != 0);
+    delete reader;
 
     if (filecont != bufcont)
     {
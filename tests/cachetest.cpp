@@ -0,0 +1,606 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "CacheObject.h"
+#include "CacheReader.h"
+#include "CacheWriter.h"
+#include "DataStreamHandler.h"
+#include "XmlReader.h"
+#include "XmlDefaultHandler.h"
+#include "setup_logging.h"
+
+#define READERS 4
+
+using namespace std;
+
+// Read the whole file into contents
+static bool readFile(const char *path, string &contents)
+{
+    ifstream file(path, ios::in | ios::binary);
+    if (!file)
+        return false;
+    contents.assign((istreambuf_iterator<char>(file)),
+            istreambuf_iterator<char>());
+    return true;
+}
+
+// Create a FULL cache entry holding contents
+static CacheObject *fillCacheObject(const char *url, const string &contents)
+{
+    CacheObject *co = new CacheObject(url);
+    for (size_t pos = 0; pos < contents.size(); pos += 1000)
+    {
+        size_t bytes = contents.size() - pos < 1000 ? contents.size() - pos : 1000;
+        co->writeBytes(contents.data() + pos, bytes);
+    }
+    co->writeBytes(NULL, 0);
+    co->setContentLength(contents.size());
+    return co;
+}
+
+// Read an entry through a CacheReader, in chunks of the given size
+static string readCacheObject(CacheObject *co, size_t chunk)
+{
+    string result;
+    vector<char> buffer(chunk);
+    CacheReader reader(co);
+    int bytes;
+    while ((bytes = reader.readBytes(&buffer[0], chunk)) > 0)
+        result.append(&buffer[0], bytes);
+    return result;
+}
+
+struct ReaderJob
+{
+    CacheObject *cacheObject;
+    size_t chunk;
+    string result;
+};
+
+static void *runReader(void *arg)
+{
+    ReaderJob *job = (ReaderJob *) arg;
+    for (int i = 0; i < 20; i++)
+        job->result = readCacheObject(job->cacheObject, job->chunk);
+    return NULL;
+}
+
+/*
+ * Several readers stream one entry at the same time, each with its own
+ * cursor and codec, and keep it alive after the creator has dropped it
+ */
+static bool testReaders(const string &contents)
+{
+    CacheObject *co = fillCacheObject("readers", contents);
+
+    ReaderJob jobs[READERS];
+    pthread_t threads[READERS];
+    for (int i = 0; i < READERS; i++)
+    {
+        jobs[i].cacheObject = co;
+        jobs[i].chunk = 100 + 1000 * i;
+        co->ref();
+        if (pthread_create(&threads[i], NULL, runReader, &jobs[i]) != 0)
+        {
+            cout << "Failed to start reader " << i << endl;
+            return false;
+        }
+    }
+
+    // The readers hold their own references
+    co->unref();
+
+    bool ok = true;
+    for (int i = 0; i < READERS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if (jobs[i].result != contents)
+        {
+            cout << "Reader " << i << " read " << jobs[i].result.size()
+                    << " bytes, expected " << contents.size() << endl;
+            ok = false;
+        }
+        jobs[i].cacheObject->unref();
+    }
+
+    // A reader accounts its codec to the entry until it is done
+    co = fillCacheObject("accounting", contents);
+    unsigned long restingSize = co->getMemoryUsage();
+    CacheReader *reader = new CacheReader(co);
+    char buffer[100];
+    reader->readBytes(buffer, sizeof(buffer));
+    if (co->getMemoryUsage() <= restingSize)
+    {
+        cout << "Codec of a reader is not accounted to the entry" << endl;
+        ok = false;
+    }
+    delete reader;
+    if (co->getMemoryUsage() != restingSize)
+    {
+        cout << "Entry uses " << co->getMemoryUsage() << " bytes after reading, "
+                << restingSize << " before" << endl;
+        ok = false;
+    }
+
+    co->unref();
+    return ok;
+}
+
+// Compare a statistics counter with the expected value
+static bool checkCounter(const char *name, unsigned long value,
+        unsigned long expected)
+{
+    if (value == expected)
+        return true;
+    cout << name << " is " << value << ", expected " << expected << endl;
+    return false;
+}
+
+/*
+ * The cache stays within its budget by evicting entries and counts hits,
+ * misses and evictions
+ */
+static bool testBudget(const string &contents, const char *first,
+        const char *second)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    handler->resetCacheStatistics();
+    bool ok = true;
+
+    ok &= handler->getCacheObject(first) == NULL;
+    handler->addCacheObject(first, fillCacheObject(first, contents));
+    ok &= handler->getCacheObject(first) != NULL;
+
+    CacheStatistics stats = handler->getCacheStatistics();
+    ok &= checkCounter("entries", stats.entries, 1);
+    ok &= checkCounter("hits", stats.hits, 1);
+    ok &= checkCounter("misses", stats.misses, 1);
+    ok &= checkCounter("evictions", stats.evictions, 0);
+    if (stats.usage == 0 || stats.usage != handler->getCacheUsage())
+    {
+        cout << "Usage of one entry is " << stats.usage << endl;
+        ok = false;
+    }
+
+    // Room for one and a half entries, the second entry evicts the first
+    unsigned long budget = stats.usage + stats.usage / 2;
+    handler->setCacheBudget(budget);
+    handler->addCacheObject(second, fillCacheObject(second, contents));
+
+    stats = handler->getCacheStatistics();
+    ok &= checkCounter("budget", stats.budget, budget);
+    ok &= checkCounter("entries", stats.entries, 1);
+    ok &= checkCounter("evictions", stats.evictions, 1);
+    if (stats.usage > budget)
+    {
+        cout << "Usage " << stats.usage << " exceeds budget " << budget << endl;
+        ok = false;
+    }
+    ok &= handler->getCacheObject(first) == NULL;
+    ok &= handler->getCacheObject(second) != NULL;
+
+    // A budget of 0 disables the cache
+    handler->setCacheBudget(0);
+    stats = handler->getCacheStatistics();
+    ok &= checkCounter("entries", stats.entries, 0);
+    ok &= checkCounter("usage", stats.usage, 0);
+    ok &= checkCounter("evictions", stats.evictions, 2);
+
+    handler->resetCacheStatistics();
+    stats = handler->getCacheStatistics();
+    ok &= checkCounter("hits", stats.hits, 0);
+    ok &= checkCounter("misses", stats.misses, 0);
+    ok &= checkCounter("evictions", stats.evictions, 0);
+
+    handler->DestroyInstance();
+    return ok;
+}
+
+/*
+ * Eviction frees the least recently used entry first, whatever its key
+ */
+static bool testLru(const string &contents)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    const char *urls[] =
+    { "http://lru/a", "http://lru/b", "http://lru/c", "http://lru/d" };
+    bool ok = true;
+
+    for (int i = 0; i < 3; i++)
+        handler->addCacheObject(urls[i], fillCacheObject(urls[i], contents));
+    ok &= handler->getCacheObject(urls[0]) != NULL;
+
+    // Room for three entries, the fourth evicts b which was used longest ago
+    unsigned long usage = handler->getCacheUsage();
+    handler->setCacheBudget(usage + usage / 6);
+    handler->addCacheObject(urls[3], fillCacheObject(urls[3], contents));
+
+    ok &= checkCounter("entries", handler->getCacheStatistics().entries, 3);
+    const bool expected[] =
+    { true, false, true, true };
+    for (int i = 0; i < 4; i++)
+    {
+        if ((handler->getCacheObject(urls[i]) != NULL) != expected[i])
+        {
+            cout << urls[i] << (expected[i] ? " was" : " was not")
+                    << " evicted" << endl;
+            ok = false;
+        }
+    }
+
+    handler->DestroyInstance();
+    return ok;
+}
+
+// Write contents to a new file at path, replacing the file if there is one
+static bool writeFile(const string &path, const string &contents)
+{
+    string temporary = path + ".new";
+    ofstream file(temporary.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(contents.data(), contents.size());
+    file.close();
+    return file && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+// Append text to the file at path
+static bool appendFile(const string &path, const string &text)
+{
+    ofstream file(path.c_str(), ios::out | ios::binary | ios::app);
+    file.write(text.data(), text.size());
+    file.close();
+    return file.good();
+}
+
+/*
+ * The entry of a local file is dropped once the file is edited in place or
+ * replaced, with stat checks and with watched files
+ */
+static bool testLocalFile(const string &contents)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    const string path = "cachetest-local.tmp";
+
+    // Same size, one bit differs
+    string same = contents;
+    same[same.size() / 2] ^= 1;
+
+    bool ok = true;
+    for (int watch = 0; watch < 2; watch++)
+    {
+        handler->setWatchFiles(watch);
+        for (int edit = 0; edit < 2; edit++)
+        {
+            if (!writeFile(path, contents))
+            {
+                cout << "Failed to write " << path << endl;
+                return false;
+            }
+            handler->addCacheObject(path,
+                    fillCacheObject(path.c_str(), contents));
+            if (handler->getCacheObject(path) == NULL)
+            {
+                cout << "Entry of an unchanged file was dropped" << endl;
+                ok = false;
+            }
+
+            bool changed = edit == 0 ? appendFile(path, "<!-- edited -->\n")
+                    : writeFile(path, same);
+            if (!changed)
+            {
+                cout << "Failed to change " << path << endl;
+                return false;
+            }
+            if (handler->getCacheObject(path) != NULL)
+            {
+                cout << "Watch " << watch << ": entry of a file that was "
+                        << (edit == 0 ? "appended to" : "replaced")
+                        << " was kept" << endl;
+                ok = false;
+            }
+        }
+    }
+
+    handler->DestroyInstance();
+    remove(path.c_str());
+    return ok;
+}
+
+// Create a FULL cache entry for url whose response had the given ETag
+static CacheObject *fillResponse(const char *url, const string &contents,
+        const char *etag)
+{
+    CacheObject *co = fillCacheObject(url, contents);
+    if (etag != NULL)
+        co->setEtag(etag);
+    co->setCacheControl("max-age=60");
+    return co;
+}
+
+/*
+ * Raw and tidied copies of a resource are separate entries. A tidied copy
+ * survives a new raw entry with the same ETag and is dropped when the
+ * contents change or can not be compared.
+ */
+static bool testTransforms(const string &contents, const char *file)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    const char *url = "http://localhost/transforms.html";
+    const string tidied = "<html>" + contents + "</html>";
+    bool ok = true;
+
+    handler->addCacheObject(url, fillResponse(url, contents, "\"a\""));
+    handler->addCacheObject(url, fillResponse(url, tidied, NULL),
+            CACHE_TIDIED);
+
+    CacheObject *raw = handler->getCacheObject(url);
+    CacheObject *tidy = handler->getCacheObject(url, CACHE_TIDIED);
+    if (raw == NULL || tidy == NULL || raw == tidy)
+    {
+        cout << "Raw and tidied copies do not have entries of their own"
+                << endl;
+        return false;
+    }
+    if (readCacheObject(raw, 1000) != contents
+            || readCacheObject(tidy, 1000) != tidied)
+    {
+        cout << "Raw or tidied copy holds the wrong contents" << endl;
+        ok = false;
+    }
+    if (tidy->getEtag() == NULL || strcmp(tidy->getEtag(), "\"a\"") != 0
+            || !tidy->isFresh())
+    {
+        cout << "Tidied copy did not take over the raw response" << endl;
+        ok = false;
+    }
+    ok &= checkCounter("entries", handler->getCacheStatistics().entries, 2);
+
+    // The same contents fetched again
+    handler->addCacheObject(url, fillResponse(url, contents, "\"a\""));
+    if (handler->getCacheObject(url, CACHE_TIDIED) != tidy)
+    {
+        cout << "Refetching unchanged contents dropped the tidied copy"
+                << endl;
+        ok = false;
+    }
+
+    // Changed contents
+    handler->addCacheObject(url, fillResponse(url, contents, "\"b\""));
+    if (handler->getCacheObject(url, CACHE_TIDIED) != NULL)
+    {
+        cout << "Tidied copy of changed contents was kept" << endl;
+        ok = false;
+    }
+
+    // Contents without validators can not be compared
+    handler->addCacheObject(url, fillResponse(url, tidied, NULL),
+            CACHE_TIDIED);
+    handler->addCacheObject(url, fillResponse(url, contents, NULL));
+    if (handler->getCacheObject(url, CACHE_TIDIED) != NULL)
+    {
+        cout << "Tidied copy was kept without validators" << endl;
+        ok = false;
+    }
+
+    // Copies of a local file follow the file
+    handler->addCacheObject(file, fillCacheObject(file, contents));
+    handler->addCacheObject(file, fillCacheObject(file, tidied), CACHE_TIDIED);
+    handler->addCacheObject(file, fillCacheObject(file, contents));
+    tidy = handler->getCacheObject(file, CACHE_TIDIED);
+    if (tidy == NULL || readCacheObject(tidy, 1000) != tidied)
+    {
+        cout << "Tidied copy of an unchanged file was dropped" << endl;
+        ok = false;
+    }
+
+    handler->DestroyInstance();
+    return ok;
+}
+
+/*
+ * Queue contents to a CacheWriter in chunks of the given size, the test
+ * keeps its own reference to every chunk until the writer is done
+ */
+static CacheObject *writeInChunks(const char *url, const string &contents,
+        size_t size)
+{
+    CacheObject *co = new CacheObject(url);
+    CacheWriter *writer = new CacheWriter(co);
+    vector<DataChunk *> held;
+    bool ok = true;
+    for (size_t pos = 0; pos < contents.size() && ok; pos += size)
+    {
+        size_t bytes = contents.size() - pos < size ? contents.size() - pos : size;
+        DataChunk *chunk = DataChunk::create(contents.data() + pos, bytes);
+        ok = chunk != NULL && writer->write(chunk);
+        if (chunk != NULL)
+            held.push_back(chunk);
+    }
+    ok = writer->finish() && ok;
+    delete writer;
+    for (size_t i = 0; i < held.size(); i++)
+        held[i]->unref();
+
+    co->writeBytes(NULL, 0);
+    co->setContentLength(contents.size());
+    co->resetState();
+    if (!ok)
+    {
+        co->unref();
+        return NULL;
+    }
+    return co;
+}
+
+/*
+ * Contents written through a CacheWriter in chunks of any size read back
+ * the same, whatever the size of the reads
+ */
+static bool testWriter(const string &contents)
+{
+    const size_t writes[] =
+    { 1, 100, Z_CHUNK_SIZE, Z_CHUNK_SIZE + 1, 100000 };
+    const size_t reads[] =
+    { 1, 4096, 100000 };
+
+    bool ok = true;
+    for (size_t w = 0; w < sizeof(writes) / sizeof(writes[0]); w++)
+    {
+        CacheObject *co = writeInChunks("writer", contents, writes[w]);
+        if (co == NULL)
+        {
+            cout << "Writing chunks of " << writes[w] << " failed" << endl;
+            ok = false;
+            continue;
+        }
+
+        for (size_t r = 0; r < sizeof(reads) / sizeof(reads[0]); r++)
+        {
+            string result = readCacheObject(co, reads[r]);
+            if (result != contents)
+            {
+                cout << "Chunks of " << writes[w] << " read in chunks of "
+                        << reads[r] << " gave " << result.size() << " of "
+                        << contents.size() << " bytes" << endl;
+                ok = false;
+            }
+        }
+        co->unref();
+    }
+    return ok;
+}
+
+// Records element names and text of a parse
+class TraceHandler: public XmlDefaultHandler
+{
+public:
+    string trace;
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        trace += "<";
+        trace += (const char *) localName;
+        trace += ">";
+        return true;
+    }
+
+    bool characters(const xmlChar* const characters, const unsigned int length)
+    {
+        trace.append((const char *) characters, length);
+        return true;
+    }
+};
+
+/*
+ * A document with a byte order mark, cached through a CacheWriter and read
+ * back in small pieces, parses the same when the pieces are fed to the
+ * reader as when the file is parsed, also with the mark split over feeds
+ */
+static bool testBomFeed(const string &contents, const char *file)
+{
+    TraceHandler expected;
+    XmlReader fileReader;
+    fileReader.setContentHandler(&expected);
+    if (!fileReader.parseXml(file) || expected.trace.empty())
+    {
+        cout << "Failed to parse " << file << endl;
+        return false;
+    }
+
+    CacheObject *co = writeInChunks(file, contents, 7);
+    if (co == NULL)
+    {
+        cout << "Failed to cache " << file << endl;
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t size = 1; size <= 4; size++)
+    {
+        TraceHandler handler;
+        XmlReader reader;
+        bool parsed = reader.begin(&handler);
+
+        vector<char> buffer(size);
+        CacheReader cacheReader(co);
+        int bytes;
+        while (parsed && (bytes = cacheReader.readBytes(&buffer[0], size)) > 0)
+            parsed = reader.feed(&buffer[0], bytes);
+        parsed = reader.finish() && parsed;
+
+        if (!parsed || handler.trace != expected.trace)
+        {
+            cout << "Fed in pieces of " << size << ": " << handler.trace
+                    << endl;
+            ok = false;
+        }
+    }
+
+    co->unref();
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    setup_logging();
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <test> <file> [file]" << endl;
+        return 1;
+    }
+
+    string test = argv[1];
+    string contents;
+    if (!readFile(argv[2], contents))
+    {
+        cout << "Can not read " << argv[2] << endl;
+        return 1;
+    }
+
+    bool ok = false;
+    if (test == "readers")
+        ok = testReaders(contents);
+    else if (test == "budget" && argc > 3)
+        ok = testBudget(contents, argv[2], argv[3]);
+    else if (test == "lru")
+        ok = testLru(contents);
+    else if (test == "localfile")
+        ok = testLocalFile(contents);
+    else if (test == "bomfeed")
+        ok = testBomFeed(contents, argv[2]);
+    else if (test == "transforms")
+        ok = testTransforms(contents, argv[2]);
+    else if (test == "writer")
+        ok = testWriter(contents);
+    else
+        cout << "Unknown test " << test << endl;
+
+    cout << "Test " << test << (ok ? " passed" : " FAILED") << endl;
+    return ok ? 0 : 1;
+}
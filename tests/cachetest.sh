@@ -0,0 +1,16 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./cachetest readers ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./cachetest budget ${srcdir:-.}/testdata/sample3.xml ${srcdir:-.}/testdata/sample2.xml
+$PREFIX ./cachetest lru ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./cachetest localfile ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./cachetest transforms ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./cachetest writer ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./cachetest bomfeed ${srcdir:-.}/testdata/utf8-bom.xml
+$PREFIX ./cachetest bomfeed ${srcdir:-.}/testdata/utf16-bom.xml
@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "DataStreamHandler.h"
+#include "InputStream.h"
+#include "XmlReader.h"
+#include "XmlDefaultHandler.h"
+#include "XmlError.h"
+#include "testserver.h"
+#include "setup_logging.h"
+
+using namespace std;
+
+// Read the whole resource at url
+static bool readUrl(const string &url, string &result)
+{
+    InputStream *stream = NULL;
+    try
+    {
+        stream = DataStreamHandler::Instance()->newStream(url);
+        if (stream == NULL)
+            return false;
+
+        char buffer[4096];
+        int bytes;
+        result.clear();
+        while ((bytes = stream->readBytes(buffer, sizeof(buffer))) > 0)
+            result.append(buffer, bytes);
+        delete stream;
+        return bytes == 0;
+    } catch (XmlError &e)
+    {
+        delete stream;
+        return false;
+    }
+}
+
+// A document large enough to be delivered in several blocks
+static string makeDocument(char fill)
+{
+    string document = "<?xml version=\"1.0\"?>\n<doc>";
+    document.append(200000, fill);
+    document += "</doc>\n";
+    return document;
+}
+
+/*
+ * Resume scenarios, the first response always breaks off halfway
+ */
+enum ResumeAnswer
+{
+    RESUME_PARTIAL, // 206 with a Content-Range
+    RESUME_NO_RANGE, // 206 without a Content-Range
+    RESUME_CHANGED // 200 with another body and no validators
+};
+
+struct ResumeScript
+{
+    ResumeAnswer answer;
+    string document;
+    size_t half;
+};
+
+static string resumeResponder(const string &request, int index, void *data)
+{
+    ResumeScript *script = static_cast<ResumeScript *>(data);
+    const string &document = script->document;
+
+    if (index == 0)
+        return httpResponse(200, "ETag: \"v1\"\r\n",
+                document.substr(0, script->half), document.size());
+
+    if (requestHeader(request, "Range").empty())
+        return httpResponse(304, "ETag: \"v1\"\r\n", "", 0);
+
+    char range[128];
+    snprintf(range, sizeof(range), "Content-Range: bytes %lu-%lu/%lu\r\n",
+            (unsigned long) script->half, (unsigned long) document.size() - 1,
+            (unsigned long) document.size());
+    string rest = document.substr(script->half);
+
+    switch (script->answer)
+    {
+    case RESUME_PARTIAL:
+        return httpResponse(206, "ETag: \"v1\"\r\n" + string(range), rest,
+                rest.size());
+    case RESUME_NO_RANGE:
+        return httpResponse(206, "ETag: \"v1\"\r\n", rest, rest.size());
+    default:
+        string other = makeDocument('y');
+        return httpResponse(200, "", other, other.size());
+    }
+}
+
+/*
+ * A broken transfer continues from the last byte with Range and If-Range.
+ * It fails rather than mixing two versions of the document when the server
+ * answers with another entity or with a partial response it does not
+ * describe. The handle that made the ranged request is reused without the
+ * range headers.
+ */
+static bool testResume()
+{
+    bool ok = true;
+    ResumeAnswer answers[] =
+    { RESUME_PARTIAL, RESUME_NO_RANGE, RESUME_CHANGED };
+
+    for (int i = 0; i < 3; i++)
+    {
+        ResumeScript script;
+        script.answer = answers[i];
+        script.document = makeDocument('x');
+        script.half = script.document.size() / 2;
+
+        TestServer server(resumeResponder, &script);
+        if (!server.running())
+        {
+            cout << "Failed to start the server" << endl;
+            return false;
+        }
+        const string url = server.url("/resume.xml");
+
+        string result;
+        bool read = readUrl(url, result);
+        vector<string> requests = server.requests();
+
+        if (requests.size() < 2)
+        {
+            cout << "Answer " << i << ": the transfer was not resumed" << endl;
+            ok = false;
+            continue;
+        }
+
+        char range[32];
+        snprintf(range, sizeof(range), "bytes=%lu-",
+                (unsigned long) script.half);
+        if (requestHeader(requests[1], "Range") != range
+                || requestHeader(requests[1], "If-Range") != "\"v1\"")
+        {
+            cout << "Answer " << i << ": resumed with " << requests[1] << endl;
+            ok = false;
+        }
+
+        if (script.answer != RESUME_PARTIAL)
+        {
+            if (read)
+            {
+                cout << "Answer " << i << ": mixed document was accepted"
+                        << endl;
+                ok = false;
+            }
+            continue;
+        }
+
+        if (!read || result != script.document)
+        {
+            cout << "Resumed document differs, got " << result.size()
+                    << " of " << script.document.size() << " bytes" << endl;
+            ok = false;
+        }
+
+        // The cache holds the whole document, served after a 304 on a
+        // request that no longer carries the range
+        if (!readUrl(url, result) || result != script.document)
+        {
+            cout << "Cached copy of the resumed document differs" << endl;
+            ok = false;
+        }
+        requests = server.requests();
+        if (requests.size() != 3 || !requestHeader(requests[2], "Range").empty()
+                || !requestHeader(requests[2], "If-Range").empty())
+        {
+            cout << "Range headers leaked into the next request" << endl;
+            ok = false;
+        }
+    }
+
+    DataStreamHandler::Instance()->DestroyInstance();
+    return ok;
+}
+
+/*
+ * Freshness scenarios, the server gives the scripted responses in turn and
+ * repeats the last one
+ */
+struct FreshnessScript
+{
+    FreshnessScript() :
+            name(""), staleWhileRevalidate(false)
+    {
+    }
+
+    const char *name;
+    bool staleWhileRevalidate;
+    vector<string> responses;
+};
+
+static string scriptResponder(const string &request, int index, void *data)
+{
+    vector<string> &responses = static_cast<FreshnessScript *>(data)->responses;
+    return responses[(size_t) index < responses.size() ? index
+            : responses.size() - 1];
+}
+
+static string okResponse(const string &headers, const string &body)
+{
+    return httpResponse(200, headers, body, body.size());
+}
+
+// Read url until it gives the expected contents or a few seconds passed,
+// for changes made by background revalidations
+static bool waitForContents(const string &url, const string &expected,
+        string &result)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        if (readUrl(url, result) && result == expected)
+            return true;
+        usleep(50000);
+    }
+    return false;
+}
+
+/*
+ * Fresh entries are served without a request, entries that must be
+ * revalidated never are, and the Cache-Control of a 304 refreshes the
+ * entry. In stale-while-revalidate mode the stale copy is served while a
+ * background request replaces it, or drops it when the new response may
+ * not be stored. Each case runs with read-ahead off and on.
+ */
+static bool testFreshness()
+{
+    const string v1 = "<doc>1</doc>", v2 = "<doc>2</doc>", v3 = "<doc>3</doc>";
+    vector<FreshnessScript> scripts(5);
+
+    scripts[0].name = "max-age";
+    scripts[0].responses.push_back(
+            okResponse("ETag: \"a\"\r\nCache-Control: max-age=60\r\n", v1));
+
+    scripts[1].name = "must-revalidate";
+    scripts[1].staleWhileRevalidate = true;
+    scripts[1].responses.push_back(
+            okResponse("ETag: \"a\"\r\n"
+                    "Cache-Control: max-age=60, must-revalidate\r\n", v1));
+    scripts[1].responses.push_back(httpResponse(304, "ETag: \"a\"\r\n", "", 0));
+
+    scripts[2].name = "304 max-age";
+    scripts[2].responses.push_back(
+            okResponse("ETag: \"a\"\r\nCache-Control: max-age=0\r\n", v1));
+    scripts[2].responses.push_back(
+            httpResponse(304, "Cache-Control: max-age=60\r\n", "", 0));
+
+    scripts[3].name = "stale-while-revalidate";
+    scripts[3].staleWhileRevalidate = true;
+    scripts[3].responses.push_back(okResponse("ETag: \"a\"\r\n", v1));
+    scripts[3].responses.push_back(okResponse("ETag: \"b\"\r\n", v2));
+
+    scripts[4].name = "no-store";
+    scripts[4].staleWhileRevalidate = true;
+    scripts[4].responses.push_back(okResponse("ETag: \"a\"\r\n", v1));
+    scripts[4].responses.push_back(
+            okResponse("ETag: \"b\"\r\nCache-Control: no-store\r\n", v2));
+    scripts[4].responses.push_back(okResponse("ETag: \"c\"\r\n", v3));
+
+    bool ok = true;
+    for (int readAhead = 0; readAhead < 2; readAhead++)
+    {
+        for (size_t i = 0; i < scripts.size(); i++)
+        {
+            FreshnessScript &script = scripts[i];
+
+            DataStreamHandler *handler = DataStreamHandler::Instance();
+            handler->setReadAhead(readAhead);
+            handler->setStaleWhileRevalidate(script.staleWhileRevalidate);
+
+            TestServer server(scriptResponder, &script);
+            const string url = server.url("/fresh.xml");
+            string first, second, third;
+            bool read = readUrl(url, first) && readUrl(url, second);
+            vector<string> requests = server.requests();
+
+            string failure;
+            if (!read || first != v1 || second != v1)
+                failure = "served " + first + " and " + second;
+            else if (i == 0 && requests.size() != 1)
+                failure = "fresh entry was revalidated";
+            else if (i == 1 && (requests.size() != 2
+                    || requestHeader(requests[1], "If-None-Match") != "\"a\""))
+                failure = "entry was not revalidated before use";
+            else if (i == 2 && (!readUrl(url, third) || third != v1
+                    || server.requests().size() != 2))
+                failure = "304 did not make the entry fresh";
+            else if (i == 3 && !waitForContents(url, v2, third))
+                failure = "revalidated entry was not replaced, got " + third;
+            else if (i == 4)
+            {
+                if (!waitForContents(url, v3, third))
+                    failure = "entry was not dropped, got " + third;
+                else if (!requestHeader(server.requests()[2],
+                        "If-None-Match").empty())
+                    failure = "entry was revalidated after a no-store response";
+            }
+
+            if (!failure.empty())
+            {
+                cout << script.name << (readAhead ? " with read-ahead" : "")
+                        << ": " << failure << endl;
+                ok = false;
+            }
+        }
+    }
+
+    DataStreamHandler::Instance()->DestroyInstance();
+    return ok;
+}
+
+// Collects the text of a document
+class TextHandler: public XmlDefaultHandler
+{
+public:
+    string text;
+
+    bool characters(const xmlChar* const characters, const unsigned int length)
+    {
+        text.append((const char *) characters, length);
+        return true;
+    }
+};
+
+// The first version is fresh for two seconds, the second one for a minute
+static string verdictResponder(const string &request, int index, void *data)
+{
+    vector<string> &responses = *static_cast<vector<string> *>(data);
+    string etag = requestHeader(request, "If-None-Match");
+    if (etag == "\"b\"")
+        return httpResponse(304, "ETag: \"b\"\r\n", "", 0);
+    return responses[etag == "\"a\"" ? 1 : 0];
+}
+
+/*
+ * The HTML verdict of a stale document is not trusted. The preparse
+ * revalidates the document and records the verdict of the new version,
+ * which is downloaded once. While the entry is fresh, parsing the document
+ * again makes no request at all.
+ */
+static bool testVerdict()
+{
+    const string v1 = "<html><body><p>one</p></body></html>";
+    const string v2 = "<html><body><p>two</p></body></html>";
+    vector<string> responses;
+    responses.push_back(
+            okResponse("ETag: \"a\"\r\nCache-Control: max-age=2\r\n", v1));
+    responses.push_back(
+            okResponse("ETag: \"b\"\r\nCache-Control: max-age=60\r\n", v2));
+
+    TestServer server(verdictResponder, &responses);
+    const string url = server.url("/verdict.html");
+
+    const char *expected[] =
+    { "one", "two", "two" };
+    const size_t requests[] =
+    { 1, 2, 2 };
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+    {
+        if (i == 1)
+            sleep(3);
+
+        TextHandler handler;
+        XmlReader reader;
+        reader.setContentHandler(&handler);
+        if (!reader.parseHtml(url.c_str()) || handler.text != expected[i])
+        {
+            cout << "Parse " << i << " gave '" << handler.text << "'" << endl;
+            ok = false;
+        }
+        if (server.requests().size() != requests[i])
+        {
+            cout << "Parse " << i << " made " << server.requests().size()
+                    << " requests in all, expected " << requests[i] << endl;
+            ok = false;
+        }
+    }
+
+    // Each version went over the wire once
+    unsigned long bytes = responses[0].size() + responses[1].size();
+    if (server.bytesSent() != bytes)
+    {
+        cout << "Server sent " << server.bytesSent() << " bytes, expected "
+                << bytes << endl;
+        ok = false;
+    }
+
+    DataStreamHandler::Instance()->DestroyInstance();
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    setup_logging();
+    if (argc < 2)
+    {
+        cout << "Usage: " << argv[0] << " <test>" << endl;
+        return 1;
+    }
+
+    string test = argv[1];
+
+    bool ok = false;
+    if (test == "freshness")
+        ok = testFreshness();
+    else if (test == "resume")
+        ok = testResume();
+    else if (test == "verdict")
+        ok = testVerdict();
+    else
+        cout << "Unknown test " << test << endl;
+
+    cout << "Test " << test << (ok ? " passed" : " FAILED") << endl;
+    return ok ? 0 : 1;
+}
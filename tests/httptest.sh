@@ -0,0 +1,11 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./httptest freshness
+$PREFIX ./httptest resume
+$PREFIX ./httptest verdict
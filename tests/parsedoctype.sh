@@ -1,5 +1,7 @@
 #!/bin/sh
 
+set -e
+
 if [ -x /usr/bin/gdb ]; then
     PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
 fi
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+#include <utime.h>
+
+#include "XmlReader.h"
+#include "XmlAttributes.h"
+#include "XmlDefaultHandler.h"
+#include "XmlError.h"
+#include "setup_logging.h"
+
+using namespace std;
+
+// Record the reported events as a string
+class EventRecorder: public XmlDefaultHandler
+{
+public:
+    bool startDocument()
+    {
+        events += "[";
+        return true;
+    }
+
+    bool endDocument()
+    {
+        events += "]";
+        return true;
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        events += "<";
+        events += (const char *) qName;
+        events += "{";
+        if (namespaceURI != NULL)
+            events += (const char *) namespaceURI;
+        events += "}";
+        for (int i = 0; i < attributes.length(); i++)
+        {
+            events += " ";
+            events += (const char *) attributes.qName(i);
+        }
+        events += ">";
+        return true;
+    }
+
+    bool endElement(const xmlChar* const, const xmlChar* const,
+            const xmlChar* const qName)
+    {
+        events += "</";
+        events += (const char *) qName;
+        events += ">";
+        return true;
+    }
+
+    bool characters(const xmlChar* const characters,
+            const unsigned int length)
+    {
+        events.append((const char *) characters, length);
+        return true;
+    }
+
+    string events;
+};
+
+// Read a whole file
+static bool readFile(const string &path, string &contents)
+{
+    ifstream in(path.c_str(), ios::binary);
+    ostringstream out;
+    out << in.rdbuf();
+    contents = out.str();
+    return in.good() || in.eof();
+}
+
+// Write contents to path and give it the modification time of like, so
+// that the change goes unnoticed by the element index
+static bool writeUnnoticed(const string &path, const string &contents,
+        const string &like)
+{
+    struct stat st;
+    if (stat(like.c_str(), &st) != 0)
+        return false;
+    {
+        ofstream out(path.c_str(), ios::binary | ios::trunc);
+        out << contents;
+        if (!out.good())
+            return false;
+    }
+    struct utimbuf times;
+    times.actime = st.st_atime;
+    times.modtime = st.st_mtime;
+    return utime(path.c_str(), &times) == 0;
+}
+
+/*
+ * The document changes after it was indexed, without a change of size or
+ * modification time. The newline before the element's line moves to the
+ * end, so the indexed offset is one byte off. The reader falls back to
+ * searching the document and reports its start and end only once.
+ */
+static bool testStaleIndex(const string &filename, const string &id,
+        const string &expected)
+{
+    string contents;
+    size_t at;
+    if (!readFile(filename, contents)
+            || (at = contents.find("id=\"" + id + "\"")) == string::npos
+            || (at = contents.rfind('\n', at)) == string::npos)
+    {
+        cout << "No line with '" << id << "' in " << filename << endl;
+        return false;
+    }
+
+    const string path = "parsefragment-stale.xml";
+    string changed = contents;
+    changed.erase(at, 1);
+    changed += "\n";
+
+    XmlReader reader;
+    reader.buildElementIndex(true);
+    bool ok = writeUnnoticed(path, contents, filename)
+            && reader.parseXml(path.c_str())
+            && writeUnnoticed(path, changed, filename);
+    if (!ok)
+    {
+        cout << "Failed to index " << path << endl;
+        remove(path.c_str());
+        return false;
+    }
+
+    EventRecorder stale;
+    reader.setContentHandler(&stale);
+    ok = reader.parseFragment(path.c_str(), id.c_str());
+    remove(path.c_str());
+
+    if (!ok || stale.events != expected)
+    {
+        cout << "Fragment with a stale index differs: " << stale.events << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    setup_logging();
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <file> <id> [fail|stale]" << endl;
+        exit(1);
+    }
+
+    bool expectFailure = (argc > 3 && string(argv[3]) == "fail");
+    bool staleIndex = (argc > 3 && string(argv[3]) == "stale");
+
+    LOG4CXX_INFO(logger,
+            "Start test for '" << argv[2] << "' in file '" << argv[1] << "'");
+
+    // Search the document from the top
+    EventRecorder searched;
+    XmlReader searchReader;
+    searchReader.setContentHandler(&searched);
+    bool searchResult = searchReader.parseFragment(argv[1], argv[2]);
+
+    // Index the document, then seek to the element
+    EventRecorder seeked;
+    XmlReader seekReader;
+    seekReader.buildElementIndex(true);
+    if (!seekReader.parseXml(argv[1]))
+    {
+        cout << "Failed to index " << argv[1] << endl;
+        exit(1);
+    }
+    seekReader.setContentHandler(&seeked);
+    bool seekResult = seekReader.parseFragment(argv[1], argv[2]);
+
+    if (expectFailure)
+    {
+        if (searchResult || seekResult)
+        {
+            cout << "Found '" << argv[2] << "' which should not exist" << endl;
+            exit(1);
+        }
+        cout << "Fragment not found as expected" << endl;
+        return 0;
+    }
+
+    if (!searchResult || !seekResult)
+    {
+        const XmlError *e = searchResult ? seekReader.getLastError()
+                : searchReader.getLastError();
+        cout << "Failed to parse fragment: "
+                << (e != NULL ? e->getMessage() : "unknown") << endl;
+        exit(1);
+    }
+
+    cout << seeked.events << endl;
+
+    if (searched.events.empty() || searched.events != seeked.events)
+    {
+        cout << "Searched fragment differs: " << searched.events << endl;
+        exit(1);
+    }
+
+    if (staleIndex && !testStaleIndex(argv[1], argv[2], searched.events))
+        exit(1);
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml a
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml p1
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml deep
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml xid
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml missing fail
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml p1 stale
+$PREFIX ./parsefragment ${srcdir:-.}/testdata/fragment.xml deep stale
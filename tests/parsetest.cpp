@@ -26,6 +26,7 @@
 #include "XmlDefaultHandler.h"
 #include "XmlAttributes.h"
 #include "XmlError.h"
+#include "XmlStringView.h"
 #include "setup_logging.h"
 
 using namespace std;
@@ -132,8 +133,7 @@ bool SaxTest::startElement(const xmlChar* const namespaceURI,
         const XmlAttributes &attributes)
 {
 
-    const char* element_name = NULL;
-    element_name = XmlReader::transcode(localname);
+    XmlStringView element_name(localname);
 
     if (m_level != 0) cout << endl;
     for (int i = 0; i < m_level; i++)
@@ -153,8 +153,7 @@ bool SaxTest::startElement(const xmlChar* const namespaceURI,
 bool SaxTest::endElement(const xmlChar* const namespaceURI,
         const xmlChar* const localName, const xmlChar* const qName)
 {
-    const char* element_name = NULL;
-    element_name = XmlReader::transcode(localName);
+    XmlStringView element_name(localName);
     m_level--;
     cout << ")";
     //cout << "</" << element_name << ">";
@@ -165,11 +164,8 @@ bool SaxTest::endElement(const xmlChar* const namespaceURI,
 bool SaxTest::characters(const xmlChar* const characters,
         const unsigned int length)
 {
-    const char *tmpchars = XmlReader::transcode(characters);
-    static string mTempChars;
-    mTempChars.clear();
-    mTempChars.append(tmpchars, length);
-    for (unsigned int i = 0; i < length; i++)
+    XmlStringView text(characters, length);
+    for (size_t i = 0; i < text.length(); i++)
         cout << ".";
     m_charcount += length;
 
@@ -1,5 +1,7 @@
 #!/bin/sh
 
+set -e
+
 if [ -x /usr/bin/gdb ]; then
     PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
 fi
@@ -8,9 +10,14 @@ fi
 $PREFIX ./parsetest ${srcdir:-.}/testdata/ncc.html
 $PREFIX ./parsetest ${srcdir:-.}/testdata/nstest.xml
 $PREFIX ./parsetest ${srcdir:-.}/testdata/sample.xml
+$PREFIX ./parsetest ${srcdir:-.}/testdata/sample.xml.gz
+$PREFIX ./parsetest ${srcdir:-.}/testdata/sample.epub#OEBPS/sample.xml
+$PREFIX ./parsetest zip:${srcdir:-.}/testdata/sample.epub#OEBPS/nstest.xml
 $PREFIX ./parsetest ${srcdir:-.}/testdata/sample2.xml
 $PREFIX ./parsetest ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./parsetest ${srcdir:-.}/testdata/entities.xml
 $PREFIX ./parsetest ${srcdir:-.}/testdata/sample2_errors.xml fail
+$PREFIX ./parsetest ${srcdir:-.}/testdata/utf8-invalid.xml fail
 
 # online resources
 $PREFIX ./parsetest http://www.w3schools.com/xml/note.xml
@@ -18,6 +18,7 @@
  */
 
 #include <iostream>
+#include <fstream>
 
 #include "XmlReader.h"
 #include "setup_logging.h"
@@ -54,6 +55,18 @@ int main(int argc, char* argv[])
             std::cout << "XmlReader failed to parse " << argv[1] << std::endl;
             exit(1);
         }
+
+        // Feed the file one byte at a time, splitting the BOM
+        std::ifstream file(argv[1], std::ios::binary);
+        bool fed = xmlReader.begin();
+        char c;
+        while (fed && file.get(c))
+            fed = xmlReader.feed(&c, 1);
+        if (!fed || !xmlReader.finish())
+        {
+            std::cout << "XmlReader failed to parse fed " << argv[1] << std::endl;
+            exit(1);
+        }
     }
 
     return 0;
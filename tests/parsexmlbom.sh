@@ -1,5 +1,7 @@
 #!/bin/sh
 
+set -e
+
 if [ -x /usr/bin/gdb ]; then
     PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
 fi
@@ -8,3 +10,4 @@ $PREFIX ./parsexmlbom ${srcdir:-.}/testdata/utf8-bom.html
 $PREFIX ./parsexmlbom ${srcdir:-.}/testdata/utf8-no-bom.html
 $PREFIX ./parsexmlbom ${srcdir:-.}/testdata/utf8-bom.xml
 $PREFIX ./parsexmlbom ${srcdir:-.}/testdata/utf8-no-bom.xml
+$PREFIX ./parsexmlbom ${srcdir:-.}/testdata/utf16-bom.xml
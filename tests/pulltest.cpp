@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "XmlReader.h"
+#include "XmlDefaultHandler.h"
+#include "XmlPullReader.h"
+#include "XmlError.h"
+#include "setup_logging.h"
+
+using namespace std;
+
+// Count the elements reported through the SAX interface
+class ElementCounter: public XmlDefaultHandler
+{
+public:
+    ElementCounter() :
+            count(0)
+    {
+    }
+
+    bool startElement(const xmlChar* const, const xmlChar* const,
+            const xmlChar* const, const XmlAttributes &)
+    {
+        count++;
+        return true;
+    }
+
+    long count;
+};
+
+int main(int argc, char* argv[])
+{
+    setup_logging();
+    if (argc < 2)
+    {
+        cout << "Usage: " << argv[0] << " <file> [fail]" << endl;
+        exit(1);
+    }
+
+    bool expectFailure = (argc > 2 && string(argv[2]) == "fail");
+
+    LOG4CXX_INFO(logger, "Start test for file '" << argv[1] << "'");
+
+    XmlPullReader pullReader;
+    if (!pullReader.open(argv[1]))
+    {
+        cout << "XmlPullReader failed to open " << argv[1] << endl;
+        exit(1);
+    }
+
+    // Walk the whole document and check that tags and depths match up
+    long elements = 0;
+    int depth = 0;
+    XmlPullReader::NodeType type;
+    while ((type = pullReader.next()) != XmlPullReader::END_DOCUMENT)
+    {
+        if (type == XmlPullReader::NONE)
+            break;
+        if (type == XmlPullReader::START_ELEMENT)
+        {
+            if (pullReader.depth() != depth || pullReader.localName() == NULL)
+            {
+                cout << "Unexpected start tag at depth " << depth << endl;
+                exit(1);
+            }
+            for (int i = 0; i < pullReader.attributeCount(); i++)
+            {
+                if (pullReader.attributeQName(i) == NULL
+                        || pullReader.attributeValue(i) == NULL)
+                {
+                    cout << "Attribute " << i << " is missing" << endl;
+                    exit(1);
+                }
+            }
+            elements++;
+            depth++;
+        }
+        else if (type == XmlPullReader::END_ELEMENT)
+        {
+            depth--;
+            if (pullReader.depth() != depth)
+            {
+                cout << "Unexpected end tag at depth " << depth << endl;
+                exit(1);
+            }
+        }
+    }
+
+    if (expectFailure)
+    {
+        if (type != XmlPullReader::NONE || pullReader.getLastError() == NULL)
+        {
+            cout << "Expected " << argv[1] << " to fail" << endl;
+            exit(1);
+        }
+        cout << "Failed as expected: " << pullReader.getLastError()->getMessage()
+                << endl;
+        return 0;
+    }
+
+    if (type != XmlPullReader::END_DOCUMENT || depth != 0)
+    {
+        cout << "XmlPullReader failed to read " << argv[1] << endl;
+        exit(1);
+    }
+
+    // The cursor must see the same elements as the SAX parser
+    ElementCounter counter;
+    XmlReader xmlReader;
+    xmlReader.setContentHandler(&counter);
+    if (!xmlReader.parseXml(argv[1]) || counter.count != elements)
+    {
+        cout << "Counted " << elements << " elements, XmlReader saw "
+                << counter.count << endl;
+        exit(1);
+    }
+
+    // Skipping the root element leaves nothing but the end of the document
+    pullReader.open(argv[1]);
+    while ((type = pullReader.next()) != XmlPullReader::START_ELEMENT)
+    {
+        if (type == XmlPullReader::END_DOCUMENT || type == XmlPullReader::NONE)
+        {
+            cout << "No root element in " << argv[1] << endl;
+            exit(1);
+        }
+    }
+    if (!pullReader.skipSubtree())
+    {
+        cout << "Failed to skip the root element" << endl;
+        exit(1);
+    }
+    while ((type = pullReader.next()) != XmlPullReader::END_DOCUMENT)
+    {
+        if (type == XmlPullReader::START_ELEMENT
+                || type == XmlPullReader::END_ELEMENT
+                || type == XmlPullReader::NONE)
+        {
+            cout << "Unexpected node after the root element" << endl;
+            exit(1);
+        }
+    }
+
+    cout << "Read " << elements << " elements from " << argv[1] << endl;
+    return 0;
+}
@@ -0,0 +1,14 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./pulltest ${srcdir:-.}/testdata/nstest.xml
+$PREFIX ./pulltest ${srcdir:-.}/testdata/sample.xml
+$PREFIX ./pulltest ${srcdir:-.}/testdata/sample2.xml
+$PREFIX ./pulltest ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./pulltest ${srcdir:-.}/testdata/utf8-bom.xml
+$PREFIX ./pulltest ${srcdir:-.}/testdata/sample2_errors.xml fail
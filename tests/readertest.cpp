@@ -0,0 +1,939 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/resource.h>
+
+#include "XmlReader.h"
+#include "XmlDefaultHandler.h"
+#include "XmlAttributes.h"
+#include "XmlError.h"
+#include "DataStreamHandler.h"
+#include "setup_logging.h"
+
+#define ROUNDS 3
+
+using namespace std;
+
+// Records the events of a parse as one string
+class TraceHandler: public XmlDefaultHandler
+{
+public:
+    string trace;
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        trace += "<";
+        trace += (const char *) localName;
+        trace += ">";
+        return true;
+    }
+
+    bool endElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName)
+    {
+        trace += "</";
+        trace += (const char *) localName;
+        trace += ">";
+        return true;
+    }
+
+    bool characters(const xmlChar* const characters, const unsigned int length)
+    {
+        trace.append((const char *) characters, length);
+        return true;
+    }
+};
+
+// Records the events of a parse along with the warnings
+class WarningTraceHandler: public TraceHandler
+{
+public:
+    vector<int> warningLines;
+
+    bool warning(const XmlError &e)
+    {
+        warningLines.push_back(e.lineNumber());
+        return true;
+    }
+};
+
+// Skips the children of elements named skipName and stops the parse at
+// the first element named stopName
+class SkipStopHandler: public TraceHandler
+{
+public:
+    XmlReader *reader;
+    string skipName;
+    string stopName;
+    int depth;
+
+    SkipStopHandler(XmlReader *r, const char *skip, const char *stop) :
+            reader(r), skipName(skip), stopName(stop), depth(0)
+    {
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        TraceHandler::startElement(namespaceURI, localName, qName, attributes);
+        depth++;
+        if (skipName == (const char *) localName)
+            reader->skipSubtree();
+        return stopName != (const char *) localName;
+    }
+
+    bool endElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName)
+    {
+        depth--;
+        return TraceHandler::endElement(namespaceURI, localName, qName);
+    }
+
+    bool processingInstruction(const xmlChar* const target,
+            const xmlChar* const data)
+    {
+        trace += "<?";
+        trace += (const char *) target;
+        trace += "?>";
+        return true;
+    }
+};
+
+// Counts text that reaches the handler in more than one characters() call
+class CoalesceHandler: public TraceHandler
+{
+public:
+    int calls;
+    int splits;
+    bool unterminated;
+    bool lastWasText;
+
+    CoalesceHandler() :
+            calls(0), splits(0), unterminated(false), lastWasText(false)
+    {
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        lastWasText = false;
+        return TraceHandler::startElement(namespaceURI, localName, qName,
+                attributes);
+    }
+
+    bool endElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName)
+    {
+        lastWasText = false;
+        return TraceHandler::endElement(namespaceURI, localName, qName);
+    }
+
+    bool characters(const xmlChar* const characters, const unsigned int length)
+    {
+        calls++;
+        if (lastWasText)
+            splits++;
+        if (characters[length] != '\0')
+            unterminated = true;
+        lastWasText = true;
+        return TraceHandler::characters(characters, length);
+    }
+};
+
+// Records qualified and local attribute names as "qName=localName "
+class AttributeHandler: public XmlDefaultHandler
+{
+public:
+    string names;
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        for (int i = 0; i < attributes.length(); i++)
+        {
+            names += (const char *) attributes.qName(i);
+            names += "=";
+            names += (const char *) attributes.localName(i);
+            names += " ";
+        }
+        return true;
+    }
+};
+
+// Records the namespace of each element, and counts the c elements whose
+// namespace is not the one named by their k attribute
+class NamespaceHandler: public XmlDefaultHandler
+{
+public:
+    string trace;
+    int elements;
+    int mismatches;
+
+    NamespaceHandler() :
+            elements(0), mismatches(0)
+    {
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        string uri = namespaceURI ? (const char *) namespaceURI : "";
+        const xmlChar *k = attributes.value(BAD_CAST "k");
+        if (xmlStrcmp(localName, BAD_CAST "c") != 0 || k == NULL)
+        {
+            trace += string("<") + (const char *) localName + " " + uri + ">";
+            return true;
+        }
+
+        elements++;
+        if (uri != namespaceUri(atoi((const char *) k)))
+            mismatches++;
+        return true;
+    }
+
+    // Namespace uris of different lengths, too long to fit many in a block
+    static string namespaceUri(int k)
+    {
+        char prefix[16];
+        snprintf(prefix, sizeof(prefix), "urn:%d:", k);
+        return prefix + string(4000 + 100 * k, 'x');
+    }
+};
+
+// Element handler that writes its calls to a shared log
+class LogElementHandler: public XmlElementHandler
+{
+public:
+    string &log;
+    string tag;
+
+    LogElementHandler(string &l, const char *t) :
+            log(l), tag(t)
+    {
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const XmlAttributes &attributes)
+    {
+        log += tag + "<" + (const char *) localName + " "
+                + (namespaceURI ? (const char *) namespaceURI : "") + ">";
+        return true;
+    }
+
+    bool endElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName)
+    {
+        log += tag + "</" + (const char *) localName + ">";
+        return true;
+    }
+};
+
+// Lexical handler that writes comments and CDATA sections to a shared log
+class LogLexicalHandler: public XmlDefaultHandler
+{
+public:
+    string &log;
+
+    LogLexicalHandler(string &l) :
+            log(l)
+    {
+    }
+
+    bool startCDATA()
+    {
+        log += "L<![CDATA[";
+        return true;
+    }
+
+    bool endCDATA()
+    {
+        log += "L]]>";
+        return true;
+    }
+
+    bool comment(const xmlChar* const characters)
+    {
+        log += string("L<!--") + (const char *) characters + "-->";
+        return true;
+    }
+};
+
+// Content handler that writes start tags to a shared log
+class LogContentHandler: public XmlDefaultHandler
+{
+public:
+    string &log;
+
+    LogContentHandler(string &l) :
+            log(l)
+    {
+    }
+
+    bool startElement(const xmlChar* const namespaceURI,
+            const xmlChar* const localName, const xmlChar* const qName,
+            const XmlAttributes &attributes)
+    {
+        log += string("C<") + (const char *) localName + ">";
+        return true;
+    }
+};
+
+// Read the whole file into contents
+static bool readFile(const string &filename, string &contents)
+{
+    ifstream file(filename.c_str(), ios::in | ios::binary);
+    if (!file)
+        return false;
+    contents.assign((istreambuf_iterator<char>(file)),
+            istreambuf_iterator<char>());
+    return true;
+}
+
+static bool isHtml(const string &filename)
+{
+    return filename.substr(filename.find_last_of(".") + 1) == "html";
+}
+
+// Parse filename with reader and return the trace in result
+static bool parseTrace(XmlReader &reader, const string &filename,
+        string &result)
+{
+    TraceHandler handler;
+    reader.setContentHandler(&handler);
+
+    bool ret = isHtml(filename) ? reader.parseHtml(filename.c_str())
+            : reader.parseXml(filename.c_str());
+    reader.setContentHandler(NULL);
+    if (!ret)
+    {
+        const XmlError *e = reader.getLastError();
+        cout << "Failed to parse " << filename << ": "
+                << (e ? e->message() : "unknown error") << endl;
+        return false;
+    }
+
+    result = handler.trace;
+    return true;
+}
+
+// One reader parses the files over and over, each parse must match the
+// parse of a new reader
+static bool testReuse(const vector<string> &files)
+{
+    vector<string> expected(files.size());
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        XmlReader reader;
+        if (!parseTrace(reader, files[i], expected[i]))
+            return false;
+        if (expected[i].empty())
+        {
+            cout << "No events from " << files[i] << endl;
+            return false;
+        }
+    }
+
+    XmlReader reader;
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            string trace;
+            if (!parseTrace(reader, files[i], trace))
+                return false;
+            if (trace != expected[i])
+            {
+                cout << "Round " << round << " of " << files[i]
+                        << " differs from a new reader" << endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// The children of a skipped element are not reported, including a nested
+// element of the same name, and every reported start has its end
+static bool testSkip(const string &filename)
+{
+    XmlReader reader;
+    SkipStopHandler handler(&reader, "skip", "");
+    reader.setContentHandler(&handler);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    if (handler.trace.find("hidden") != string::npos
+            || handler.trace.find("<a>") != string::npos)
+    {
+        cout << "Skipped content was reported: " << handler.trace << endl;
+        return false;
+    }
+    if (handler.trace.find("<skip></skip><p>after</p>") == string::npos)
+    {
+        cout << "Unexpected events: " << handler.trace << endl;
+        return false;
+    }
+    if (handler.depth != 0)
+    {
+        cout << "Unbalanced elements, depth " << handler.depth << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Returning false from startElement ends the parse successfully, before
+// the rest of the document is read
+static bool testStop(const string &filename)
+{
+    XmlReader reader;
+    SkipStopHandler handler(&reader, "", "stop");
+    reader.setContentHandler(&handler);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Stopped parse of " << filename << " failed" << endl;
+        return false;
+    }
+    string expected = handler.trace;
+    if (expected.substr(expected.size() - 6) != "<stop>")
+    {
+        cout << "Events after stop: " << expected << endl;
+        return false;
+    }
+
+    // The same through the push interface, one byte at a time
+    string contents;
+    if (!readFile(filename, contents))
+    {
+        cout << "Can not read " << filename << endl;
+        return false;
+    }
+
+    SkipStopHandler pushHandler(&reader, "", "stop");
+    bool ret = reader.begin(&pushHandler);
+    for (size_t i = 0; ret && i < contents.size(); i++)
+        ret = reader.feed(contents.data() + i, 1);
+    if (!ret || !reader.finish())
+    {
+        cout << "Stopped push parse of " << filename << " failed" << endl;
+        return false;
+    }
+    if (pushHandler.trace != expected)
+    {
+        cout << "Push parse events differ: " << pushHandler.trace << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Multi byte sequences split over feed() calls are put together again, and
+// a bad sequence is rejected however it is split
+static bool testSplit(const string &valid, const string &invalid)
+{
+    XmlReader reader;
+    string expected;
+    if (!parseTrace(reader, valid, expected))
+        return false;
+
+    string contents, bad;
+    if (!readFile(valid, contents) || !readFile(invalid, bad))
+    {
+        cout << "Can not read " << valid << " or " << invalid << endl;
+        return false;
+    }
+
+    for (size_t piece = 1; piece <= 4; piece++)
+    {
+        TraceHandler handler;
+        bool ret = reader.begin(&handler);
+        for (size_t i = 0; ret && i < contents.size(); i += piece)
+            ret = reader.feed(contents.data() + i,
+                    min(piece, contents.size() - i));
+        if (!ret || !reader.finish() || handler.trace != expected)
+        {
+            cout << "Fed in pieces of " << piece << " bytes, " << valid
+                    << " gave " << handler.trace << endl;
+            return false;
+        }
+
+        ret = reader.begin(&handler);
+        for (size_t i = 0; ret && i < bad.size(); i += piece)
+            ret = reader.feed(bad.data() + i, min(piece, bad.size() - i));
+        if ((ret && reader.finish()) || reader.getLastError() == NULL)
+        {
+            cout << "Fed in pieces of " << piece << " bytes, " << invalid
+                    << " was accepted" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// With coalescing, the text between two other events arrives in one NUL
+// terminated characters() call, also when fed one byte at a time, and
+// equals the text delivered without coalescing
+static bool testCoalesce(const string &filename)
+{
+    string contents;
+    if (!readFile(filename, contents))
+    {
+        cout << "Can not read " << filename << endl;
+        return false;
+    }
+
+    XmlReader reader;
+    CoalesceHandler plain;
+    reader.setContentHandler(&plain);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+    if (plain.splits == 0)
+    {
+        cout << "Text of " << filename << " is never split" << endl;
+        return false;
+    }
+
+    reader.coalesceCharacters(true);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        CoalesceHandler handler;
+        bool ret;
+        if (pass == 0)
+        {
+            reader.setContentHandler(&handler);
+            ret = reader.parseXml(filename.c_str());
+        }
+        else
+        {
+            ret = reader.begin(&handler);
+            for (size_t i = 0; ret && i < contents.size(); i++)
+                ret = reader.feed(contents.data() + i, 1);
+            ret = ret && reader.finish();
+        }
+        if (!ret)
+        {
+            cout << "Failed to parse " << filename << " in pass " << pass
+                    << endl;
+            return false;
+        }
+
+        if (handler.splits != 0 || handler.unterminated)
+        {
+            cout << "Pass " << pass << ": " << handler.splits
+                    << " split texts in " << handler.calls << " calls"
+                    << (handler.unterminated ? ", unterminated" : "")
+                    << endl;
+            return false;
+        }
+        if (handler.trace != plain.trace)
+        {
+            cout << "Pass " << pass << " text differs: " << handler.trace
+                    << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The local name of a prefixed attribute is the part after the colon
+static bool testAttributes(const string &filename)
+{
+    XmlReader reader;
+    AttributeHandler handler;
+    reader.setContentHandler(&handler);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    const char *expected[] =
+    { "id=id ", "x:lang=lang ", "xml:space=space " };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        if (handler.names.find(expected[i]) == string::npos)
+        {
+            cout << "Missing " << expected[i] << "in " << handler.names
+                    << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Element handlers only see the elements they were set for, before the
+// content handler, in this and the following parses
+static bool testDispatch(const string &filename)
+{
+    string log;
+    LogContentHandler content(log);
+    LogElementHandler a(log, "A"), b(log, "B"), c(log, "N"), d(log, "R");
+
+    XmlReader reader;
+    reader.setContentHandler(&content);
+    reader.setElementHandler(BAD_CAST "urn:example:b", BAD_CAST "item", &a);
+    reader.setElementHandler(BAD_CAST "", BAD_CAST "plain", &b);
+    reader.setElementHandler(NULL, BAD_CAST "any", &c);
+    reader.setElementHandler(NULL, BAD_CAST "removed", &d);
+    reader.setElementHandler(NULL, BAD_CAST "removed", NULL);
+
+    const string expected = "C<doc>C<item>A<item urn:example:b>C<item>A</item>"
+            "C<plain>B<plain >C<plain>B</plain>"
+            "N<any urn:example:a>C<any>N</any>"
+            "N<any urn:example:b>C<any>N</any>C<removed>";
+
+    for (int round = 0; round < 2; round++)
+    {
+        log.clear();
+        if (!reader.parseXml(filename.c_str()))
+        {
+            cout << "Failed to parse " << filename << endl;
+            return false;
+        }
+        if (log != expected)
+        {
+            cout << "Round " << round << " dispatched " << log << endl;
+            return false;
+        }
+    }
+
+    log.clear();
+    reader.clearElementHandlers();
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+    if (log.find("<item urn") != string::npos
+            || log.find("<any urn") != string::npos)
+    {
+        cout << "Cleared handlers were called: " << log << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Peak resident size of the process in kilobytes
+static long maxResident()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Namespaces are released when their element ends. A long document whose
+// elements declare namespaces of their own needs memory for the open
+// elements only, and the reader still resolves prefixes right afterwards.
+static bool testNamespaces(const string &filename)
+{
+    NamespaceHandler fresh;
+    XmlReader freshReader;
+    freshReader.setContentHandler(&fresh);
+    if (!freshReader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    // Without reuse the declarations take about 80 MB
+    const int count = 20000;
+    NamespaceHandler handler;
+    XmlReader reader;
+    long before = maxResident();
+    bool ok = reader.begin(&handler) && reader.feed("<doc>", 5);
+    for (int i = 0; ok && i < count; i++)
+    {
+        char k[8];
+        snprintf(k, sizeof(k), "%d", i % 3);
+        string element = string("<item xmlns:p=\"")
+                + NamespaceHandler::namespaceUri(i % 3) + "\"><p:c k=\"" + k
+                + "\"/></item>";
+        ok = reader.feed(element.data(), element.size());
+    }
+    ok = ok && reader.feed("</doc>", 6) && reader.finish();
+    long growth = maxResident() - before;
+
+    if (!ok || handler.elements != count || handler.mismatches != 0)
+    {
+        cout << "Parsed " << handler.elements << " elements, "
+                << handler.mismatches << " in the wrong namespace" << endl;
+        return false;
+    }
+    if (growth > 16 * 1024)
+    {
+        cout << "Parse grew the process by " << growth << " kB" << endl;
+        return false;
+    }
+
+    reader.setContentHandler(&handler);
+    handler.trace.clear();
+    if (!reader.parseXml(filename.c_str()) || handler.trace != fresh.trace)
+    {
+        cout << "Namespaces of " << filename << " differ after reuse" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// A lexical handler works along with element handlers when no content
+// handler is set
+static bool testLexical(const string &filename)
+{
+    string log;
+    LogLexicalHandler lexical(log);
+    LogElementHandler element(log, "E");
+
+    XmlReader reader;
+    reader.setLexicalHandler(&lexical);
+    reader.setElementHandler(NULL, BAD_CAST "p", &element);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    const string expected = "L<!-- before -->E<p >L<![CDATA[L]]>E</p>"
+            "L<!-- after -->";
+    if (log != expected)
+    {
+        cout << "Lexical events were " << log << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// The entities of a DOCTYPE are only expanded once its public identifier
+// is registered with a local DTD
+static bool testDtd(const string &dtd, const string &filename)
+{
+    const string publicId = "-//Kolibre//DTD xmlreader test//EN";
+    const string expanded = "<p>Sample book</p>\n"
+            "<p>Sample book, \xc2\xa9 Kolibre</p>";
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+
+    bool ok = true;
+    for (int registered = 0; registered < 2 && ok; registered++)
+    {
+        if (registered)
+            handler->addCatalogEntry(publicId, dtd);
+
+        XmlReader reader;
+        string trace;
+        if (!parseTrace(reader, filename, trace))
+            ok = false;
+        else if ((trace.find(expanded) != string::npos) != (registered == 1))
+        {
+            cout << (registered ? "Registered" : "Unregistered")
+                    << " DTD gave " << trace << endl;
+            ok = false;
+        }
+    }
+
+    handler->DestroyInstance();
+    return ok;
+}
+
+// Named HTML entities in a document without a DTD expand to their
+// characters, an unknown entity to the placeholder along with a warning on
+// its line
+static bool testEntities(const string &filename)
+{
+    WarningTraceHandler handler;
+    XmlReader reader;
+    reader.setContentHandler(&handler);
+    reader.setErrorHandler(&handler);
+    if (!reader.parseXml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    bool ok = true;
+    const string known = "<p>caf\xc3\xa9\xc2\xa0" "au\xc2\xa0lait</p>";
+    const string unknown = "<p>a_b</p>";
+    if (handler.trace.find(known) == string::npos)
+    {
+        cout << "&eacute; and &nbsp; were not expanded" << endl;
+        ok = false;
+    }
+    if (handler.trace.find(unknown) == string::npos)
+    {
+        cout << "Unknown entity was not replaced by _" << endl;
+        ok = false;
+    }
+    if (handler.warningLines.size() != 1 || handler.warningLines[0] != 6)
+    {
+        cout << "No warning about the unknown entity" << endl;
+        ok = false;
+    }
+    if (!ok)
+        cout << "Parsed " << handler.trace << endl;
+    return ok;
+}
+
+// Count the cache lookups of a parseHtml, each open of the document makes
+// one
+static bool countLookups(const string &filename, unsigned long &lookups)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    CacheStatistics before = handler->getCacheStatistics();
+
+    XmlReader reader;
+    TraceHandler trace;
+    reader.setContentHandler(&trace);
+    if (!reader.parseHtml(filename.c_str()))
+    {
+        cout << "Failed to parse " << filename << endl;
+        return false;
+    }
+
+    CacheStatistics after = handler->getCacheStatistics();
+    lookups = (after.hits + after.misses) - (before.hits + before.misses);
+    return true;
+}
+
+// The second parse of an unchanged HTML document skips the preparse and
+// opens the document once, a changed document is preparsed again
+static bool testVerdict(const string &filename)
+{
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    const string path = "readertest-verdict.html";
+
+    string contents;
+    if (!readFile(filename, contents))
+    {
+        cout << "Failed to read " << filename << endl;
+        return false;
+    }
+    ofstream copy(path.c_str(), ios::out | ios::binary | ios::trunc);
+    copy.write(contents.data(), contents.size());
+    copy.close();
+    if (!copy)
+    {
+        cout << "Failed to write " << path << endl;
+        return false;
+    }
+
+    bool ok = true;
+    unsigned long first = 0, second = 0, changed = 0;
+    if (!countLookups(path, first))
+        ok = false;
+    else if (handler->getHtmlVerdict(path) != HTML_WELL_FORMED)
+    {
+        cout << "No verdict after the first parse" << endl;
+        ok = false;
+    }
+    else if (!countLookups(path, second))
+        ok = false;
+    else if (second >= first)
+    {
+        cout << "Second parse opened the document " << second
+                << " times, the first " << first << endl;
+        ok = false;
+    }
+
+    ofstream edit(path.c_str(), ios::out | ios::binary | ios::app);
+    edit << "<!-- edited -->\n";
+    edit.close();
+    if (ok && handler->getHtmlVerdict(path) != HTML_UNKNOWN)
+    {
+        cout << "Verdict of a changed document was kept" << endl;
+        ok = false;
+    }
+    else if (ok && (!countLookups(path, changed) || changed != first))
+    {
+        cout << "Changed document was not preparsed again" << endl;
+        ok = false;
+    }
+
+    handler->DestroyInstance();
+    remove(path.c_str());
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    setup_logging();
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <test> <file> [file...]" << endl;
+        return 1;
+    }
+
+    string test = argv[1];
+    vector<string> files(argv + 2, argv + argc);
+
+    bool ok = false;
+    if (test == "reuse")
+        ok = testReuse(files);
+    else if (test == "attributes")
+        ok = testAttributes(files[0]);
+    else if (test == "coalesce")
+        ok = testCoalesce(files[0]);
+    else if (test == "dispatch")
+        ok = testDispatch(files[0]);
+    else if (test == "dtd" && files.size() == 2)
+        ok = testDtd(files[0], files[1]);
+    else if (test == "lexical")
+        ok = testLexical(files[0]);
+    else if (test == "namespaces")
+        ok = testNamespaces(files[0]);
+    else if (test == "entities")
+        ok = testEntities(files[0]);
+    else if (test == "skip")
+        ok = testSkip(files[0]);
+    else if (test == "split" && files.size() == 2)
+        ok = testSplit(files[0], files[1]);
+    else if (test == "stop")
+        ok = testStop(files[0]);
+    else if (test == "verdict")
+        ok = testVerdict(files[0]);
+    else
+        cout << "Unknown test " << test << endl;
+
+    cout << "Test " << test << (ok ? " passed" : " FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./readertest reuse ${srcdir:-.}/testdata/sample.xml ${srcdir:-.}/testdata/ncc.html ${srcdir:-.}/testdata/utf16-bom.xml ${srcdir:-.}/testdata/utf8-bom.html
+$PREFIX ./readertest attributes ${srcdir:-.}/testdata/attributes.xml
+$PREFIX ./readertest coalesce ${srcdir:-.}/testdata/coalesce.xml
+$PREFIX ./readertest dispatch ${srcdir:-.}/testdata/dispatch.xml
+$PREFIX ./readertest dtd ${srcdir:-.}/testdata/entities.dtd ${srcdir:-.}/testdata/dtdentities.xml
+$PREFIX ./readertest lexical ${srcdir:-.}/testdata/lexical.xml
+$PREFIX ./readertest namespaces ${srcdir:-.}/testdata/dispatch.xml
+$PREFIX ./readertest entities ${srcdir:-.}/testdata/entities.xml
+$PREFIX ./readertest skip ${srcdir:-.}/testdata/skip.xml
+$PREFIX ./readertest split ${srcdir:-.}/testdata/fragment.xml ${srcdir:-.}/testdata/utf8-invalid.xml
+$PREFIX ./readertest stop ${srcdir:-.}/testdata/stop.xml
+$PREFIX ./readertest verdict ${srcdir:-.}/testdata/utf8-no-bom.html
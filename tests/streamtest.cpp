@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "DataStreamHandler.h"
+#include "InputStream.h"
+#include "XmlError.h"
+#include "setup_logging.h"
+
+using namespace std;
+
+// Read the whole file into contents
+static bool readFile(const char *path, string &contents)
+{
+    ifstream file(path, ios::in | ios::binary);
+    if (!file)
+        return false;
+    contents.assign((istreambuf_iterator<char>(file)),
+            istreambuf_iterator<char>());
+    return true;
+}
+
+// Open url with the DataStreamHandler, skip the first bytes and read the
+// rest in chunks of the given size
+static bool readStream(const string &url, size_t skip, size_t chunk,
+        string &result)
+{
+    InputStream *stream = NULL;
+    try
+    {
+        stream = DataStreamHandler::Instance()->newStream(url, false, false);
+        if (stream == NULL)
+            return false;
+        if (skip > 0 && !stream->skipBytes(skip))
+        {
+            delete stream;
+            return false;
+        }
+
+        vector<char> buffer(chunk);
+        int bytes;
+        result.clear();
+        while ((bytes = stream->readBytes(&buffer[0], chunk)) > 0)
+            result.append(&buffer[0], bytes);
+        delete stream;
+        return bytes == 0;
+    } catch (XmlError &e)
+    {
+        cout << "Reading " << url << " failed: " << e.getMessage() << endl;
+        delete stream;
+        return false;
+    }
+}
+
+/*
+ * A stream read ahead in a worker thread returns the same bytes as the
+ * file, whatever the size of the reads and after a skip
+ */
+static bool testReadAhead(const char *file, const string &contents)
+{
+    const size_t chunks[] =
+    { 1, 100, 4096, 16384, 16385, 100000 };
+    const size_t skips[] =
+    { 0, 1, 20000 };
+
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    bool ok = true;
+    for (int readAhead = 0; readAhead < 2; readAhead++)
+    {
+        handler->setReadAhead(readAhead);
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+        {
+            for (size_t s = 0; s < sizeof(skips) / sizeof(skips[0]); s++)
+            {
+                if (skips[s] > contents.size())
+                    continue;
+
+                string result;
+                if (!readStream(file, skips[s], chunks[c], result))
+                {
+                    cout << "Failed to read " << file << endl;
+                    ok = false;
+                }
+                else if (result != contents.substr(skips[s]))
+                {
+                    cout << "Read ahead " << readAhead << ", chunk "
+                            << chunks[c] << ", skip " << skips[s] << ": read "
+                            << result.size() << " bytes that differ from the "
+                            << contents.size() - skips[s] << " in the file"
+                            << endl;
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    handler->DestroyInstance();
+    return ok;
+}
+
+// Write contents to a new file at path, replacing the file if there is one
+static bool writeFile(const string &path, const string &contents)
+{
+    string temporary = path + ".new";
+    ofstream file(temporary.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(contents.data(), contents.size());
+    file.close();
+    return file && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/*
+ * A prefetched file is served from memory while it is unchanged, and read
+ * again when it changed after it was prefetched, in size or in place
+ */
+static bool testPrefetch(const string &contents)
+{
+    const string unchanged = "streamtest-unchanged.tmp";
+    const string resized = "streamtest-resized.tmp";
+    const string replaced = "streamtest-replaced.tmp";
+    const string grown = contents + "<!-- edited -->\n";
+
+    // Same size, one bit differs
+    string same = contents;
+    same[same.size() / 2] ^= 1;
+
+    if (!writeFile(unchanged, contents) || !writeFile(resized, contents)
+            || !writeFile(replaced, contents))
+    {
+        cout << "Failed to write the test files" << endl;
+        return false;
+    }
+
+    vector<string> paths;
+    paths.push_back(unchanged);
+    paths.push_back(resized);
+    paths.push_back(replaced);
+    DataStreamHandler *handler = DataStreamHandler::Instance();
+    handler->prefetchFiles(paths);
+
+    // Let the workers load the files before they change
+    usleep(200000);
+    bool ok = writeFile(resized, grown) && writeFile(replaced, same);
+
+    string result;
+    if (!readStream(unchanged, 0, 4096, result) || result != contents)
+    {
+        cout << "Unchanged prefetched file read wrong" << endl;
+        ok = false;
+    }
+    if (!readStream(resized, 0, 4096, result) || result != grown)
+    {
+        cout << "Stale contents of a file that grew" << endl;
+        ok = false;
+    }
+    if (!readStream(replaced, 0, 4096, result) || result != same)
+    {
+        cout << "Stale contents of a file that was replaced" << endl;
+        ok = false;
+    }
+
+    handler->DestroyInstance();
+    remove(unchanged.c_str());
+    remove(resized.c_str());
+    remove(replaced.c_str());
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    setup_logging();
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " <test> <file>" << endl;
+        return 1;
+    }
+
+    string test = argv[1];
+    string contents;
+    if (!readFile(argv[2], contents))
+    {
+        cout << "Can not read " << argv[2] << endl;
+        return 1;
+    }
+
+    bool ok = false;
+    if (test == "readahead")
+        ok = testReadAhead(argv[2], contents);
+    else if (test == "prefetch")
+        ok = testPrefetch(contents);
+    else
+        cout << "Unknown test " << test << endl;
+
+    cout << "Test " << test << (ok ? " passed" : " FAILED") << endl;
+    return ok ? 0 : 1;
+}
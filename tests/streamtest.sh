@@ -0,0 +1,10 @@
+#!/bin/sh
+
+set -e
+
+if [ -x /usr/bin/gdb ]; then
+    PREFIX="libtool --mode=execute gdb --return-child-result -batch -x ${srcdir:-.}/run --args"
+fi
+
+$PREFIX ./streamtest readahead ${srcdir:-.}/testdata/sample3.xml
+$PREFIX ./streamtest prefetch ${srcdir:-.}/testdata/sample3.xml
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2012 Kolibre
+ *
+ * This file is part of kolibre-xmlreader.
+ *
+ * Kolibre-xmlreader is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * Kolibre-xmlreader is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with kolibre-xmlreader. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTSERVER_H
+#define TESTSERVER_H
+
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//
+// A HTTP server on the loopback interface for the tests. Every request is
+// answered on a connection of its own with the bytes the responder returns,
+// which may stop short of the Content-Length to break the transfer.
+//
+
+class TestServer
+{
+public:
+    // Return the raw response to the index:th request
+    typedef std::string (*Responder)(const std::string &request, int index,
+            void *data);
+
+    TestServer(Responder responder, void *data) :
+            mResponder(responder), mData(data), mSocket(-1), mPort(0),
+            mBytesSent(0), bRunning(false)
+    {
+        pthread_mutex_init(&mMutex, NULL);
+
+        struct sockaddr_in address;
+        socklen_t length = sizeof(address);
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        mSocket = socket(AF_INET, SOCK_STREAM, 0);
+        if (mSocket < 0
+                || bind(mSocket, (struct sockaddr *) &address, length) != 0
+                || listen(mSocket, 8) != 0
+                || getsockname(mSocket, (struct sockaddr *) &address,
+                        &length) != 0)
+            return;
+        mPort = ntohs(address.sin_port);
+
+        bRunning = pthread_create(&mThread, NULL, staticServe, this) == 0;
+    }
+
+    ~TestServer()
+    {
+        if (bRunning)
+        {
+            // Wakes the accept() of the server thread
+            shutdown(mSocket, SHUT_RDWR);
+            pthread_join(mThread, NULL);
+        }
+        if (mSocket >= 0)
+            close(mSocket);
+        pthread_mutex_destroy(&mMutex);
+    }
+
+    bool running() const
+    {
+        return bRunning;
+    }
+
+    std::string url(const std::string &path) const
+    {
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "http://127.0.0.1:%d", mPort);
+        return prefix + path;
+    }
+
+    // The header blocks of the requests received so far
+    std::vector<std::string> requests()
+    {
+        pthread_mutex_lock(&mMutex);
+        std::vector<std::string> result = mRequests;
+        pthread_mutex_unlock(&mMutex);
+        return result;
+    }
+
+    // Bytes of all responses, headers included
+    unsigned long bytesSent()
+    {
+        pthread_mutex_lock(&mMutex);
+        unsigned long result = mBytesSent;
+        pthread_mutex_unlock(&mMutex);
+        return result;
+    }
+
+private:
+    TestServer(const TestServer&);
+    TestServer& operator=(const TestServer&);
+
+    static void *staticServe(void *server)
+    {
+        static_cast<TestServer *>(server)->serve();
+        return NULL;
+    }
+
+    void serve()
+    {
+        int connection;
+        while ((connection = accept(mSocket, NULL, NULL)) >= 0)
+        {
+            std::string request;
+            char buffer[1024];
+            ssize_t got;
+            while (request.find("\r\n\r\n") == std::string::npos
+                    && (got = read(connection, buffer, sizeof(buffer))) > 0)
+                request.append(buffer, got);
+
+            pthread_mutex_lock(&mMutex);
+            int index = mRequests.size();
+            mRequests.push_back(request);
+            pthread_mutex_unlock(&mMutex);
+
+            std::string response = mResponder(request, index, mData);
+            size_t sent = 0;
+            ssize_t put;
+            while (sent < response.size()
+                    && (put = write(connection, response.data() + sent,
+                            response.size() - sent)) > 0)
+                sent += put;
+
+            pthread_mutex_lock(&mMutex);
+            mBytesSent += sent;
+            pthread_mutex_unlock(&mMutex);
+
+            shutdown(connection, SHUT_WR);
+            while (read(connection, buffer, sizeof(buffer)) > 0)
+                ;
+            close(connection);
+        }
+    }
+
+    Responder mResponder;
+    void *mData;
+    int mSocket;
+    int mPort;
+    pthread_t mThread;
+    pthread_mutex_t mMutex;
+    std::vector<std::string> mRequests;
+    unsigned long mBytesSent;
+    bool bRunning;
+};
+
+// Build a response, body may be shorter than length to break the transfer
+static std::string httpResponse(int code, const std::string &headers,
+        const std::string &body, size_t length)
+{
+    char status[128];
+    snprintf(status, sizeof(status),
+            "HTTP/1.1 %d X\r\nConnection: close\r\nContent-Length: %lu\r\n",
+            code, (unsigned long) length);
+    return status + headers + "\r\n" + body;
+}
+
+// Get the value of a request header, empty if it is missing
+static std::string requestHeader(const std::string &request,
+        const std::string &name)
+{
+    std::string key = "\r\n" + name + ": ";
+    size_t begin = request.find(key);
+    if (begin == std::string::npos)
+        return "";
+    begin += key.size();
+    return request.substr(begin, request.find("\r\n", begin) - begin);
+}
+
+#endif